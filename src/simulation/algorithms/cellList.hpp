@@ -0,0 +1,439 @@
+/** Cell list of the bodies on the accelerator
+ *
+ * This file implements a regular grid of cells which are
+ * atleast as large as an interaction cutoff, so all partners
+ * of a body lie in its own or the neighbouring cells. The
+ * bodies are sorted by their cell, every cell covers a
+ * contiguous range of bodies.
+ *
+ * @file cellList.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <cmath> // std::floor
+#include <alpaka/alpaka.hpp>
+// ReduceKernel, reduce::MinElementwise, reduce::MaxElementwise
+#include <simulation/kernels/reduceKernel.hpp>
+// CellKeyKernel, CellClearKernel, CellRangeKernel, cells::Geometry
+#include <simulation/kernels/cellListKernels.hpp>
+// GatherKernel
+#include <simulation/kernels/gatherKernel.hpp>
+// RadixSort
+#include <simulation/algorithms/radixSort.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Cell list of the bodies
+ *
+ * Owns the sorted copy of the bodies and the range of
+ * bodies of every cell. Isolated cells cover the bounding
+ * box of the bodies, periodic cells a fixed box.
+ *
+ * @tparam TAccForce 2-dimensional accelerator, used for
+ *         the bounding box
+ * @tparam TAccBodies 1-dimensional accelerator
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass and position
+ * @tparam TSize size type
+ * @tparam TPeriodic periodic cells
+ */
+template<
+    typename TAccForce,
+    typename TAccBodies,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize,
+    bool TPeriodic>
+class CellList
+{
+public:
+    using Geometry = kernels::cells::Geometry<NDim,TElem,TSize>;
+private:
+    static constexpr std::size_t reduceBlockSize = 256;
+    // the empty cells stay in the order of the number of bodies
+    static constexpr std::size_t cellsPerBody = 4;
+
+    alpaka::dev::Dev<TAccBodies> devAcc;
+    alpaka::dev::DevCpu devHost;
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentBodies;
+
+    // number of cells the cell buffers can hold
+    TSize capacity;
+
+    Geometry geometry;
+
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMin;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMax;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devHost, 1) ) hostBoxMin;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devHost, 1) ) hostBoxMax;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accKeys;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accPermutation;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, extentBodies) ) accSortedPosition;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, extentBodies) ) accSortedMass;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, capacity) ) accCellBegin;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, capacity) ) accCellEnd;
+
+    RadixSort<
+        TAccBodies,
+        TSize,
+        TSize,
+        TSize> radixSort;
+
+    auto getNumCells() const
+    -> TSize
+    {
+        TSize numCells( 1 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            numCells *= geometry.numCells[ d ];
+        return numCells;
+    }
+
+    // cells of the given size which cover the extent
+    auto setCells(
+            types::Vector<NDim,TElem> const & extent,
+            TElem const cellSize)
+    -> void
+    {
+        geometry.cellSize = cellSize;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            TSize numCells( static_cast<TSize>(
+                        std::floor( extent[ d ] / cellSize ) ) );
+            if( TPeriodic )
+                numCells = ( numCells > 0 ) ? numCells : 1;
+            else
+                numCells++;
+            geometry.numCells[ d ] = numCells;
+        }
+    }
+public:
+    CellList(
+            alpaka::dev::Dev<TAccBodies> const & devAcc,
+            TSize numBodies) :
+        devAcc(devAcc),
+        devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+        extentBodies(numBodies),
+        capacity(1),
+        accBoxMin( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        accBoxMax( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        hostBoxMin( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devHost, 1 ) ),
+        hostBoxMax( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devHost, 1 ) ),
+        accKeys( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accPermutation( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accSortedPosition( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+        accSortedMass( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, extentBodies ) ),
+        accCellBegin( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, capacity ) ),
+        accCellEnd( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, capacity ) ),
+        radixSort( devAcc, numBodies )
+    {}
+
+    /** Work division for numElements independent elements */
+    auto getWorkDiv(
+            TSize const numElements,
+            std::size_t const elements) const
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                devAcc,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(numElements),
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(static_cast<TSize>(elements)),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                Unrestricted
+        );
+    }
+
+    /** Sorts the bodies into the cells
+     *
+     * Isolated cells cost one transfer of the bounding
+     * box to the host.
+     *
+     * @param stream stream of the accelerator
+     * @param bodiesPosition array of the bodies' position
+     * @param bodiesMass array of the bodies' mass
+     * @param numBodies number of bodies
+     * @param cutoff minimum size of the cells
+     * @param boxOrigin origin of the periodic box
+     * @param boxSize edge length of the periodic box
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream>
+    auto operator()(
+            TStream & stream,
+            types::Vector<NDim,TElem> const * const bodiesPosition,
+            TElem const * const bodiesMass,
+            TSize const numBodies,
+            TElem const cutoff,
+            types::Vector<NDim,TElem> const & boxOrigin,
+            TElem const boxSize,
+            std::size_t const elements)
+    -> void
+    {
+        auto const workDivBodies( getWorkDiv( numBodies, elements ) );
+
+        /*** Placement of the cells ***/
+        types::Vector<NDim,TElem> extent( boxSize );
+        if( TPeriodic )
+        {
+            geometry.origin = boxOrigin;
+        }
+        else
+        {
+            kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+            auto const workDivReduce(
+                    kernels::ReduceKernel<reduceBlockSize>::
+                        template getWorkDiv<TAccForce>(
+                            devAcc,
+                            static_cast<TSize>(1),
+                            numBodies ) );
+
+            auto const boxMinExec(
+                    alpaka::exec::create<TAccForce>(
+                        workDivReduce,
+                        reduceKernel,
+                        bodiesPosition,
+                        static_cast<TSize>(0),
+                        static_cast<TSize>(1),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accBoxMin ),
+                        static_cast<TSize>(0),
+                        kernels::reduce::MinElementwise()
+                    )
+            );
+            alpaka::stream::enqueue( stream, boxMinExec );
+
+            auto const boxMaxExec(
+                    alpaka::exec::create<TAccForce>(
+                        workDivReduce,
+                        reduceKernel,
+                        bodiesPosition,
+                        static_cast<TSize>(0),
+                        static_cast<TSize>(1),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accBoxMax ),
+                        static_cast<TSize>(0),
+                        kernels::reduce::MaxElementwise()
+                    )
+            );
+            alpaka::stream::enqueue( stream, boxMaxExec );
+
+            alpaka::Vec<
+                alpaka::dim::DimInt<1u>,
+                TSize
+            > const extentOne( static_cast<TSize>(1) );
+            alpaka::mem::view::copy( stream, hostBoxMin, accBoxMin, extentOne );
+            alpaka::mem::view::copy( stream, hostBoxMax, accBoxMax, extentOne );
+            alpaka::wait::wait( stream );
+
+            geometry.origin = *alpaka::mem::view::getPtrNative( hostBoxMin );
+            extent = *alpaka::mem::view::getPtrNative( hostBoxMax ) -
+                geometry.origin;
+        }
+
+        setCells( extent, cutoff );
+        // a small cutoff would create mostly empty cells
+        TSize const maxCells( cellsPerBody * numBodies + 1 );
+        while( getNumCells() > maxCells )
+            setCells( extent, 2 * geometry.cellSize );
+        // periodic cells have to fill the box exactly
+        if( TPeriodic )
+            geometry.cellSize = boxSize /
+                static_cast<TElem>( geometry.numCells[ 0 ] );
+
+        TSize const numCells( getNumCells() );
+        if( capacity < numCells )
+        {
+            capacity = numCells;
+            accCellBegin = alpaka::mem::buf::alloc<TSize, TSize>(
+                    devAcc, capacity );
+            accCellEnd = alpaka::mem::buf::alloc<TSize, TSize>(
+                    devAcc, capacity );
+        }
+
+        /*** Sort the bodies by their cell ***/
+        kernels::CellKeyKernel<TPeriodic> cellKeyKernel;
+        auto const cellKeyExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    cellKeyKernel,
+                    geometry,
+                    bodiesPosition,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accKeys ),
+                    alpaka::mem::view::getPtrNative( accPermutation )
+                )
+        );
+        alpaka::stream::enqueue( stream, cellKeyExec );
+
+        std::size_t numBits( 1 );
+        while( numBits < sizeof( TSize ) * 8 &&
+               ( static_cast<TSize>( 1 ) << numBits ) < numCells )
+            numBits++;
+
+        radixSort(
+                stream,
+                alpaka::mem::view::getPtrNative( accKeys ),
+                alpaka::mem::view::getPtrNative( accPermutation ),
+                numBodies,
+                numBits );
+
+        TSize const * const permutation(
+                alpaka::mem::view::getPtrNative( accPermutation ) );
+
+        kernels::GatherKernel gatherKernel;
+        auto const gatherPositionExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    gatherKernel,
+                    bodiesPosition,
+                    permutation,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accSortedPosition )
+                )
+        );
+        alpaka::stream::enqueue( stream, gatherPositionExec );
+
+        auto const gatherMassExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    gatherKernel,
+                    bodiesMass,
+                    permutation,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accSortedMass )
+                )
+        );
+        alpaka::stream::enqueue( stream, gatherMassExec );
+
+        /*** Ranges of the cells ***/
+        kernels::CellClearKernel cellClearKernel;
+        auto const cellClearExec(
+                alpaka::exec::create<TAccBodies>(
+                    getWorkDiv( numCells, elements ),
+                    cellClearKernel,
+                    numCells,
+                    alpaka::mem::view::getPtrNative( accCellBegin ),
+                    alpaka::mem::view::getPtrNative( accCellEnd )
+                )
+        );
+        alpaka::stream::enqueue( stream, cellClearExec );
+
+        kernels::CellRangeKernel cellRangeKernel;
+        auto const cellRangeExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    cellRangeKernel,
+                    static_cast<TSize const *>(
+                        alpaka::mem::view::getPtrNative( accKeys ) ),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accCellBegin ),
+                    alpaka::mem::view::getPtrNative( accCellEnd )
+                )
+        );
+        alpaka::stream::enqueue( stream, cellRangeExec );
+    }
+
+    // Placement of the cells of the last call
+    auto getGeometry() const
+    -> Geometry const &
+    {
+        return geometry;
+    }
+
+    // Cell index of every sorted body
+    auto getKeys()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accKeys );
+    }
+
+    // First sorted body of every cell
+    auto getCellBegin()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accCellBegin );
+    }
+
+    // Behind the last sorted body of every cell
+    auto getCellEnd()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accCellEnd );
+    }
+
+    auto getSortedPositions()
+    -> types::Vector<NDim,TElem> *
+    {
+        return alpaka::mem::view::getPtrNative( accSortedPosition );
+    }
+
+    auto getSortedMasses()
+    -> TElem *
+    {
+        return alpaka::mem::view::getPtrNative( accSortedMass );
+    }
+
+    // Original index of every sorted body
+    auto getPermutation()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accPermutation );
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,208 @@
+/** Radix sort on the accelerator
+ *
+ * This file implements a stable radix sort of
+ * key-value pairs which runs completely on
+ * the accelerator.
+ *
+ * @file radixSort.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// RadixHistogramKernel, RadixScatterKernel
+#include <simulation/kernels/radixSortKernels.hpp>
+// ScanKernel
+#include <simulation/kernels/scanKernel.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Radix sort
+ *
+ * Owns the temporary buffers for up to maxElements pairs.
+ *
+ * @tparam TAcc 1-dimensional accelerator
+ * @tparam TKey unsigned integer type of the keys
+ * @tparam TValue type of the values
+ * @tparam TSize size type
+ */
+template<
+    typename TAcc,
+    typename TKey,
+    typename TValue,
+    typename TSize>
+class RadixSort
+{
+private:
+    static constexpr std::size_t scanBlockSize = 256;
+
+    alpaka::dev::Dev<TAcc> devAcc;
+    TSize const maxElements;
+    TSize const maxChunks;
+
+    decltype( alpaka::mem::buf::alloc<TKey, TSize>(
+                devAcc, maxElements) ) accKeysTemp;
+    decltype( alpaka::mem::buf::alloc<TValue, TSize>(
+                devAcc, maxElements) ) accValuesTemp;
+    decltype( alpaka::mem::buf::alloc<TSize, TSize>(
+                devAcc, maxElements) ) accCounts;
+
+    // Enough chunks to keep the accelerator busy, but the
+    // scan over numDigits * numChunks counts stays cheap
+    static auto getNumChunks(TSize numElements)
+    -> TSize
+    {
+        TSize const chunkLengthMin( 64 );
+        TSize const numChunksMax( 1024 );
+        TSize numChunks(
+                ( numElements + chunkLengthMin - 1 ) / chunkLengthMin );
+        if( numChunks > numChunksMax )
+            numChunks = numChunksMax;
+        return ( numChunks > 0 ) ? numChunks : 1;
+    }
+public:
+    RadixSort(
+            alpaka::dev::Dev<TAcc> const & devAcc,
+            TSize maxElements) :
+        devAcc(devAcc),
+        maxElements(maxElements),
+        maxChunks(getNumChunks(maxElements)),
+        accKeysTemp( alpaka::mem::buf::alloc<TKey, TSize>(
+                    devAcc, maxElements) ),
+        accValuesTemp( alpaka::mem::buf::alloc<TValue, TSize>(
+                    devAcc, maxElements) ),
+        accCounts( alpaka::mem::buf::alloc<TSize, TSize>(
+                    devAcc,
+                    static_cast<TSize>(
+                        kernels::radix::numDigits * maxChunks ) ) )
+    {}
+
+    /** Sorts the pairs by their keys
+     *
+     * Only the lowest numBits bits of the keys are sorted.
+     * The number of passes is rounded up to an even number,
+     * so the result ends up in keys and values again.
+     *
+     * @param stream stream of the accelerator
+     * @param keys keys on the accelerator
+     * @param values values on the accelerator
+     * @param numElements number of pairs, at most maxElements
+     * @param numBits number of significant bits of the keys
+     */
+    template<
+        typename TStream>
+    auto operator()(
+            TStream & stream,
+            TKey * const keys,
+            TValue * const values,
+            TSize const numElements,
+            std::size_t const numBits = sizeof(TKey) * 8)
+    -> void
+    {
+        TSize const numChunks( getNumChunks( numElements ) );
+        TSize const chunkLength(
+                ( numElements + numChunks - 1 ) / numChunks );
+        TSize const numCounts( static_cast<TSize>(
+                    kernels::radix::numDigits * numChunks ) );
+
+        std::size_t numPasses(
+                ( numBits + kernels::radix::bits - 1 ) /
+                kernels::radix::bits );
+        numPasses += numPasses % 2;
+
+        auto const workDivChunks(
+                alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    alpaka::Vec<alpaka::dim::DimInt<1u>, TSize>(
+                        numChunks ),
+                    alpaka::Vec<alpaka::dim::DimInt<1u>, TSize>::ones(),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted
+                )
+        );
+
+        kernels::RadixHistogramKernel histogramKernel;
+        kernels::ScanKernel<scanBlockSize> scanKernel;
+        kernels::RadixScatterKernel scatterKernel;
+
+        TKey * keysIn( keys );
+        TValue * valuesIn( values );
+        TKey * keysOut( alpaka::mem::view::getPtrNative( accKeysTemp ) );
+        TValue * valuesOut(
+                alpaka::mem::view::getPtrNative( accValuesTemp ) );
+        TSize * const counts( alpaka::mem::view::getPtrNative( accCounts ) );
+
+        for( std::size_t pass( 0 ); pass < numPasses; pass++ )
+        {
+            std::size_t const shift( pass * kernels::radix::bits );
+
+            auto const histogramExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivChunks,
+                        histogramKernel,
+                        static_cast<TKey const *>( keysIn ),
+                        numElements,
+                        chunkLength,
+                        numChunks,
+                        shift,
+                        counts
+                    )
+            );
+            alpaka::stream::enqueue( stream, histogramExec );
+
+            auto const scanExec(
+                    alpaka::exec::create<TAcc>(
+                        kernels::ScanKernel<scanBlockSize>::
+                            template getWorkDiv<TAcc>(
+                                devAcc,
+                                numCounts ),
+                        scanKernel,
+                        static_cast<TSize const *>( counts ),
+                        counts,
+                        numCounts,
+                        static_cast<TSize *>( nullptr )
+                    )
+            );
+            alpaka::stream::enqueue( stream, scanExec );
+
+            auto const scatterExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivChunks,
+                        scatterKernel,
+                        static_cast<TKey const *>( keysIn ),
+                        static_cast<TValue const *>( valuesIn ),
+                        numElements,
+                        chunkLength,
+                        numChunks,
+                        shift,
+                        counts,
+                        keysOut,
+                        valuesOut
+                    )
+            );
+            alpaka::stream::enqueue( stream, scatterExec );
+
+            TKey * const keysHelp( keysIn );
+            keysIn = keysOut;
+            keysOut = keysHelp;
+            TValue * const valuesHelp( valuesIn );
+            valuesIn = valuesOut;
+            valuesOut = valuesHelp;
+        }
+
+        alpaka::wait::wait( stream );
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,384 @@
+/** Reordering of the bodies along a space-filling curve
+ *
+ * This file implements the sort of the bodies of a
+ * simulation by their keys on a Hilbert or Morton curve.
+ * Bodies which are close in space end up close in memory,
+ * so neighbouring threads of the kernels read neighbouring
+ * bodies. Everything runs on the accelerator.
+ *
+ * @file reorder.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <utility> // std::swap
+#include <alpaka/alpaka.hpp>
+// ReduceKernel, reduce::MinElementwise, reduce::MaxElementwise
+#include <simulation/kernels/reduceKernel.hpp>
+// MortonKeyKernel, morton::Key, morton::Bits
+#include <simulation/kernels/mortonKeyKernel.hpp>
+// HilbertKeyKernel
+#include <simulation/kernels/hilbertKeyKernel.hpp>
+// TracerKeyKernel, ReorderKernel
+#include <simulation/kernels/reorderKernels.hpp>
+// RadixSort
+#include <simulation/algorithms/radixSort.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Reordering of the bodies
+ *
+ * Sorts the positions, masses and velocities of the bodies
+ * by their keys and keeps the original index of every body,
+ * so the results can be returned in the original order. The
+ * sorted bodies are gathered into a second set of buffers,
+ * which is then swapped with the buffers of the simulation.
+ * Tracers stay behind the massive bodies.
+ *
+ * @tparam TAccForce 2-dimensional accelerator, used for
+ *         the bounding box
+ * @tparam TAccBodies 1-dimensional accelerator
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass, position and velocity
+ * @tparam TSize size type
+ * @tparam TLayout layout of the positions and masses
+ */
+template<
+    typename TAccForce,
+    typename TAccBodies,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize,
+    typename TLayout>
+class Reorder
+{
+private:
+    static constexpr std::size_t reduceBlockSize = 256;
+
+    using Bodies = types::Bodies<TLayout,NDim,TElem,TSize>;
+
+    alpaka::dev::Dev<TAccBodies> devAcc;
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentBodies;
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentStorage;
+
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMin;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMax;
+    decltype( alpaka::mem::buf::alloc
+            <kernels::morton::Key , TSize>(
+                devAcc, extentBodies) ) accKeys;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accPermutation;
+    // original index of the body at every position, and the
+    // buffers the bodies are gathered into
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accOrder;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accOrderSorted;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, 1) ) accBodiesSorted;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, extentBodies) ) accBodiesVelocitySorted;
+
+    Unpack<
+        TAccBodies,
+        NDim,
+        TElem,
+        TSize> unpack;
+
+    RadixSort<
+        TAccBodies,
+        kernels::morton::Key,
+        TSize,
+        TSize> radixSort;
+
+    // false while the bodies are in their original order
+    bool reordered;
+    std::size_t numReorders;
+
+    auto getWorkDivBodies(
+            TSize const numBodies,
+            std::size_t const elements) const
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                devAcc,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(numBodies),
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(static_cast<TSize>(elements)),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                Unrestricted
+        );
+    }
+
+    // Keys of the bodies on the chosen curve, indices 0, 1, ...
+    template<
+        typename TStream,
+        typename TKeyKernel>
+    auto enqueueKeys(
+            TStream & stream,
+            TKeyKernel const & keyKernel,
+            types::Vector<NDim,TElem> const * const bodiesPosition,
+            TSize const numBodies,
+            std::size_t const elements)
+    -> void
+    {
+        auto const keyExec(
+                alpaka::exec::create<TAccBodies>(
+                    getWorkDivBodies( numBodies, elements ),
+                    keyKernel,
+                    bodiesPosition,
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMin ) ),
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMax ) ),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accKeys ),
+                    alpaka::mem::view::getPtrNative( accPermutation )
+                )
+        );
+        alpaka::stream::enqueue( stream, keyExec );
+    }
+public:
+    // number of steps between two reorderings, 0 never reorders
+    std::size_t interval;
+    // sort along the Hilbert curve, else along the Morton curve
+    bool hilbert;
+
+    Reorder(
+            alpaka::dev::Dev<TAccBodies> const & devAcc,
+            TSize numBodies) :
+        devAcc(devAcc),
+        extentBodies(numBodies),
+        extentStorage(Bodies::size(numBodies)),
+        accBoxMin( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        accBoxMax( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        accKeys( alpaka::mem::buf::alloc
+            <kernels::morton::Key , TSize>( devAcc, extentBodies ) ),
+        accPermutation( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accOrder( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accOrderSorted( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accBodiesSorted( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, extentStorage ) ),
+        accBodiesVelocitySorted( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+        unpack( devAcc ),
+        radixSort( devAcc, numBodies ),
+        reordered(false),
+        numReorders(0),
+        interval(0),
+        hilbert(true)
+    {}
+
+    /** Sorts the bodies along the curve
+     *
+     * The buffers are swapped with the sorted ones, so
+     * pointers into them are invalid afterwards. The
+     * radix sort waits for the stream.
+     *
+     * @param stream stream of the accelerator
+     * @param accBodies positions and masses in the layout
+     * @param accBodiesVelocity velocities of the bodies
+     * @param numBodies number of bodies
+     * @param numMassive bodies before the tracers
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream,
+        typename TBufBodies,
+        typename TBufVelocity>
+    auto operator()(
+            TStream & stream,
+            TBufBodies & accBodies,
+            TBufVelocity & accBodiesVelocity,
+            TSize const numBodies,
+            TSize const numMassive,
+            std::size_t const elements)
+    -> void
+    {
+        Bodies const bodies(
+                alpaka::mem::view::getPtrNative( accBodies ),
+                numBodies );
+        unpack( stream, bodies, numBodies, elements );
+
+        /*** Bounding box ***/
+        kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+        auto const workDivReduce(
+                kernels::ReduceKernel<reduceBlockSize>::
+                    template getWorkDiv<TAccForce>(
+                        devAcc,
+                        static_cast<TSize>(1),
+                        numBodies ) );
+
+        auto const boxMinExec(
+                alpaka::exec::create<TAccForce>(
+                    workDivReduce,
+                    reduceKernel,
+                    unpack.getPositions(),
+                    static_cast<TSize>(0),
+                    static_cast<TSize>(1),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accBoxMin ),
+                    static_cast<TSize>(0),
+                    kernels::reduce::MinElementwise()
+                )
+        );
+        alpaka::stream::enqueue( stream, boxMinExec );
+
+        auto const boxMaxExec(
+                alpaka::exec::create<TAccForce>(
+                    workDivReduce,
+                    reduceKernel,
+                    unpack.getPositions(),
+                    static_cast<TSize>(0),
+                    static_cast<TSize>(1),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accBoxMax ),
+                    static_cast<TSize>(0),
+                    kernels::reduce::MaxElementwise()
+                )
+        );
+        alpaka::stream::enqueue( stream, boxMaxExec );
+
+        /*** Keys ***/
+        auto const workDivBodies( getWorkDivBodies( numBodies, elements ) );
+
+        if( hilbert )
+            enqueueKeys( stream, kernels::HilbertKeyKernel(),
+                    unpack.getPositions(), numBodies, elements );
+        else
+            enqueueKeys( stream, kernels::MortonKeyKernel(),
+                    unpack.getPositions(), numBodies, elements );
+
+        // the indices of the key kernel are the original order
+        if( !reordered )
+            alpaka::mem::view::copy(
+                    stream,
+                    accOrder,
+                    accPermutation,
+                    extentBodies );
+
+        std::size_t numBits( kernels::morton::Bits<NDim>::value );
+        if( numMassive < numBodies )
+        {
+            kernels::TracerKeyKernel tracerKeyKernel;
+            auto const tracerKeyExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivBodies,
+                        tracerKeyKernel,
+                        alpaka::mem::view::getPtrNative( accKeys ),
+                        numMassive,
+                        numBodies,
+                        numBits
+                    )
+            );
+            alpaka::stream::enqueue( stream, tracerKeyExec );
+            numBits++;
+        }
+
+        /*** Sort and gather ***/
+        radixSort(
+                stream,
+                alpaka::mem::view::getPtrNative( accKeys ),
+                alpaka::mem::view::getPtrNative( accPermutation ),
+                numBodies,
+                numBits );
+
+        kernels::ReorderKernel reorderKernel;
+        auto const reorderExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    reorderKernel,
+                    static_cast<TSize const *>(
+                        alpaka::mem::view::getPtrNative( accPermutation ) ),
+                    numBodies,
+                    bodies,
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBodiesVelocity ) ),
+                    static_cast<TSize const *>(
+                        alpaka::mem::view::getPtrNative( accOrder ) ),
+                    Bodies(
+                        alpaka::mem::view::getPtrNative( accBodiesSorted ),
+                        numBodies ),
+                    alpaka::mem::view::getPtrNative( accBodiesVelocitySorted ),
+                    alpaka::mem::view::getPtrNative( accOrderSorted )
+                )
+        );
+        alpaka::stream::enqueue( stream, reorderExec );
+
+        std::swap( accBodies, accBodiesSorted );
+        std::swap( accBodiesVelocity, accBodiesVelocitySorted );
+        std::swap( accOrder, accOrderSorted );
+        reordered = true;
+        numReorders++;
+    }
+
+    // true if the bodies are not in their original order
+    auto isReordered() const
+    -> bool
+    {
+        return reordered;
+    }
+
+    // Number of reorderings so far
+    auto getNumReorders() const
+    -> std::size_t
+    {
+        return numReorders;
+    }
+
+    /** Original indices of the bodies
+     *
+     * Position i holds the original body getOrder()[i].
+     * Only valid if isReordered().
+     */
+    auto getOrder()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accOrder );
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,251 @@
+/** Adaptive global timestep
+ *
+ * This file implements the choice of the next step of
+ * the simulation on the accelerator. Only the chosen
+ * step is copied to the host.
+ *
+ * @file timestep.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// TimestepKernel
+#include <simulation/kernels/timestepKernel.hpp>
+// ReduceKernel, reduce::Min
+#include <simulation/kernels/reduceKernel.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <cmath> // std::sqrt
+#include <limits> // std::numeric_limits
+#include <ostream> // std::ostream
+#include <stdexcept> // std::invalid_argument
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Adaptive global timestep
+ *
+ * The step is the minimum of the steps of the bodies,
+ * see kernels::TimestepKernel.
+ *
+ * @tparam TAccForce 2-dimensional accelerator, used for
+ *         the minimum
+ * @tparam TAccBodies 1-dimensional accelerator
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass and position
+ * @tparam TSize size type
+ */
+template<
+    typename TAccForce,
+    typename TAccBodies,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Timestep
+{
+private:
+    static constexpr std::size_t reduceBlockSize = 256;
+
+    alpaka::dev::Dev<TAccBodies> devAcc;
+    alpaka::dev::DevCpu devHost;
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentBodies;
+
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, extentBodies) ) accSteps;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, 1) ) accStep;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devHost, 1) ) hostStep;
+
+    /*** Plan ***/
+    // elements the work division was chosen for
+    std::size_t planElements;
+    alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize> workDivBodies;
+    // one block, does not depend on elements
+    alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<2u>,
+        TSize> const workDivMin;
+
+    auto getWorkDivBodies(
+            std::size_t const elements) const
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                devAcc,
+                extentBodies,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(elements),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                Unrestricted );
+    }
+public:
+    // accuracy factor
+    TElem eta = static_cast<TElem>( 0.02 );
+    // length scale, 0 takes the softening length, which
+    // then has to be > 0
+    TElem length = static_cast<TElem>( 0 );
+    // upper bound of the step
+    TElem maxStep = std::numeric_limits<TElem>::max();
+
+    Timestep(
+            alpaka::dev::Dev<TAccBodies> const & devAcc,
+            TSize numBodies) :
+        devAcc(devAcc),
+        devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+        extentBodies(numBodies),
+        accSteps( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, extentBodies ) ),
+        accStep( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, 1 ) ),
+        hostStep( alpaka::mem::buf::alloc
+            <TElem , TSize>( devHost, 1 ) ),
+        planElements(1),
+        workDivBodies( getWorkDivBodies( planElements ) ),
+        workDivMin( kernels::ReduceKernel<reduceBlockSize>::
+            template getWorkDiv<TAccForce>(
+                devAcc,
+                static_cast<TSize>(1),
+                numBodies ) )
+    {}
+
+    /** Chooses the work division for elements
+     *
+     * @param elements Alpaka elements per thread
+     */
+    auto updatePlan(
+            std::size_t const elements)
+    -> void
+    {
+        if( elements == planElements )
+            return;
+        planElements = elements;
+        workDivBodies = getWorkDivBodies( elements );
+    }
+
+    // Writes the work divisions of the plan to os
+    auto printPlan(
+            std::ostream & os) const
+    -> void
+    {
+        os << "timestep: " << workDivBodies << "\n";
+        os << "timestep minimum: " << workDivMin << "\n";
+    }
+
+    /** Enqueues the choice of the step
+     *
+     * The step can be read with getStep after the stream
+     * has been waited for. Throws std::invalid_argument if
+     * neither length nor smoothnessFactor is > 0.
+     *
+     * @param stream stream of the accelerator
+     * @param accelerations acceleration/G of body i in the first
+     *        element of row i
+     * @param pitchBytesAccelerations bytes between two rows
+     * @param bodiesVelocity velocities of the bodies
+     * @param numBodies number of bodies
+     * @param gravitationalConstant gravitational constant
+     * @param smoothnessFactor Smoothness Factor
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream,
+        typename TGrav,
+        typename TFactor>
+    auto operator()(
+            TStream & stream,
+            types::Vector<NDim,TElem> const * const accelerations,
+            TSize const pitchBytesAccelerations,
+            types::Vector<NDim,TElem> const * const bodiesVelocity,
+            TSize const numBodies,
+            TGrav const gravitationalConstant,
+            TFactor const smoothnessFactor,
+            std::size_t const elements)
+    -> void
+    {
+        updatePlan( elements );
+
+        TElem const lengthScale( ( length > static_cast<TElem>( 0 ) ) ?
+                length :
+                static_cast<TElem>( std::sqrt( smoothnessFactor ) ) );
+        // every body would propose a step of 0
+        if( !( lengthScale > static_cast<TElem>( 0 ) ) )
+            throw std::invalid_argument(
+                "Timestep: without softening the length has to be set" );
+
+        kernels::TimestepKernel timestepKernel;
+        auto const timestepExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    timestepKernel,
+                    accelerations,
+                    pitchBytesAccelerations,
+                    bodiesVelocity,
+                    numBodies,
+                    gravitationalConstant,
+                    eta,
+                    lengthScale,
+                    maxStep,
+                    alpaka::mem::view::getPtrNative( accSteps )
+                )
+        );
+        alpaka::stream::enqueue( stream, timestepExec );
+
+        kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+        auto const minExec(
+                alpaka::exec::create<TAccForce>(
+                    workDivMin,
+                    reduceKernel,
+                    static_cast<TElem const *>(
+                        alpaka::mem::view::getPtrNative( accSteps ) ),
+                    static_cast<TSize>(0),
+                    static_cast<TSize>(1),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accStep ),
+                    static_cast<TSize>(0),
+                    kernels::reduce::Min()
+                )
+        );
+        alpaka::stream::enqueue( stream, minExec );
+
+        alpaka::mem::view::copy(
+                stream,
+                hostStep,
+                accStep,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >( static_cast<TSize>(1) ) );
+    }
+
+    // step of the last call
+    auto getStep() const
+    -> TElem
+    {
+        return *alpaka::mem::view::getPtrNative( hostStep );
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,510 @@
+/** Tree of the bodies on the accelerator
+ *
+ * This file implements the construction of the 2^NDim-ary
+ * tree which is shared by the tree codes. The bodies are
+ * sorted along a Morton curve, so every cell covers a
+ * contiguous range of bodies and the tree can be created
+ * level by level with a prefix sum over the split cells.
+ *
+ * @file tree.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <vector> // std::vector
+#include <alpaka/alpaka.hpp>
+// ReduceKernel, reduce::MinElementwise, reduce::MaxElementwise
+#include <simulation/kernels/reduceKernel.hpp>
+// MortonKeyKernel, morton::Key, morton::Bits
+#include <simulation/kernels/mortonKeyKernel.hpp>
+// GatherKernel
+#include <simulation/kernels/gatherKernel.hpp>
+// ScanKernel
+#include <simulation/kernels/scanKernel.hpp>
+// TreeRootKernel, TreeSplitKernel, TreeChildrenKernel
+#include <simulation/kernels/treeKernels.hpp>
+// RadixSort
+#include <simulation/algorithms/radixSort.hpp>
+// TreeNode
+#include <simulation/types/treeNode.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Tree of the bodies
+ *
+ * Owns the sorted copy of the bodies and the nodes. The nodes
+ * of a level are stored one after another, the root is node 0.
+ * Only the structure of the tree is built, the moments of the
+ * nodes are left to the solvers.
+ *
+ * @tparam TAccForce 2-dimensional accelerator, used for
+ *         the bounding box
+ * @tparam TAccBodies 1-dimensional accelerator
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass and position
+ * @tparam TSize size type
+ */
+template<
+    typename TAccForce,
+    typename TAccBodies,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Tree
+{
+public:
+    using Node = types::TreeNode<NDim,TElem,TSize>;
+private:
+    static constexpr std::size_t reduceBlockSize = 256;
+    static constexpr std::size_t scanBlockSize = 256;
+
+    alpaka::dev::Dev<TAccBodies> devAcc;
+    alpaka::dev::DevCpu devHost;
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentBodies;
+
+    // number of nodes the node buffers can hold
+    TSize capacity;
+
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMin;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBoxMax;
+    decltype( alpaka::mem::buf::alloc
+            <kernels::morton::Key , TSize>(
+                devAcc, extentBodies) ) accKeys;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, extentBodies) ) accPermutation;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, extentBodies) ) accSortedPosition;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, extentBodies) ) accSortedMass;
+    decltype( alpaka::mem::buf::alloc
+            <Node , TSize>(
+                devAcc, capacity) ) accNodes;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, capacity) ) accSplit;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devAcc, 1) ) accSplitTotal;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(
+                devHost, 1) ) hostSplitTotal;
+
+    RadixSort<
+        TAccBodies,
+        kernels::morton::Key,
+        TSize,
+        TSize> radixSort;
+
+    // index of the first node of every level and the
+    // number of nodes behind the last level
+    std::vector<TSize> levelBegin;
+
+    // The node buffers only grow, the existing nodes and the
+    // offsets of the current level are kept
+    template<
+        typename TStream>
+    auto reserveNodes(
+            TStream & stream,
+            TSize const numNodes,
+            TSize const levelSize,
+            TSize const numNodesNeeded)
+    -> void
+    {
+        if( numNodesNeeded <= capacity )
+            return;
+
+        TSize newCapacity( 2 * capacity );
+        while( newCapacity < numNodesNeeded )
+            newCapacity *= 2;
+
+        auto accNodesNew( alpaka::mem::buf::alloc<Node, TSize>(
+                    devAcc, newCapacity ) );
+        alpaka::mem::view::copy(
+                stream,
+                accNodesNew,
+                accNodes,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(numNodes) );
+        auto accSplitNew( alpaka::mem::buf::alloc<TSize, TSize>(
+                    devAcc, newCapacity ) );
+        alpaka::mem::view::copy(
+                stream,
+                accSplitNew,
+                accSplit,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(levelSize) );
+        alpaka::wait::wait( stream );
+
+        accNodes = accNodesNew;
+        accSplit = accSplitNew;
+        capacity = newCapacity;
+    }
+
+    static auto getInitialCapacity(TSize numBodies)
+    -> TSize
+    {
+        TSize const numChildren( Node::numChildren );
+        return numBodies + numChildren + 1;
+    }
+public:
+    Tree(
+            alpaka::dev::Dev<TAccBodies> const & devAcc,
+            TSize numBodies) :
+        devAcc(devAcc),
+        devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+        extentBodies(numBodies),
+        capacity(getInitialCapacity(numBodies)),
+        accBoxMin( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        accBoxMax( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+        accKeys( alpaka::mem::buf::alloc
+            <kernels::morton::Key , TSize>( devAcc, extentBodies ) ),
+        accPermutation( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, extentBodies ) ),
+        accSortedPosition( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+        accSortedMass( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, extentBodies ) ),
+        accNodes( alpaka::mem::buf::alloc
+            <Node , TSize>( devAcc, capacity ) ),
+        accSplit( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, capacity ) ),
+        accSplitTotal( alpaka::mem::buf::alloc
+            <TSize , TSize>( devAcc, 1 ) ),
+        hostSplitTotal( alpaka::mem::buf::alloc
+            <TSize , TSize>( devHost, 1 ) ),
+        radixSort( devAcc, numBodies )
+    {}
+
+    /** Work division for numElements independent elements */
+    auto getWorkDiv(
+            TSize const numElements,
+            std::size_t const elements) const
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                devAcc,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(numElements),
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(static_cast<TSize>(elements)),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                Unrestricted
+        );
+    }
+
+    /** Builds the tree
+     *
+     * Every level of the tree costs one transfer of
+     * a single value to the host.
+     *
+     * @param stream stream of the accelerator
+     * @param bodiesPosition array of the bodies' position
+     * @param bodiesMass array of the bodies' mass
+     * @param numBodies number of bodies
+     * @param leafSize maximum number of bodies of a leaf
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream>
+    auto operator()(
+            TStream & stream,
+            types::Vector<NDim,TElem> const * const bodiesPosition,
+            TElem const * const bodiesMass,
+            TSize const numBodies,
+            TSize const leafSize,
+            std::size_t const elements)
+    -> void
+    {
+        TSize const numChildren( Node::numChildren );
+
+        auto const workDivBodies( getWorkDiv( numBodies, elements ) );
+
+        /*** Bounding box ***/
+        kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+        auto const workDivReduce(
+                kernels::ReduceKernel<reduceBlockSize>::
+                    template getWorkDiv<TAccForce>(
+                        devAcc,
+                        static_cast<TSize>(1),
+                        numBodies ) );
+
+        auto const boxMinExec(
+                alpaka::exec::create<TAccForce>(
+                    workDivReduce,
+                    reduceKernel,
+                    bodiesPosition,
+                    static_cast<TSize>(0),
+                    static_cast<TSize>(1),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accBoxMin ),
+                    static_cast<TSize>(0),
+                    kernels::reduce::MinElementwise()
+                )
+        );
+        alpaka::stream::enqueue( stream, boxMinExec );
+
+        auto const boxMaxExec(
+                alpaka::exec::create<TAccForce>(
+                    workDivReduce,
+                    reduceKernel,
+                    bodiesPosition,
+                    static_cast<TSize>(0),
+                    static_cast<TSize>(1),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accBoxMax ),
+                    static_cast<TSize>(0),
+                    kernels::reduce::MaxElementwise()
+                )
+        );
+        alpaka::stream::enqueue( stream, boxMaxExec );
+
+        /*** Sort the bodies along the Morton curve ***/
+        kernels::MortonKeyKernel mortonKeyKernel;
+        auto const mortonKeyExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    mortonKeyKernel,
+                    bodiesPosition,
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMin ) ),
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMax ) ),
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accKeys ),
+                    alpaka::mem::view::getPtrNative( accPermutation )
+                )
+        );
+        alpaka::stream::enqueue( stream, mortonKeyExec );
+
+        radixSort(
+                stream,
+                alpaka::mem::view::getPtrNative( accKeys ),
+                alpaka::mem::view::getPtrNative( accPermutation ),
+                numBodies,
+                kernels::morton::Bits<NDim>::value );
+
+        TSize const * const permutation(
+                alpaka::mem::view::getPtrNative( accPermutation ) );
+
+        kernels::GatherKernel gatherKernel;
+        auto const gatherPositionExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    gatherKernel,
+                    bodiesPosition,
+                    permutation,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accSortedPosition )
+                )
+        );
+        alpaka::stream::enqueue( stream, gatherPositionExec );
+
+        auto const gatherMassExec(
+                alpaka::exec::create<TAccBodies>(
+                    workDivBodies,
+                    gatherKernel,
+                    bodiesMass,
+                    permutation,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accSortedMass )
+                )
+        );
+        alpaka::stream::enqueue( stream, gatherMassExec );
+
+        /*** Build the tree level by level ***/
+        kernels::TreeRootKernel treeRootKernel;
+        auto const treeRootExec(
+                alpaka::exec::create<TAccBodies>(
+                    getWorkDiv( static_cast<TSize>(1), 1 ),
+                    treeRootKernel,
+                    alpaka::mem::view::getPtrNative( accNodes ),
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMin ) ),
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBoxMax ) ),
+                    numBodies
+                )
+        );
+        alpaka::stream::enqueue( stream, treeRootExec );
+
+        kernels::TreeSplitKernel treeSplitKernel;
+        kernels::ScanKernel<scanBlockSize> scanKernel;
+        kernels::TreeChildrenKernel treeChildrenKernel;
+
+        levelBegin.clear();
+        levelBegin.push_back( 0 );
+        TSize numNodes( 1 );
+
+        for( TSize level( 0 ); ; level++ )
+        {
+            TSize const levelSize( numNodes - levelBegin.back() );
+
+            auto const workDivLevel( getWorkDiv( levelSize, elements ) );
+
+            auto const treeSplitExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivLevel,
+                        treeSplitKernel,
+                        static_cast<Node const *>(
+                            alpaka::mem::view::getPtrNative( accNodes ) ),
+                        levelBegin.back(),
+                        levelSize,
+                        level,
+                        leafSize,
+                        alpaka::mem::view::getPtrNative( accSplit )
+                    )
+            );
+            alpaka::stream::enqueue( stream, treeSplitExec );
+
+            auto const scanExec(
+                    alpaka::exec::create<TAccBodies>(
+                        kernels::ScanKernel<scanBlockSize>::
+                            template getWorkDiv<TAccBodies>(
+                                devAcc,
+                                levelSize ),
+                        scanKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accSplit ) ),
+                        alpaka::mem::view::getPtrNative( accSplit ),
+                        levelSize,
+                        alpaka::mem::view::getPtrNative( accSplitTotal )
+                    )
+            );
+            alpaka::stream::enqueue( stream, scanExec );
+
+            // the size of the next level is needed on the host
+            alpaka::mem::view::copy(
+                    stream,
+                    hostSplitTotal,
+                    accSplitTotal,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(static_cast<TSize>(1)) );
+            alpaka::wait::wait( stream );
+
+            TSize const numSplit(
+                    *alpaka::mem::view::getPtrNative( hostSplitTotal ) );
+            if( numSplit == 0 )
+                break;
+
+            reserveNodes( stream, numNodes, levelSize,
+                    numNodes + numSplit * numChildren );
+
+            auto const treeChildrenExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivLevel,
+                        treeChildrenKernel,
+                        alpaka::mem::view::getPtrNative( accNodes ),
+                        static_cast<kernels::morton::Key const *>(
+                            alpaka::mem::view::getPtrNative( accKeys ) ),
+                        levelBegin.back(),
+                        levelSize,
+                        level,
+                        leafSize,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accSplit ) ),
+                        numNodes
+                    )
+            );
+            alpaka::stream::enqueue( stream, treeChildrenExec );
+
+            levelBegin.push_back( numNodes );
+            numNodes += numSplit * numChildren;
+        }
+        levelBegin.push_back( numNodes );
+    }
+
+    // Nodes of the last build, the root is node 0
+    auto getNodes()
+    -> Node *
+    {
+        return alpaka::mem::view::getPtrNative( accNodes );
+    }
+
+    // Number of nodes the node buffers can hold
+    auto getCapacity() const
+    -> TSize
+    {
+        return capacity;
+    }
+
+    auto getNumNodes() const
+    -> TSize
+    {
+        return levelBegin.empty() ? 0 : levelBegin.back();
+    }
+
+    // Number of levels of the last build
+    auto getNumLevels() const
+    -> std::size_t
+    {
+        return levelBegin.empty() ? 0 : levelBegin.size() - 1;
+    }
+
+    // Index of the first node of a level, level getNumLevels()
+    // gives the number of nodes
+    auto getLevelBegin(std::size_t const level) const
+    -> TSize
+    {
+        return levelBegin[ level ];
+    }
+
+    // Positions in the order of the tree
+    auto getSortedPositions()
+    -> types::Vector<NDim,TElem> *
+    {
+        return alpaka::mem::view::getPtrNative( accSortedPosition );
+    }
+
+    // Masses in the order of the tree
+    auto getSortedMasses()
+    -> TElem *
+    {
+        return alpaka::mem::view::getPtrNative( accSortedMass );
+    }
+
+    // Original index of every sorted body
+    auto getPermutation()
+    -> TSize *
+    {
+        return alpaka::mem::view::getPtrNative( accPermutation );
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,173 @@
+/** Separate arrays of bodies in any layout
+ *
+ * This file implements the conversion of a Bodies view
+ * into an array of positions and an array of masses for
+ * the solvers which work on these arrays.
+ *
+ * @file unpack.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// UnpackKernel
+#include <simulation/kernels/unpackKernel.hpp>
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace algorithms {
+
+/** Separate arrays of the bodies
+ *
+ * Bodies in the AoS layout are used in place, all other
+ * layouts are copied. The arrays are allocated on the
+ * first copy, so the AoS layout needs no memory.
+ *
+ * @tparam TAcc 1-dimensional accelerator
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass and position
+ * @tparam TSize size type
+ */
+template<
+    typename TAcc,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Unpack
+{
+private:
+    alpaka::dev::Dev<TAcc> devAcc;
+
+    // number of bodies the buffers can hold
+    TSize capacity;
+
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(
+                devAcc, 1) ) accBodiesPosition;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(
+                devAcc, 1) ) accBodiesMass;
+
+    types::Vector<NDim,TElem> const * bodiesPosition;
+    TElem const * bodiesMass;
+public:
+    Unpack(
+            alpaka::dev::Dev<TAcc> const & devAcc) :
+        devAcc(devAcc),
+        capacity(1),
+        accBodiesPosition( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>( devAcc, capacity ) ),
+        accBodiesMass( alpaka::mem::buf::alloc
+            <TElem , TSize>( devAcc, capacity ) ),
+        bodiesPosition( nullptr ),
+        bodiesMass( nullptr )
+    {}
+
+    /** Uses the arrays of the AoS layout
+     *
+     * @param stream stream of the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param numBodies number of bodies
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream>
+    auto operator()(
+            TStream &,
+            types::Bodies<types::layouts::AoS,NDim,TElem,TSize> const & bodies,
+            TSize const,
+            std::size_t const)
+    -> void
+    {
+        bodiesPosition = bodies.position;
+        bodiesMass = bodies.mass;
+    }
+
+    /** Copies the bodies into separate arrays
+     *
+     * @param stream stream of the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param numBodies number of bodies
+     * @param elements Alpaka elements per thread
+     */
+    template<
+        typename TStream,
+        typename TLayout>
+    auto operator()(
+            TStream & stream,
+            types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+            TSize const numBodies,
+            std::size_t const elements)
+    -> void
+    {
+        if( capacity < numBodies )
+        {
+            capacity = numBodies;
+            accBodiesPosition = alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem>, TSize>( devAcc, capacity );
+            accBodiesMass = alpaka::mem::buf::alloc
+                <TElem, TSize>( devAcc, capacity );
+        }
+
+        auto const workDivBodies(
+                alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >( numBodies ),
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >( elements ),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted
+                )
+        );
+
+        kernels::UnpackKernel unpackKernel;
+        auto const unpackExec(
+                alpaka::exec::create<TAcc>(
+                    workDivBodies,
+                    unpackKernel,
+                    bodies,
+                    numBodies,
+                    alpaka::mem::view::getPtrNative( accBodiesPosition ),
+                    alpaka::mem::view::getPtrNative( accBodiesMass )
+                )
+        );
+        alpaka::stream::enqueue( stream, unpackExec );
+
+        bodiesPosition = alpaka::mem::view::getPtrNative( accBodiesPosition );
+        bodiesMass = alpaka::mem::view::getPtrNative( accBodiesMass );
+    }
+
+    // positions of the last call
+    auto getPositions() const
+    -> types::Vector<NDim,TElem> const *
+    {
+        return bodiesPosition;
+    }
+
+    // masses of the last call
+    auto getMasses() const
+    -> TElem const *
+    {
+        return bodiesMass;
+    }
+};
+
+} // namespace algorithms
+
+} // namespace simulation
+
+} // namespace nbody
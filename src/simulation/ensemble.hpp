@@ -0,0 +1,333 @@
+/** Ensemble of small systems
+ *
+ * This file implements a simulation of many independent
+ * systems, e.g. for parameter sweeps. All systems are
+ * stored in one set of buffers and stepped by the same
+ * launches, so a step costs two kernel launches no matter
+ * how many systems there are.
+ *
+ * @file ensemble.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// ACC_FORCEM, STREAM
+#include <simulation/simulation.hpp>
+// BasicEnsembleAccelerationKernel, EnsembleUpdateKernel
+#include <simulation/kernels/ensembleKernels.hpp>
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+    /** Class Ensemble
+     *
+     * Steps numSystems independent systems with the first
+     * order update of integrators::Euler and a direct sum of
+     * the force law TForceLaw. Every system has its own number
+     * of bodies, step, gravitationalConstant and smoothnessFactor.
+     * The bodies of all systems are stored one system after
+     * another, the bodies of system s are
+     * systemBegin[s] ... systemBegin[s+1]-1.
+     *
+     * The kernels use a 2-dimensional work division, the outer
+     * index is the system and the inner one the body. With the
+     * default, every thread steps whole systems.
+     */
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TTime,
+    typename TSize,
+    typename TForceLaw = kernels::forceLaws::Plummer
+    >
+class Ensemble
+{
+private:
+    //alpaka
+    decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) ) devAcc;
+    STREAM stream;
+    alpaka::dev::DevCpu devHost;
+
+    TSize const numSystems;
+    //number of bodies of the largest system
+    TSize maxBodies;
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentBodies;
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentSystems;
+
+    //Data on Host
+    types::Vector<NDim,TElem> * const hostBodiesPosition;
+
+    //Data on Acc
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(devAcc, extentBodies) ) accBodiesPosition;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(devAcc, extentBodies) ) accBodiesVelocity;
+    decltype( alpaka::mem::buf::alloc
+            <TElem , TSize>(devAcc, extentBodies) ) accBodiesMass;
+    decltype( alpaka::mem::buf::alloc
+            <types::Vector<NDim,TElem> , TSize>(devAcc, extentBodies) ) accBodiesAcceleration;
+    decltype( alpaka::mem::buf::alloc
+            <TSize , TSize>(devAcc, 1) ) accSystemBegin;
+    decltype( alpaka::mem::buf::alloc
+            <float , TSize>(devAcc, extentSystems) ) accSmoothnessFactor;
+    decltype( alpaka::mem::buf::alloc
+            <float , TSize>(devAcc, extentSystems) ) accGravitationalConstant;
+    decltype( alpaka::mem::buf::alloc
+            <TTime , TSize>(devAcc, extentSystems) ) accDt;
+
+    //flag if a new step had been done
+    bool stepFlag = true;
+
+    /*** Plan ***/
+    //elements the work division was chosen for
+    std::size_t planElements;
+    alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<2u>,
+        TSize> workDivSystems;
+
+    auto getWorkDivSystems(
+            std::size_t const elements) const
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<2u>,
+        TSize>
+    {
+        return alpaka::workdiv::getValidWorkDiv< ACC_FORCEM >(
+                devAcc,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<2u>,
+                    TSize
+                >(numSystems, maxBodies),
+                alpaka::Vec<
+                    alpaka::dim::DimInt<2u>,
+                    TSize
+                >(static_cast<TSize>(elements), maxBodies),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                Unrestricted );
+    }
+
+    //Copies numElements elements of a host array to the accelerator
+    template<
+        typename TBuf,
+        typename TValue>
+    void upload(TBuf & buf, TValue const * values, TSize numElements)
+    {
+        alpaka::Vec<alpaka::dim::DimInt<1u>,TSize> const extent( numElements );
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::DevCpu,
+            TValue,
+            alpaka::dim::DimInt<1u>,
+            TSize> host( const_cast<TValue *>( values ), devHost, extent );
+        alpaka::mem::view::copy( stream, buf, host, extent );
+    }
+public:
+    std::size_t elements = 8; //Alpaka elements, here systems per thread
+
+    /** Ensemble of numSystems systems
+     *
+     * @param bodiesPosition positions of the bodies of all systems
+     * @param bodiesVelocity velocities of the bodies of all systems
+     * @param bodiesMass masses of the bodies of all systems
+     * @param systemBegin numSystems + 1 indices, the first body of
+     *        every system and the number of all bodies at the end
+     * @param numSystems number of systems
+     * @param dt length of a step of every system
+     * @param smoothnessFactor Smoothness Factor of every system
+     * @param gravitationalConstant constant G of every system
+     */
+    Ensemble(
+            types::Vector<NDim,TElem> * bodiesPosition,
+            types::Vector<NDim,TElem> const * bodiesVelocity,
+            TElem const * bodiesMass,
+            TSize const * systemBegin,
+            TSize numSystems,
+            TTime const * dt,
+            float const * smoothnessFactor,
+            float const * gravitationalConstant) :
+        devAcc(alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0)),
+        stream(devAcc),
+        devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+        numSystems(numSystems),
+        maxBodies(1),
+        extentBodies(systemBegin[numSystems]),
+        extentSystems(numSystems),
+        hostBodiesPosition(bodiesPosition),
+        accBodiesPosition( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+            ( devAcc, extentBodies ) ),
+        accBodiesVelocity( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+            ( devAcc, extentBodies ) ),
+        accBodiesMass( alpaka::mem::buf::alloc<TElem , TSize>
+            ( devAcc, extentBodies ) ),
+        accBodiesAcceleration( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+            ( devAcc, extentBodies ) ),
+        accSystemBegin( alpaka::mem::buf::alloc<TSize , TSize>
+            ( devAcc, numSystems + 1 ) ),
+        accSmoothnessFactor( alpaka::mem::buf::alloc<float , TSize>
+            ( devAcc, extentSystems ) ),
+        accGravitationalConstant( alpaka::mem::buf::alloc<float , TSize>
+            ( devAcc, extentSystems ) ),
+        accDt( alpaka::mem::buf::alloc<TTime , TSize>
+            ( devAcc, extentSystems ) ),
+        planElements(1),
+        workDivSystems( getWorkDivSystems( planElements ) )
+    {
+        for( TSize s( 0 ); s < numSystems; s++ )
+            if( maxBodies < systemBegin[ s + 1 ] - systemBegin[ s ] )
+                maxBodies = systemBegin[ s + 1 ] - systemBegin[ s ];
+        workDivSystems = getWorkDivSystems( planElements );
+
+        /*** Memory copy ***/
+        upload( accBodiesPosition, bodiesPosition, extentBodies[0] );
+        upload( accBodiesVelocity, bodiesVelocity, extentBodies[0] );
+        upload( accBodiesMass, bodiesMass, extentBodies[0] );
+        upload( accSystemBegin, systemBegin, numSystems + 1 );
+        upload( accSmoothnessFactor, smoothnessFactor, numSystems );
+        upload( accGravitationalConstant, gravitationalConstant, numSystems );
+        upload( accDt, dt, numSystems );
+        //Wait for data
+        alpaka::wait::wait( stream );
+    }
+
+    //the buffers must outlive the enqueued steps
+    ~Ensemble()
+    {
+        wait();
+    }
+
+    /*** Funtion to execute a step of every system ***/
+    void step()
+    {
+        steps(1);
+    }
+
+    /*** Function to execute numSteps steps of every system ***/
+    void steps(std::size_t numSteps)
+    {
+        enqueueSteps(numSteps);
+        wait();
+    }
+
+    /** Function to start numSteps steps of every system
+     *
+     * Every step is one launch of the acceleration kernel and
+     * one of the update kernel for all systems.
+     */
+    void enqueueSteps(std::size_t numSteps)
+    {
+        this->stepFlag = true;
+        updatePlan();
+
+        kernels::BasicEnsembleAccelerationKernel<TForceLaw> accelerationKernel;
+        kernels::EnsembleUpdateKernel updateKernel;
+
+        auto const accelerationExec(
+                alpaka::exec::create<ACC_FORCEM>(
+                    workDivSystems,
+                    accelerationKernel,
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBodiesPosition ) ),
+                    static_cast<TElem const *>(
+                        alpaka::mem::view::getPtrNative( accBodiesMass ) ),
+                    static_cast<TSize const *>(
+                        alpaka::mem::view::getPtrNative( accSystemBegin ) ),
+                    static_cast<float const *>(
+                        alpaka::mem::view::getPtrNative( accSmoothnessFactor ) ),
+                    numSystems,
+                    alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                )
+        );
+        auto const updateExec(
+                alpaka::exec::create<ACC_FORCEM>(
+                    workDivSystems,
+                    updateKernel,
+                    static_cast<types::Vector<NDim,TElem> const *>(
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration ) ),
+                    alpaka::mem::view::getPtrNative( accBodiesPosition ),
+                    alpaka::mem::view::getPtrNative( accBodiesVelocity ),
+                    static_cast<TSize const *>(
+                        alpaka::mem::view::getPtrNative( accSystemBegin ) ),
+                    static_cast<float const *>(
+                        alpaka::mem::view::getPtrNative( accGravitationalConstant ) ),
+                    static_cast<TTime const *>(
+                        alpaka::mem::view::getPtrNative( accDt ) ),
+                    numSystems
+                )
+        );
+
+        for(std::size_t i(0); i < numSteps; i++)
+        {
+            alpaka::stream::enqueue( stream, accelerationExec );
+            alpaka::stream::enqueue( stream, updateExec );
+        }
+    }
+
+    /*** Waits for the enqueued steps ***/
+    void wait()
+    {
+        alpaka::wait::wait( stream );
+    }
+
+    //Positions of all systems, in the order of the constructor
+    types::Vector<NDim,TElem> * getPositions()
+    {
+        if(stepFlag)
+        {
+            alpaka::mem::view::ViewPlainPtr<
+                alpaka::dev::DevCpu,
+                types::Vector<NDim,TElem>,
+                alpaka::dim::DimInt<1u>,
+                TSize> host( hostBodiesPosition, devHost, extentBodies );
+            alpaka::mem::view::copy(
+                stream,
+                host,
+                accBodiesPosition,
+                extentBodies );
+            alpaka::wait::wait( stream );
+        }
+        stepFlag = false;
+        return hostBodiesPosition;
+    }
+
+    TSize getNumSystems() const
+    {
+        return numSystems;
+    }
+
+    //Writes the work division of the steps to os
+    void printPlan(std::ostream & os)
+    {
+        updatePlan();
+        os << "systems: " << numSystems
+            << ", bodies: " << extentBodies[0]
+            << ", elements: " << this->elements << "\n";
+        os << "ensemble: " << workDivSystems << "\n";
+    }
+
+private:
+    /*** Chooses the work division again if elements changed ***/
+    void updatePlan()
+    {
+        if( this->elements == planElements )
+            return;
+        planElements = this->elements;
+        workDivSystems = getWorkDivSystems( planElements );
+    }
+};
+
+} //end namespace simulation
+
+} //end namespace nbody
@@ -0,0 +1,538 @@
+/** Block timestep integrator
+ *
+ * This file implements the hierarchical block timesteps:
+ * every body steps with dt / 2^L for its own level L and
+ * only the bodies whose step ends get new accelerations.
+ *
+ * @file blockSteps.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// BlockActiveKernel, BlockCompactKernel, BasicBlockAccelerationKernel,
+// BlockKickKernel, BlockLevelKernel, BlockDeepestKernel
+#include <simulation/kernels/blockStepKernels.hpp>
+// DriftKernel
+#include <simulation/kernels/integratorKernels.hpp>
+// ScanKernel
+#include <simulation/kernels/scanKernel.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace integrators {
+
+/** Block timestep integrator
+ *
+ * A kick-drift-kick leapfrog with power of two steps per
+ * body. A step of dt has 2^maxLevel ticks. Only the ticks
+ * at which the steps of the deepest occupied level end have
+ * active bodies, so only these are visited: all bodies drift
+ * to the next of them, and the active bodies, whose steps end
+ * there, get new accelerations and kicks. Their
+ * accelerations are summed up directly against all bodies,
+ * so a tick costs M x N interactions for M active bodies.
+ * The deepest level is read back on the host before every
+ * visited tick, so a step waits for the accelerator.
+ * The solver of the simulation is not used.
+ *
+ * The levels are chosen on the accelerator from the
+ * accelerations, see kernels::BlockLevelKernel. All bodies
+ * are synchronised at the end of a step of dt.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicBlockSteps
+{
+public:
+    //the accelerations are summed up here, the solver is never called
+    static constexpr bool usesSolver = false;
+
+    /** Integrator for an accelerator
+     *
+     * @tparam TAcc 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Integrator
+    {
+    private:
+        static constexpr std::size_t scanBlockSize = 256;
+
+        alpaka::dev::Dev<TAcc> devAcc;
+        alpaka::dev::DevCpu devHost;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, extentBodies) ) accLevels;
+        // flags of the active bodies, then their prefix sum
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, extentBodies) ) accFlags;
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, extentBodies) ) accOffsets;
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, extentBodies) ) accActive;
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, 1) ) accNumActive;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+        // deepest level of all bodies
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devAcc, 1) ) accDeepest;
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(
+                    devHost, 1) ) hostDeepest;
+
+        // the bodies have accelerations and levels
+        bool started;
+        // ticks visited in the last step
+        TSize numTicksVisited;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivBodies;
+        // one block, does not depend on elements
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> const workDivScan;
+
+        auto getWorkDivBodies(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    extentBodies,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+
+        /*** Collects the bodies whose steps end at tick ***/
+        template<
+            typename TStream>
+        auto selectActive(
+                TStream & stream,
+                TSize const numBodies,
+                TSize const tick)
+        -> void
+        {
+            kernels::BlockActiveKernel activeKernel;
+            auto const activeExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        activeKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accLevels ) ),
+                        numBodies,
+                        maxLevel,
+                        tick,
+                        alpaka::mem::view::getPtrNative( accFlags )
+                    )
+            );
+            alpaka::stream::enqueue( stream, activeExec );
+
+            kernels::ScanKernel<scanBlockSize> scanKernel;
+            auto const scanExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivScan,
+                        scanKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accFlags ) ),
+                        alpaka::mem::view::getPtrNative( accOffsets ),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accNumActive )
+                    )
+            );
+            alpaka::stream::enqueue( stream, scanExec );
+
+            kernels::BlockCompactKernel compactKernel;
+            auto const compactExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        compactKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accFlags ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accOffsets ) ),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accActive )
+                    )
+            );
+            alpaka::stream::enqueue( stream, compactExec );
+        }
+
+        /*** Accelerations of the active bodies ***/
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto accelerate(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor)
+        -> void
+        {
+            kernels::BasicBlockAccelerationKernel<TForceLaw> accelerationKernel;
+            auto const accelerationExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        accelerationKernel,
+                        bodies,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accActive ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accNumActive ) ),
+                        numBodies,
+                        smoothnessFactor,
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, accelerationExec );
+        }
+
+        /*** Half kick of the active bodies ***/
+        template<
+            typename TStream,
+            typename TGrav,
+            typename TTime>
+        auto kick(
+                TStream & stream,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TGrav const gravitationalConstant,
+                TTime const dt)
+        -> void
+        {
+            kernels::BlockKickKernel kickKernel;
+            auto const kickExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        kickKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accActive ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accNumActive ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accLevels ) ),
+                        maxLevel,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accBodiesAcceleration ) ),
+                        bodiesVelocity,
+                        gravitationalConstant,
+                        dt
+                    )
+            );
+            alpaka::stream::enqueue( stream, kickExec );
+        }
+
+        /*** New levels of the active bodies ***/
+        template<
+            typename TStream,
+            typename TGrav,
+            typename TTime>
+        auto assignLevels(
+                TStream & stream,
+                TSize const tick,
+                TGrav const gravitationalConstant,
+                TTime const dt)
+        -> void
+        {
+            kernels::BlockLevelKernel levelKernel;
+            auto const levelExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        levelKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accActive ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accNumActive ) ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accBodiesAcceleration ) ),
+                        alpaka::mem::view::getPtrNative( accLevels ),
+                        maxLevel,
+                        tick,
+                        gravitationalConstant,
+                        dt,
+                        accuracy
+                    )
+            );
+            alpaka::stream::enqueue( stream, levelExec );
+        }
+        /*** Deepest level of all bodies, waits for the stream ***/
+        template<
+            typename TStream>
+        auto getDeepest(
+                TStream & stream,
+                TSize const numBodies)
+        -> TSize
+        {
+            alpaka::mem::view::set(
+                stream,
+                accDeepest,
+                0,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(static_cast<TSize>(1)) );
+
+            kernels::BlockDeepestKernel deepestKernel;
+            auto const deepestExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        deepestKernel,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accLevels ) ),
+                        numBodies,
+                        maxLevel,
+                        alpaka::mem::view::getPtrNative( accDeepest )
+                    )
+            );
+            alpaka::stream::enqueue( stream, deepestExec );
+
+            alpaka::mem::view::copy(
+                stream,
+                hostDeepest,
+                accDeepest,
+                alpaka::Vec<
+                    alpaka::dim::DimInt<1u>,
+                    TSize
+                >(static_cast<TSize>(1)) );
+            alpaka::wait::wait( stream );
+            return *alpaka::mem::view::getPtrNative( hostDeepest );
+        }
+    public:
+        // the smallest step is dt / 2^maxLevel
+        TSize maxLevel = 6;
+        // |G a| step^2 a body may have, see kernels::BlockLevelKernel
+        TElem accuracy = static_cast<TElem>( 1e-3 );
+
+        Integrator(
+                alpaka::dev::Dev<TAcc> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+            extentBodies(numBodies),
+            accLevels( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, extentBodies ) ),
+            accFlags( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, extentBodies ) ),
+            accOffsets( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, extentBodies ) ),
+            accActive( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, extentBodies ) ),
+            accNumActive( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, 1 ) ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            accDeepest( alpaka::mem::buf::alloc
+                <TSize, TSize>( devAcc, 1 ) ),
+            hostDeepest( alpaka::mem::buf::alloc
+                <TSize, TSize>( devHost, 1 ) ),
+            started(false),
+            numTicksVisited(0),
+            planElements(1),
+            workDivBodies( getWorkDivBodies( planElements ) ),
+            workDivScan( kernels::ScanKernel<scanBlockSize>::
+                template getWorkDiv<TAcc>(
+                    devAcc,
+                    numBodies ) )
+        {}
+
+        // Evaluates the forces and assigns the levels again in the next step
+        auto restart()
+        -> void
+        {
+            started = false;
+        }
+
+        // Ticks with active bodies in the last step, at most 2^maxLevel
+        auto getNumTicks() const
+        -> TSize
+        {
+            return numTicksVisited;
+        }
+
+        /** Chooses the work division for elements
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivBodies = getWorkDivBodies( elements );
+        }
+
+        // Writes the work divisions of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "active, compact, accelerations, kick, level, deepest, drift: "
+                << workDivBodies << "\n";
+            os << "scan: " << workDivScan << "\n";
+        }
+
+        /** Accelerations of the last force evaluation
+         *
+         * After a step of dt they belong to the current positions.
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        template<
+            typename TSolver>
+        auto getAccelerations(
+                TSolver &)
+        -> types::Vector<NDim,TElem> const *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        template<
+            typename TSolver>
+        auto getPitchBytesAccelerations(
+                TSolver const &) const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+
+        /** Enqueues one step of dt
+         *
+         * @param stream stream of the accelerator
+         * @param solver solver of the simulation, not used
+         * @param bodies positions and masses of the bodies
+         * @param bodiesVelocity velocities of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param gravitationalConstant gravitational constant
+         * @param dt length of the step of level 0
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TSolver,
+            typename TLayout,
+            typename TFactor,
+            typename TGrav,
+            typename TTime>
+        auto operator()(
+                TStream & stream,
+                TSolver &,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                TGrav const gravitationalConstant,
+                TTime const dt,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+            TSize const numTicks( static_cast<TSize>( 1 ) << maxLevel );
+
+            // at tick 0 every body is active
+            if( !started )
+            {
+                alpaka::mem::view::set(
+                    stream,
+                    accLevels,
+                    0,
+                    extentBodies );
+                selectActive( stream, numBodies, 0 );
+                accelerate( stream, bodies, numBodies, smoothnessFactor );
+                assignLevels( stream, 0, gravitationalConstant, dt );
+                started = true;
+            }
+
+            // the last tick of a step leaves every body active
+            kick( stream, bodiesVelocity, gravitationalConstant, dt );
+
+            kernels::DriftKernel driftKernel;
+            TTime const tickLength( dt / static_cast<TTime>( numTicks ) );
+            numTicksVisited = 0;
+            for( TSize tick( 0 ); tick < numTicks; )
+            {
+                // the next tick with active bodies, every visited
+                // tick is a multiple of the stride of the deepest level
+                TSize const stride(
+                        numTicks >> getDeepest( stream, numBodies ) );
+                tick += stride;
+                numTicksVisited++;
+
+                auto const driftExec(
+                        alpaka::exec::create<TAcc>(
+                            workDivBodies,
+                            driftKernel,
+                            bodies,
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                bodiesVelocity ),
+                            numBodies,
+                            static_cast<TTime>( stride ) * tickLength
+                        )
+                );
+                alpaka::stream::enqueue( stream, driftExec );
+
+                selectActive( stream, numBodies, tick );
+                accelerate( stream, bodies, numBodies, smoothnessFactor );
+                // closes the old step, opens the new one
+                kick( stream, bodiesVelocity, gravitationalConstant, dt );
+                assignLevels( stream, tick, gravitationalConstant, dt );
+                if( tick < numTicks )
+                    kick( stream, bodiesVelocity, gravitationalConstant, dt );
+            }
+        }
+    };
+};
+
+using BlockSteps = BasicBlockSteps<kernels::forceLaws::Plummer>;
+
+} // namespace integrators
+
+} // namespace simulation
+
+} // namespace nbody
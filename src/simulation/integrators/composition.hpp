@@ -0,0 +1,341 @@
+/** Symplectic integrators
+ *
+ * This file implements integrators which are composed of
+ * kick-drift-kick leapfrog steps of different lengths,
+ * the leapfrog itself and the fourth order method of
+ * Forest and Ruth, which Yoshida derived as the triple
+ * jump composition of the leapfrog.
+ *
+ * @file composition.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// KickKernel, DriftKernel
+#include <simulation/kernels/integratorKernels.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <cmath> // std::cbrt
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace integrators {
+
+namespace weights {
+
+// One leapfrog step of length dt
+struct Leapfrog
+{
+    static constexpr std::size_t stages = 1;
+
+    static auto weight(
+            std::size_t const)
+    -> double
+    {
+        return 1.0;
+    }
+};
+
+/** Triple jump of Forest and Ruth
+ *
+ * The middle step goes backwards, so the errors of
+ * third order of the three leapfrog steps cancel.
+ */
+struct ForestRuth
+{
+    static constexpr std::size_t stages = 3;
+
+    static auto weight(
+            std::size_t const stage)
+    -> double
+    {
+        double const outer( 1.0 / ( 2.0 - std::cbrt( 2.0 ) ) );
+        return ( stage == 1 ) ? 1.0 - 2.0 * outer : outer;
+    }
+};
+
+} // namespace weights
+
+/** Composition of leapfrog steps
+ *
+ * Every step runs TWeights::stages kick-drift-kick leapfrog
+ * steps of length weight(stage) * dt. The kicks between two
+ * stages are merged and the accelerations at the end of a
+ * step are reused at the start of the next one, so every
+ * stage costs one force evaluation. The velocities belong
+ * to the same time as the positions after every step.
+ *
+ * @tparam TWeights lengths of the stages, see weights
+ */
+template<
+    typename TWeights>
+class Composition
+{
+public:
+    //the accelerations come from the solver
+    static constexpr bool usesSolver = true;
+
+    /** Integrator for an accelerator
+     *
+     * @tparam TAcc 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Integrator
+    {
+    private:
+        alpaka::dev::Dev<TAcc> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        // the solver holds the accelerations of the current positions
+        bool accelerationsValid;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivBodies;
+
+        auto getWorkDivBodies(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    extentBodies,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+
+        template<
+            typename TStream,
+            typename TSolver,
+            typename TGrav,
+            typename TTime>
+        auto kick(
+                TStream & stream,
+                TSolver & solver,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TSize const numBodies,
+                TGrav const gravitationalConstant,
+                TTime const h)
+        -> void
+        {
+            kernels::KickKernel kickKernel;
+            auto const kickExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        kickKernel,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            solver.getAccelerations() ),
+                        solver.getPitchBytesAccelerations(),
+                        bodiesVelocity,
+                        numBodies,
+                        gravitationalConstant,
+                        h
+                    )
+            );
+            alpaka::stream::enqueue( stream, kickExec );
+        }
+    public:
+        Integrator(
+                alpaka::dev::Dev<TAcc> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            accelerationsValid(false),
+            planElements(1),
+            workDivBodies( getWorkDivBodies( planElements ) )
+        {}
+
+        // Evaluates the forces again in the next step
+        auto restart()
+        -> void
+        {
+            accelerationsValid = false;
+        }
+
+        /** Chooses the work division for elements
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivBodies = getWorkDivBodies( elements );
+        }
+
+        // Writes the work division of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "kick, drift: " << workDivBodies << "\n";
+        }
+
+        /** Accelerations of the last force evaluation
+         *
+         * They belong to the current positions.
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        template<
+            typename TSolver>
+        auto getAccelerations(
+                TSolver & solver)
+        -> types::Vector<NDim,TElem> const *
+        {
+            return solver.getAccelerations();
+        }
+
+        template<
+            typename TSolver>
+        auto getPitchBytesAccelerations(
+                TSolver const & solver) const
+        -> TSize
+        {
+            return solver.getPitchBytesAccelerations();
+        }
+
+        /** Enqueues one step
+         *
+         * The first step evaluates the forces once more, because
+         * there are no accelerations of the start yet.
+         *
+         * @param stream stream of the accelerator
+         * @param solver solver of the accelerations
+         * @param bodies positions and masses of the bodies
+         * @param bodiesVelocity velocities of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param gravitationalConstant gravitational constant
+         * @param dt length of the step
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TSolver,
+            typename TLayout,
+            typename TFactor,
+            typename TGrav,
+            typename TTime>
+        auto operator()(
+                TStream & stream,
+                TSolver & solver,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                TGrav const gravitationalConstant,
+                TTime const dt,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            if( !accelerationsValid )
+            {
+                solver(
+                    stream,
+                    bodies,
+                    numBodies,
+                    smoothnessFactor,
+                    elements );
+                accelerationsValid = true;
+            }
+
+            // length of the kick which is not enqueued yet
+            TTime kickLength( 0 );
+            for( std::size_t stage( 0 ); stage < TWeights::stages; stage++ )
+            {
+                TTime const length(
+                        static_cast<TTime>( TWeights::weight( stage ) ) * dt );
+                kickLength += length / static_cast<TTime>( 2 );
+                kick(
+                    stream,
+                    solver,
+                    bodiesVelocity,
+                    numBodies,
+                    gravitationalConstant,
+                    kickLength );
+
+                kernels::DriftKernel driftKernel;
+                auto const driftExec(
+                        alpaka::exec::create<TAcc>(
+                            workDivBodies,
+                            driftKernel,
+                            bodies,
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                bodiesVelocity ),
+                            numBodies,
+                            length
+                        )
+                );
+                alpaka::stream::enqueue( stream, driftExec );
+
+                solver(
+                    stream,
+                    bodies,
+                    numBodies,
+                    smoothnessFactor,
+                    elements );
+                kickLength = length / static_cast<TTime>( 2 );
+            }
+            kick(
+                stream,
+                solver,
+                bodiesVelocity,
+                numBodies,
+                gravitationalConstant,
+                kickLength );
+        }
+    };
+};
+
+/** Kick-drift-kick leapfrog
+ *
+ * Second order, one force evaluation per step.
+ */
+using Leapfrog = Composition<weights::Leapfrog>;
+
+/** Forest-Ruth integrator
+ *
+ * Fourth order, three force evaluations per step. Also
+ * known as the fourth order method of Yoshida.
+ */
+using ForestRuth = Composition<weights::ForestRuth>;
+
+} // namespace integrators
+
+} // namespace simulation
+
+} // namespace nbody
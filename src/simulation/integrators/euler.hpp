@@ -0,0 +1,210 @@
+/** Euler integrator
+ *
+ * This file implements the original integrator of the
+ * simulation. The UpdatePositionsKernel moves the bodies
+ * with the accelerations of the start of the step.
+ *
+ * @file euler.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// UpdatePositionsKernel
+#include <simulation/kernels/updatePositionsKernel.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace integrators {
+
+/** Euler integrator
+ *
+ * First order and not symplectic, one force evaluation
+ * per step. The energy drifts unless dt is small.
+ */
+class Euler
+{
+public:
+    //the accelerations come from the solver
+    static constexpr bool usesSolver = true;
+
+    /** Integrator for an accelerator
+     *
+     * @tparam TAcc 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Integrator
+    {
+    private:
+        alpaka::dev::Dev<TAcc> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivUpdatePositions;
+
+        auto getWorkDivBodies(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    extentBodies,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+    public:
+        Integrator(
+                alpaka::dev::Dev<TAcc> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            planElements(1),
+            workDivUpdatePositions( getWorkDivBodies( planElements ) )
+        {}
+
+        // Nothing is kept between the steps
+        auto restart()
+        -> void
+        {}
+
+        /** Chooses the work division for elements
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivUpdatePositions = getWorkDivBodies( elements );
+        }
+
+        // Writes the work division of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "updatePositions: " << workDivUpdatePositions << "\n";
+        }
+
+        /** Accelerations of the last force evaluation
+         *
+         * They belong to the positions at the start of the last step.
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        template<
+            typename TSolver>
+        auto getAccelerations(
+                TSolver & solver)
+        -> types::Vector<NDim,TElem> const *
+        {
+            return solver.getAccelerations();
+        }
+
+        template<
+            typename TSolver>
+        auto getPitchBytesAccelerations(
+                TSolver const & solver) const
+        -> TSize
+        {
+            return solver.getPitchBytesAccelerations();
+        }
+
+        /** Enqueues one step
+         *
+         * @param stream stream of the accelerator
+         * @param solver solver of the accelerations
+         * @param bodies positions and masses of the bodies
+         * @param bodiesVelocity velocities of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param gravitationalConstant gravitational constant
+         * @param dt length of the step
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TSolver,
+            typename TLayout,
+            typename TFactor,
+            typename TGrav,
+            typename TTime>
+        auto operator()(
+                TStream & stream,
+                TSolver & solver,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                TGrav const gravitationalConstant,
+                TTime const dt,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            //Calculating the accelerations
+            solver(
+                stream,
+                bodies,
+                numBodies,
+                smoothnessFactor,
+                elements );
+
+            kernels::UpdatePositionsKernel updatePositionsKernel;
+            auto const updatePositionsExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivUpdatePositions,
+                        updatePositionsKernel,
+                        solver.getAccelerations(),
+                        bodies,
+                        bodiesVelocity,
+                        solver.getPitchBytesAccelerations(),
+                        numBodies,
+                        gravitationalConstant,
+                        dt
+                    )
+            );
+            alpaka::stream::enqueue( stream, updatePositionsExec );
+        }
+    };
+};
+
+} // namespace integrators
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,338 @@
+/** Hermite integrator
+ *
+ * This file implements the fourth order Hermite
+ * predictor-corrector integrator. It needs the jerks
+ * of the bodies, so it evaluates the forces with its
+ * own direct summation, the AccelerationJerkKernel.
+ *
+ * @file hermite.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// AccelerationJerkKernel, HermitePredictKernel, HermiteCorrectKernel
+#include <simulation/kernels/hermiteKernels.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace integrators {
+
+/** Hermite integrator
+ *
+ * Fourth order with one force evaluation per step, but
+ * the evaluation includes the jerks and is a direct
+ * summation, so it is meant for small collisional
+ * systems. The solver of the simulation is not used.
+ * Needs 6 N extra vectors.
+ */
+class Hermite
+{
+public:
+    //the forces and jerks are summed up here, the solver is never called
+    static constexpr bool usesSolver = false;
+
+    /** Integrator for an accelerator
+     *
+     * @tparam TAcc 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Integrator
+    {
+    private:
+        alpaka::dev::Dev<TAcc> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        // two halves, the start and the end of a step take turns
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesJerk;
+        // positions in the first half, velocities in the second
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesStart;
+
+        // half with the accelerations and jerks of the current bodies
+        TSize current;
+        bool startValid;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivBodies;
+
+        auto getWorkDivBodies(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAcc >(
+                    devAcc,
+                    extentBodies,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto accelerationJerk(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                types::Vector<NDim,TElem> const * const bodiesVelocity,
+                TSize const half,
+                TSize const numBodies,
+                TFactor const smoothnessFactor)
+        -> void
+        {
+            kernels::AccelerationJerkKernel accelerationJerkKernel;
+            auto const accelerationJerkExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        accelerationJerkKernel,
+                        bodies,
+                        bodiesVelocity,
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesAcceleration ) + half * extentBodies[0],
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesJerk ) + half * extentBodies[0],
+                        numBodies,
+                        smoothnessFactor
+                    )
+            );
+            alpaka::stream::enqueue( stream, accelerationJerkExec );
+        }
+    public:
+        Integrator(
+                alpaka::dev::Dev<TAcc> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, 2 * numBodies ) ),
+            accBodiesJerk( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, 2 * numBodies ) ),
+            accBodiesStart( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, 2 * numBodies ) ),
+            current(0),
+            startValid(false),
+            planElements(1),
+            workDivBodies( getWorkDivBodies( planElements ) )
+        {}
+
+        // Evaluates the forces and jerks again in the next step
+        auto restart()
+        -> void
+        {
+            startValid = false;
+        }
+
+        /** Chooses the work division for elements
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivBodies = getWorkDivBodies( elements );
+        }
+
+        // Writes the work division of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "accelerationJerk, predict, correct: "
+                << workDivBodies << "\n";
+        }
+
+        /** Accelerations of the last force evaluation
+         *
+         * They belong to the predicted positions of the last step.
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        template<
+            typename TSolver>
+        auto getAccelerations(
+                TSolver &)
+        -> types::Vector<NDim,TElem> const *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration ) +
+                current * extentBodies[0];
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        template<
+            typename TSolver>
+        auto getPitchBytesAccelerations(
+                TSolver const &) const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+
+        /** Enqueues one step
+         *
+         * The forces at the predicted bodies are used as the
+         * start of the next step. The first step evaluates the
+         * forces once more, because there is no start yet.
+         *
+         * @param stream stream of the accelerator
+         * @param solver solver of the simulation, not used
+         * @param bodies positions and masses of the bodies
+         * @param bodiesVelocity velocities of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param gravitationalConstant gravitational constant
+         * @param dt length of the step
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TSolver,
+            typename TLayout,
+            typename TFactor,
+            typename TGrav,
+            typename TTime>
+        auto operator()(
+                TStream & stream,
+                TSolver &,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                types::Vector<NDim,TElem> * const bodiesVelocity,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                TGrav const gravitationalConstant,
+                TTime const dt,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            if( !startValid )
+            {
+                accelerationJerk(
+                    stream,
+                    bodies,
+                    bodiesVelocity,
+                    current,
+                    numBodies,
+                    smoothnessFactor );
+                startValid = true;
+            }
+
+            TSize const end( 1 - current );
+            types::Vector<NDim,TElem> * const acceleration(
+                    alpaka::mem::view::getPtrNative( accBodiesAcceleration ) );
+            types::Vector<NDim,TElem> * const jerk(
+                    alpaka::mem::view::getPtrNative( accBodiesJerk ) );
+            types::Vector<NDim,TElem> * const startPosition(
+                    alpaka::mem::view::getPtrNative( accBodiesStart ) );
+            types::Vector<NDim,TElem> * const startVelocity(
+                    startPosition + extentBodies[0] );
+
+            /*** Predict ***/
+            kernels::HermitePredictKernel predictKernel;
+            auto const predictExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        predictKernel,
+                        bodies,
+                        bodiesVelocity,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            acceleration + current * extentBodies[0] ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            jerk + current * extentBodies[0] ),
+                        startPosition,
+                        startVelocity,
+                        numBodies,
+                        gravitationalConstant,
+                        dt
+                    )
+            );
+            alpaka::stream::enqueue( stream, predictExec );
+
+            /*** Evaluate ***/
+            accelerationJerk(
+                stream,
+                bodies,
+                bodiesVelocity,
+                end,
+                numBodies,
+                smoothnessFactor );
+
+            /*** Correct ***/
+            kernels::HermiteCorrectKernel correctKernel;
+            auto const correctExec(
+                    alpaka::exec::create<TAcc>(
+                        workDivBodies,
+                        correctKernel,
+                        bodies,
+                        bodiesVelocity,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            startPosition ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            startVelocity ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            acceleration + current * extentBodies[0] ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            jerk + current * extentBodies[0] ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            acceleration + end * extentBodies[0] ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            jerk + end * extentBodies[0] ),
+                        numBodies,
+                        gravitationalConstant,
+                        dt
+                    )
+            );
+            alpaka::stream::enqueue( stream, correctExec );
+
+            current = end;
+        }
+    };
+};
+
+} // namespace integrators
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,16 @@
+/** A combined include for all integrators
+ *
+ * Combines all integrators in one include.
+ * Less hassle for those who use the integrators
+ *
+ * @file integrators.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include "euler.hpp"
+#include "composition.hpp"
+#include "hermite.hpp"
+#include "blockSteps.hpp"
@@ -0,0 +1,168 @@
+/** Kernel for the direct calculation of accelerations
+ *
+ * This file implements an Alpaka Kernel
+ * for the n body simulation. Unlike the
+ * ForceMatrixKernel it does not store the
+ * single interactions but sums them up right away,
+ * so only one vector per body is written.
+ *
+ * @file accelerationKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Acceleration Kernel
+ *
+ * This class contains the Acceleration Kernel
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicAccelerationKernel
+{
+public:
+    /** Acceleration Kernel
+     *
+     * Every thread takes care of threadElemExtent influenced
+     * bodies. For each of them it walks over all influencing
+     * bodies and sums up the interactions in a register.
+     * The memory needed is therefore O(N) instead of the
+     * O(N^2) of the force matrix.
+     *
+     * Like in the ForceMatrixKernel the gravitationalConstant
+     * is not applied here. This is done by the UpdatePositionsKernel.
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout storage layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     *
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        for( TSize threadBodyInfluenced = 0,
+            indexBodyInfluenced = gridThreadIdx * threadElemExtent;
+            threadBodyInfluenced < threadElemExtent &&
+            indexBodyInfluenced < numBodies;
+            threadBodyInfluenced++,
+            indexBodyInfluenced++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodies.getPosition( indexBodyInfluenced ) );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>(0) );
+
+            for( TSize indexBodyInfluencing = 0;
+                 indexBodyInfluencing < numBodies;
+                 indexBodyInfluencing++)
+            {
+                // the force matrix has zeros on its diagonal
+                if( indexBodyInfluencing == indexBodyInfluenced )
+                    continue;
+
+                // position of influencing relative to influenced body
+                // ( direction of force )
+                types::Vector<NDim,TElem> const positionRelative(
+                        bodies.getPosition( indexBodyInfluencing ) -
+                        positionInfluenced );
+
+                acceleration += TForceLaw::interaction(
+                        acc,
+                        positionRelative,
+                        bodies.getMass( indexBodyInfluencing ),
+                        smoothnessFactor );
+            }
+
+            bodiesAcceleration[ indexBodyInfluenced ] = acceleration;
+        }
+    }
+
+    /** Acceleration Kernel for separate arrays
+     *
+     * @param bodiesPosition array of the bodies' position
+     * @param bodiesMass array of the bodies' mass
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        // the kernel only reads the bodies
+        (*this)(
+            acc,
+            types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                const_cast<TElem *>( bodiesMass ) ),
+            bodiesAcceleration,
+            numBodies,
+            smoothnessFactor );
+    }
+};
+
+// The original Acceleration Kernel with Plummer softening
+using AccelerationKernel = BasicAccelerationKernel<forceLaws::Plummer>;
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,440 @@
+/** Kernels of the block timesteps
+ *
+ * This file implements the Alpaka Kernels of the
+ * hierarchical block timesteps: the selection of the
+ * active bodies, the accelerations of the active bodies,
+ * their kicks, the choice of their new levels and the
+ * deepest level of all bodies.
+ *
+ * @file blockStepKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace block {
+
+/** Level of a body, at most maxLevel
+ *
+ * Level L steps with dt / 2^L. A step of dt has 2^maxLevel
+ * ticks, so a body of level L is synchronised at the ticks
+ * which are a multiple of 2^(maxLevel - L).
+ */
+template<
+    typename TSize>
+ALPAKA_FN_HOST_ACC auto clampLevel(
+    TSize const level,
+    TSize const maxLevel)
+-> TSize
+{
+    return ( level < maxLevel ) ? level : maxLevel;
+}
+
+// true if the steps of level begin and end at tick
+template<
+    typename TSize>
+ALPAKA_FN_HOST_ACC auto synchronised(
+    TSize const level,
+    TSize const maxLevel,
+    TSize const tick)
+-> bool
+{
+    return ( tick % ( static_cast<TSize>( 1 ) << ( maxLevel - level ) ) ) == 0;
+}
+
+} // namespace block
+
+/** Class containing the Block Active Kernel
+ *
+ * flags[i] = 1 if the step of body i ends at tick, else 0
+ */
+class BlockActiveKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const levels,
+        TSize const & numBodies,
+        TSize const & maxLevel,
+        TSize const & tick,
+        TSize * const flags) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            flags[ indexBody ] = block::synchronised(
+                    block::clampLevel( levels[ indexBody ], maxLevel ),
+                    maxLevel,
+                    tick ) ? 1 : 0;
+        }
+    }
+};
+
+/** Class containing the Block Compact Kernel
+ *
+ * Writes the indices of the flagged bodies to active,
+ * offsets is the exclusive prefix sum of the flags.
+ */
+class BlockCompactKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const flags,
+        TSize const * const offsets,
+        TSize const & numBodies,
+        TSize * const active) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            if( flags[ indexBody ] != 0 )
+                active[ offsets[ indexBody ] ] = indexBody;
+        }
+    }
+};
+
+/** Class containing the Block Acceleration Kernel
+ *
+ * Like the AccelerationKernel, but only for the numActive
+ * bodies in active. The threads after the first numActive
+ * elements return at once, so the work is M x N for M
+ * active bodies.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicBlockAccelerationKernel
+{
+public:
+    /** Block Acceleration Kernel
+     *
+     * @param bodies positions and masses of the bodies
+     * @param active indices of the active bodies
+     * @param numActive number of active bodies
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     * @param bodiesAcceleration array for the bodies' acceleration/G,
+     *        only the active bodies are written
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        TSize const * const active,
+        TSize const * const numActive,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        TSize const numSinks( *numActive );
+
+        for( TSize threadSink = 0,
+            indexSink = gridThreadIdx * threadElemExtent;
+            threadSink < threadElemExtent &&
+            indexSink < numSinks;
+            threadSink++,
+            indexSink++)
+        {
+            TSize const indexBody( active[ indexSink ] );
+            types::Vector<NDim,TElem> const position(
+                    bodies.getPosition( indexBody ) );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( TSize indexSource( 0 ); indexSource < numBodies; indexSource++ )
+            {
+                if( indexSource == indexBody )
+                    continue;
+
+                types::Vector<NDim,TElem> const positionRelative(
+                        bodies.getPosition( indexSource ) - position );
+
+                acceleration += TForceLaw::interaction(
+                        acc,
+                        positionRelative,
+                        bodies.getMass( indexSource ),
+                        smoothnessFactor );
+            }
+
+            bodiesAcceleration[ indexBody ] = acceleration;
+        }
+    }
+};
+
+using BlockAccelerationKernel =
+    BasicBlockAccelerationKernel<forceLaws::Plummer>;
+
+/** Class containing the Block Kick Kernel
+ *
+ * Kicks the active bodies by half of the step of their level:
+ * v += G * a * dt / 2^(level + 1)
+ */
+class BlockKickKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const active,
+        TSize const * const numActive,
+        TSize const * const levels,
+        TSize const & maxLevel,
+        types::Vector<NDim,TElem> const * const bodiesAcceleration,
+        types::Vector<NDim,TElem> * const bodiesVelocity,
+        TGrav const & gravitationalConstant,
+        TTime const & dt) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        TSize const numSinks( *numActive );
+
+        for( TSize threadSink = 0,
+            indexSink = gridThreadIdx * threadElemExtent;
+            threadSink < threadElemExtent &&
+            indexSink < numSinks;
+            threadSink++,
+            indexSink++)
+        {
+            TSize const indexBody( active[ indexSink ] );
+            TSize const level(
+                    block::clampLevel( levels[ indexBody ], maxLevel ) );
+            TElem const halfStep(
+                    static_cast<TElem>( dt ) /
+                    static_cast<TElem>( static_cast<TSize>( 2 ) << level ) );
+
+            bodiesVelocity[ indexBody ] +=
+                ( static_cast<TElem>( gravitationalConstant ) * halfStep ) *
+                bodiesAcceleration[ indexBody ];
+        }
+    }
+};
+
+/** Class containing the Block Level Kernel
+ *
+ * Chooses the levels of the active bodies from their
+ * accelerations: the smallest level L with
+ *
+ *     |G a| ( dt / 2^L )^2 <= accuracy
+ *
+ * A body only moves to a lower level if the steps of that
+ * level are synchronised at tick.
+ */
+class BlockLevelKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const active,
+        TSize const * const numActive,
+        types::Vector<NDim,TElem> const * const bodiesAcceleration,
+        TSize * const levels,
+        TSize const & maxLevel,
+        TSize const & tick,
+        TGrav const & gravitationalConstant,
+        TTime const & dt,
+        TElem const & accuracy) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        TSize const numSinks( *numActive );
+
+        for( TSize threadSink = 0,
+            indexSink = gridThreadIdx * threadElemExtent;
+            threadSink < threadElemExtent &&
+            indexSink < numSinks;
+            threadSink++,
+            indexSink++)
+        {
+            TSize const indexBody( active[ indexSink ] );
+            TElem const accelerationSq(
+                    ( static_cast<TElem>( gravitationalConstant ) *
+                      bodiesAcceleration[ indexBody ] ).absSq() );
+
+            // |a|^2 h^4 <= accuracy^2, h halves with every level
+            TElem stepSq( static_cast<TElem>( dt ) * static_cast<TElem>( dt ) );
+            TSize level( 0 );
+            while( level < maxLevel &&
+                   accelerationSq * stepSq * stepSq > accuracy * accuracy )
+            {
+                stepSq /= static_cast<TElem>( 4 );
+                level++;
+            }
+
+            TSize const oldLevel(
+                    block::clampLevel( levels[ indexBody ], maxLevel ) );
+            while( level < oldLevel &&
+                   !block::synchronised( level, maxLevel, tick ) )
+                level++;
+
+            levels[ indexBody ] = level;
+        }
+    }
+};
+
+/** Class containing the Block Deepest Kernel
+ *
+ * The largest level of all bodies. The ticks between two
+ * steps of this level have no active bodies. deepest has
+ * to be 0 before the launch.
+ */
+class BlockDeepestKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const levels,
+        TSize const & numBodies,
+        TSize const & maxLevel,
+        TSize * const deepest) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        // one atomic per thread
+        TSize level( 0 );
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            TSize const bodyLevel(
+                    block::clampLevel( levels[ indexBody ], maxLevel ) );
+            if( level < bodyLevel )
+                level = bodyLevel;
+        }
+        if( level > 0 )
+            alpaka::atomic::atomicOp<alpaka::atomic::op::Max>(
+                    acc,
+                    deepest,
+                    level );
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,367 @@
+/** Kernels of the cell list
+ *
+ * This file implements the Alpaka Kernels which sort
+ * the bodies into a regular grid of cells. After sorting
+ * by the cell index the bodies of every cell form a
+ * contiguous range.
+ *
+ * @file cellListKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <cstdint> // std::int64_t
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace cells {
+
+/** Placement of the cells
+ *
+ * Cell c covers [origin + c * cellSize, origin + (c + 1) * cellSize)
+ * and has the index c_0 + numCells_0 * ( c_1 + numCells_1 * ... ).
+ */
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+struct Geometry
+{
+    types::Vector<NDim,TElem> origin;
+    TElem cellSize;
+    types::Vector<NDim,TSize> numCells;
+};
+
+/** Cell of a position
+ *
+ * Positions outside of the cells are wrapped around for
+ * periodic cells, otherwise moved to the border cells.
+ */
+ALPAKA_NO_HOST_ACC_WARNING
+template<
+    bool TPeriodic,
+    typename TAcc,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+ALPAKA_FN_ACC auto cellOf(
+    TAcc const & acc,
+    Geometry<NDim,TElem,TSize> const & geometry,
+    types::Vector<NDim,TElem> const & position,
+    std::int64_t * const cell)
+-> void
+{
+    for( std::size_t d( 0 ); d < NDim; d++ )
+    {
+        std::int64_t const n(
+                static_cast<std::int64_t>( geometry.numCells[ d ] ) );
+        std::int64_t c( static_cast<std::int64_t>( alpaka::math::floor(
+                        acc,
+                        ( position[ d ] - geometry.origin[ d ] ) /
+                        geometry.cellSize ) ) );
+        if( TPeriodic )
+            c = ( ( c % n ) + n ) % n;
+        else
+            c = ( c < 0 ) ? 0 : ( ( c >= n ) ? n - 1 : c );
+        cell[ d ] = c;
+    }
+}
+
+/** The cell of a body and its neighbouring cells
+ *
+ * Small periodic dimensions are visited completely, so
+ * every cell is counted once.
+ *
+ * @tparam TPeriodic periodic cells
+ */
+template<
+    bool TPeriodic,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Neighbourhood
+{
+private:
+    Geometry<NDim,TElem,TSize> const & geometry;
+    std::int64_t first[ NDim ];
+    std::int64_t count[ NDim ];
+    std::size_t numCells;
+public:
+    /** Neighbourhood of a cell
+     *
+     * @param geometry placement of the cells
+     * @param key index of the cell in the middle
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    ALPAKA_FN_HOST_ACC Neighbourhood(
+        Geometry<NDim,TElem,TSize> const & geometry,
+        TSize const key) :
+        geometry(geometry),
+        numCells(1)
+    {
+        TSize rest( key );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            std::int64_t const n(
+                    static_cast<std::int64_t>( geometry.numCells[ d ] ) );
+            std::int64_t const cell(
+                    static_cast<std::int64_t>( rest % geometry.numCells[ d ] ) );
+            rest /= geometry.numCells[ d ];
+
+            if( TPeriodic && n < 3 )
+            {
+                first[ d ] = 0;
+                count[ d ] = n;
+            }
+            else
+            {
+                first[ d ] = cell - 1;
+                count[ d ] = 3;
+            }
+            numCells *= static_cast<std::size_t>( count[ d ] );
+        }
+    }
+
+    // number of cells of the neighbourhood, some may be outside
+    ALPAKA_FN_HOST_ACC auto size() const
+    -> std::size_t
+    {
+        return numCells;
+    }
+
+    /** Index of a cell of the neighbourhood
+     *
+     * @param neighbour number of the cell, less than size()
+     * @param indexCell index of the cell
+     * @return false if the cell lies outside of isolated cells
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    ALPAKA_FN_HOST_ACC auto cell(
+        std::size_t const neighbour,
+        TSize & indexCell) const
+    -> bool
+    {
+        std::size_t restNeighbour( neighbour );
+        TSize stride( 1 );
+        bool inside( true );
+        indexCell = 0;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            std::int64_t const n(
+                    static_cast<std::int64_t>( geometry.numCells[ d ] ) );
+            std::int64_t cell( first[ d ] + static_cast<std::int64_t>(
+                        restNeighbour % static_cast<std::size_t>( count[ d ] ) ) );
+            restNeighbour /= static_cast<std::size_t>( count[ d ] );
+
+            if( TPeriodic )
+                cell = ( ( cell % n ) + n ) % n;
+            else if( cell < 0 || cell >= n )
+                inside = false;
+
+            indexCell += static_cast<TSize>( cell ) * stride;
+            stride *= geometry.numCells[ d ];
+        }
+        return inside;
+    }
+};
+
+/** Nearest image of a relative position
+ *
+ * Periodic cells fill the box, the relative position is
+ * moved into [-boxSize / 2, boxSize / 2). Isolated cells
+ * leave it as it is.
+ */
+ALPAKA_NO_HOST_ACC_WARNING
+template<
+    bool TPeriodic,
+    typename TAcc,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+ALPAKA_FN_ACC auto nearestImage(
+    TAcc const & acc,
+    Geometry<NDim,TElem,TSize> const & geometry,
+    types::Vector<NDim,TElem> & positionRelative)
+-> void
+{
+    if( !TPeriodic )
+        return;
+    for( std::size_t d( 0 ); d < NDim; d++ )
+    {
+        TElem const boxSize( geometry.cellSize *
+                static_cast<TElem>( geometry.numCells[ d ] ) );
+        positionRelative[ d ] -= boxSize * alpaka::math::floor(
+                acc,
+                positionRelative[ d ] / boxSize +
+                    static_cast<TElem>( 0.5 ) );
+    }
+}
+
+} // namespace cells
+
+/** Class containing the Cell Key Kernel
+ *
+ * Calculates the cell index of every body and initializes
+ * the indices for the sort.
+ *
+ * @tparam TPeriodic periodic cells
+ */
+template<
+    bool TPeriodic>
+class CellKeyKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        cells::Geometry<NDim,TElem,TSize> const & geometry,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TSize const & numBodies,
+        TSize * const keys,
+        TSize * const indices) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            std::int64_t cell[ NDim ];
+            cells::cellOf<TPeriodic>(
+                    acc, geometry, bodiesPosition[ indexBody ], cell );
+
+            TSize key( 0 );
+            TSize stride( 1 );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                key += static_cast<TSize>( cell[ d ] ) * stride;
+                stride *= geometry.numCells[ d ];
+            }
+
+            keys[ indexBody ] = key;
+            indices[ indexBody ] = indexBody;
+        }
+    }
+};
+
+/** Class containing the Cell Clear Kernel
+ *
+ * Marks all cells as empty.
+ */
+class CellClearKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const & numCells,
+        TSize * const cellBegin,
+        TSize * const cellEnd) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadCell = 0,
+            indexCell = gridThreadIdx * threadElemExtent;
+            threadCell < threadElemExtent &&
+            indexCell < numCells;
+            threadCell++,
+            indexCell++)
+        {
+            cellBegin[ indexCell ] = 0;
+            cellEnd[ indexCell ] = 0;
+        }
+    }
+};
+
+/** Class containing the Cell Range Kernel
+ *
+ * Finds the range of bodies of every non-empty cell
+ * in the sorted keys.
+ */
+class CellRangeKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const keys,
+        TSize const & numBodies,
+        TSize * const cellBegin,
+        TSize * const cellEnd) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            TSize const key( keys[ indexBody ] );
+            if( indexBody == 0 || keys[ indexBody - 1 ] != key )
+                cellBegin[ key ] = indexBody;
+            if( indexBody + 1 == numBodies || keys[ indexBody + 1 ] != key )
+                cellEnd[ key ] = indexBody + 1;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,211 @@
+/** Kernels of the ensemble of small systems
+ *
+ * This file implements the Alpaka Kernels which step
+ * many independent systems at once. The outer index of
+ * the 2-dimensional work division is the system, the
+ * inner one the body within the system.
+ *
+ * @file ensembleKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Ensemble Acceleration Kernel
+ *
+ * Sums up the interactions of every body with the bodies
+ * of its own system. The bodies of system s are
+ * systemBegin[s] ... systemBegin[s+1]-1.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicEnsembleAccelerationKernel
+{
+public:
+    /** Ensemble Acceleration Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodiesPosition positions of all systems
+     * @param bodiesMass masses of all systems
+     * @param systemBegin index of the first body of every system
+     *        and the number of bodies at the end
+     * @param smoothnessFactor Smoothness Factor of every system
+     * @param numSystems number of systems
+     * @param accelerations acceleration/G of every body
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const * const systemBegin,
+        TFactor const * const smoothnessFactor,
+        TSize const & numSystems,
+        types::Vector<NDim,TElem> * const accelerations) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 2,
+                "This kernel required 2-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc));
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc ));
+
+        for( TSize threadSystem = 0,
+            indexSystem = gridThreadIdx[0u] * threadElemExtent[0u];
+            threadSystem < threadElemExtent[0u] &&
+            indexSystem < numSystems;
+            threadSystem++,
+            indexSystem++)
+        {
+            TSize const begin( systemBegin[ indexSystem ] );
+            TSize const numBodies( systemBegin[ indexSystem + 1 ] - begin );
+
+            for( TSize threadBody = 0,
+                indexBody = gridThreadIdx[1u] * threadElemExtent[1u];
+                threadBody < threadElemExtent[1u] &&
+                indexBody < numBodies;
+                threadBody++,
+                indexBody++)
+            {
+                types::Vector<NDim,TElem> const position(
+                        bodiesPosition[ begin + indexBody ] );
+                types::Vector<NDim,TElem> acceleration(
+                        static_cast<TElem>( 0 ) );
+
+                for( TSize j( 0 ); j < numBodies; j++ )
+                {
+                    if( j == indexBody )
+                        continue;
+                    acceleration += TForceLaw::interaction(
+                            acc,
+                            bodiesPosition[ begin + j ] - position,
+                            bodiesMass[ begin + j ],
+                            smoothnessFactor[ indexSystem ] );
+                }
+
+                accelerations[ begin + indexBody ] = acceleration;
+            }
+        }
+    }
+};
+
+using EnsembleAccelerationKernel =
+    BasicEnsembleAccelerationKernel<forceLaws::Plummer>;
+
+/** Class containing the Ensemble Update Kernel
+ *
+ * The first order step of the UpdatePositionsKernel with
+ * the step and the gravitationalConstant of every system.
+ */
+class EnsembleUpdateKernel
+{
+public:
+    /** Ensemble Update Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of position and velocity
+     * @param acc the accelerator
+     * @param accelerations acceleration/G of every body
+     * @param bodiesPosition positions of all systems
+     * @param bodiesVelocity velocities of all systems
+     * @param systemBegin index of the first body of every system
+     *        and the number of bodies at the end
+     * @param gravitationalConstant constant G of every system
+     * @param dt length of the step of every system
+     * @param numSystems number of systems
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const accelerations,
+        types::Vector<NDim,TElem> * const bodiesPosition,
+        types::Vector<NDim,TElem> * const bodiesVelocity,
+        TSize const * const systemBegin,
+        TGrav const * const gravitationalConstant,
+        TTime const * const dt,
+        TSize const & numSystems) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 2,
+                "This kernel required 2-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc));
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc ));
+
+        for( TSize threadSystem = 0,
+            indexSystem = gridThreadIdx[0u] * threadElemExtent[0u];
+            threadSystem < threadElemExtent[0u] &&
+            indexSystem < numSystems;
+            threadSystem++,
+            indexSystem++)
+        {
+            TSize const begin( systemBegin[ indexSystem ] );
+            TSize const numBodies( systemBegin[ indexSystem + 1 ] - begin );
+            TTime const step( dt[ indexSystem ] );
+
+            for( TSize threadBody = 0,
+                indexBody = gridThreadIdx[1u] * threadElemExtent[1u];
+                threadBody < threadElemExtent[1u] &&
+                indexBody < numBodies;
+                threadBody++,
+                indexBody++)
+            {
+                TSize const p( begin + indexBody );
+                types::Vector<NDim,TElem> const acceleration(
+                        accelerations[ p ] *
+                        gravitationalConstant[ indexSystem ] );
+                //calculate new position p=a/2*dt² +v*dt + p_0
+                bodiesPosition[ p ] +=
+                    ( 0.5f * acceleration * step + bodiesVelocity[ p ] ) * step;
+                //calculate velocity v=a*dt
+                bodiesVelocity[ p ] += acceleration * step;
+            }
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
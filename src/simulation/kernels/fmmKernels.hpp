@@ -0,0 +1,775 @@
+/** Kernels of the fast multipole method
+ *
+ * This file implements the Alpaka Kernels of the
+ * fast multipole method on the tree of algorithms::Tree.
+ * The expansions are Cartesian Taylor expansions of the
+ * softened potential (|r|^2 + smoothnessFactor)^(-1/2),
+ * so they work for every dimension and include the
+ * smoothness factor of the direct kernels.
+ *
+ * @file fmmKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/treeNode.hpp> // TreeNode
+#include <simulation/kernels/mortonKeyKernel.hpp> // morton::Depth
+// ForceMatrixKernel::interaction
+#include <simulation/kernels/forceMatrixKernel.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace fmm {
+
+template<
+    std::size_t N,
+    std::size_t K>
+struct Binomial
+{
+    std::size_t const static value =
+        Binomial<N - 1, K - 1>::value * N / K;
+};
+
+template<
+    std::size_t N>
+struct Binomial<N, 0>
+{
+    std::size_t const static value = 1;
+};
+
+/** Tables of the expansions
+ *
+ * The expansions store one coefficient per multi-index alpha
+ * with |alpha| <= TOrder, sorted by |alpha|. All translations
+ * run over the pairs (a, b) with |a| + |b| <= TOrder:
+ *
+ *   M2M: M_(a+b) += C(a+b,b) d^a M'_b
+ *   M2L: L_b     += (-1)^|a| C(a+b,b) M_a D_(a+b)
+ *   L2L: L'_b    += C(a+b,b) d^a L_(a+b)
+ *
+ * with the multipole moments M_alpha = sum m (x - c)^alpha, the
+ * local coefficients L and the Taylor coefficients
+ * D_alpha = d^alpha phi / alpha! of the potential.
+ * The tables are created on the host once and copied to the
+ * accelerator.
+ *
+ * @tparam NDim Dimension of the vectors
+ * @tparam TOrder order of the expansions
+ * @tparam TElem datatype of the coefficients
+ */
+template<
+    std::size_t NDim,
+    std::size_t TOrder,
+    typename TElem>
+struct Expansion
+{
+    static_assert( TOrder > 0,
+            "The forces need atleast expansions of order one." );
+
+    std::size_t const static numTerms =
+        Binomial<TOrder + NDim, NDim>::value;
+    std::size_t const static numPairs =
+        Binomial<TOrder + 2 * NDim, 2 * NDim>::value;
+    // marks a multi-index which is not stored
+    std::size_t const static none = numTerms;
+
+    using Coefficients = types::Vector<numTerms,TElem>;
+
+    std::size_t component[ numTerms ][ NDim ];
+    std::size_t degree[ numTerms ];
+    // index of alpha - e_d, none if alpha_d == 0
+    std::size_t lower[ numTerms ][ NDim ];
+
+    std::size_t pairA[ numPairs ];
+    std::size_t pairB[ numPairs ];
+    std::size_t pairSum[ numPairs ];
+    // C(a+b,b) and (-1)^|a| C(a+b,b)
+    TElem shiftCoefficient[ numPairs ];
+    TElem m2lCoefficient[ numPairs ];
+
+    /** Fills the tables */
+    static auto create()
+    -> Expansion
+    {
+        Expansion expansion;
+
+        // all multi-indices of degree 0, 1, ..., TOrder
+        std::size_t numTermsFound( 0 );
+        for( std::size_t deg( 0 ); deg <= TOrder; deg++ )
+        {
+            std::size_t alpha[ NDim ] = {};
+            alpha[ 0 ] = deg;
+            while( true )
+            {
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                    expansion.component[ numTermsFound ][ d ] = alpha[ d ];
+                expansion.degree[ numTermsFound ] = deg;
+                numTermsFound++;
+
+                // next composition of deg
+                std::size_t d( 0 );
+                while( d + 1 < NDim && alpha[ d ] == 0 )
+                    d++;
+                if( d + 1 >= NDim )
+                    break;
+                alpha[ d + 1 ]++;
+                std::size_t const rest( alpha[ d ] - 1 );
+                alpha[ d ] = 0;
+                alpha[ 0 ] = rest;
+            }
+        }
+
+        for( std::size_t t( 0 ); t < numTerms; t++ )
+        {
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                std::size_t alpha[ NDim ];
+                for( std::size_t i( 0 ); i < NDim; i++ )
+                    alpha[ i ] = expansion.component[ t ][ i ];
+                if( alpha[ d ] == 0 )
+                {
+                    expansion.lower[ t ][ d ] = none;
+                    continue;
+                }
+                alpha[ d ]--;
+                expansion.lower[ t ][ d ] = expansion.find( alpha );
+            }
+        }
+
+        std::size_t numPairsFound( 0 );
+        for( std::size_t a( 0 ); a < numTerms; a++ )
+        {
+            for( std::size_t b( 0 ); b < numTerms; b++ )
+            {
+                if( expansion.degree[ a ] + expansion.degree[ b ] > TOrder )
+                    continue;
+                std::size_t sum[ NDim ];
+                TElem coefficient( 1 );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    std::size_t const n(
+                            expansion.component[ a ][ d ] +
+                            expansion.component[ b ][ d ] );
+                    std::size_t const k( expansion.component[ b ][ d ] );
+                    sum[ d ] = n;
+                    for( std::size_t i( 1 ); i <= k; i++ )
+                        coefficient = coefficient *
+                            static_cast<TElem>( n - k + i ) /
+                            static_cast<TElem>( i );
+                }
+                expansion.pairA[ numPairsFound ] = a;
+                expansion.pairB[ numPairsFound ] = b;
+                expansion.pairSum[ numPairsFound ] = expansion.find( sum );
+                expansion.shiftCoefficient[ numPairsFound ] = coefficient;
+                expansion.m2lCoefficient[ numPairsFound ] =
+                    ( expansion.degree[ a ] % 2 == 0 ) ?
+                        coefficient : -coefficient;
+                numPairsFound++;
+            }
+        }
+
+        return expansion;
+    }
+
+    /** Powers w^alpha of a vector
+     *
+     * w^alpha = w^(alpha - e_d) * w_d, with d the first
+     * nonzero component of alpha
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    ALPAKA_FN_HOST_ACC auto powers(
+        types::Vector<NDim,TElem> const & w,
+        Coefficients & result) const
+    -> void
+    {
+        result[ 0 ] = static_cast<TElem>( 1 );
+        for( std::size_t t( 1 ); t < numTerms; t++ )
+        {
+            std::size_t d( 0 );
+            while( lower[ t ][ d ] == none )
+                d++;
+            result[ t ] = result[ lower[ t ][ d ] ] * w[ d ];
+        }
+    }
+
+    /** Taylor coefficients of the softened potential
+     *
+     * result[alpha] = D^alpha phi(r) / alpha! with
+     * phi(r) = (|r|^2 + eps)^(-1/2). They follow from
+     * s D phi = -r phi with s = |r|^2 + eps:
+     * |k| s D_k = -(2|k|-1) sum_d r_d D_(k-e_d)
+     *             -(|k|-1) sum_d D_(k-2e_d)
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TFactor>
+    ALPAKA_FN_ACC auto derivatives(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & r,
+        TFactor const & smoothnessFactor,
+        Coefficients & result) const
+    -> void
+    {
+        TElem const s( r.absSq() + smoothnessFactor );
+        TElem const rs( static_cast<TElem>( 1 ) / s );
+        result[ 0 ] = alpaka::math::rsqrt( acc, s );
+        for( std::size_t t( 1 ); t < numTerms; t++ )
+        {
+            std::size_t const k( degree[ t ] );
+            TElem first( 0 );
+            TElem second( 0 );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                std::size_t const l( lower[ t ][ d ] );
+                if( l == none )
+                    continue;
+                first += r[ d ] * result[ l ];
+                if( lower[ l ][ d ] != none )
+                    second += result[ lower[ l ][ d ] ];
+            }
+            result[ t ] = -(
+                    static_cast<TElem>( 2 * k - 1 ) * first +
+                    static_cast<TElem>( k - 1 ) * second ) *
+                rs / static_cast<TElem>( k );
+        }
+    }
+
+private:
+    auto find(
+        std::size_t const * const alpha) const
+    -> std::size_t
+    {
+        for( std::size_t t( 0 ); t < numTerms; t++ )
+        {
+            bool equal( true );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                equal = equal && component[ t ][ d ] == alpha[ d ];
+            if( equal )
+                return t;
+        }
+        return none;
+    }
+};
+
+} // namespace fmm
+
+/** Class containing the FMM Multipole Kernel
+ *
+ * Calculates the multipole moments
+ * M_alpha = sum m (x - c)^alpha of the nodes of one level
+ * around their center of mass c (P2M for leaves, M2M for
+ * the other nodes) and the radius of the nodes around c.
+ * The centers of mass have to be set by the
+ * TreeMomentsKernel, the levels have to be processed from
+ * the deepest one up to the root.
+ *
+ * @tparam TOrder order of the expansions
+ */
+template<
+    std::size_t TOrder>
+class FmmMultipoleKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        fmm::Expansion<NDim,TOrder,TElem> const * const expansion,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        TElem * const radii,
+        typename fmm::Expansion<NDim,TOrder,TElem>::Coefficients *
+            const multipoles,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const & levelBegin,
+        TSize const & levelSize) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        using Expansion = fmm::Expansion<NDim,TOrder,TElem>;
+        using Coefficients = typename Expansion::Coefficients;
+
+        std::size_t const numChildren(
+                types::TreeNode<NDim,TElem,TSize>::numChildren );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = levelBegin + gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < levelBegin + levelSize;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> const & node(
+                    nodes[ indexNode ] );
+
+            Coefficients multipole( static_cast<TElem>( 0 ) );
+            Coefficients pw;
+            TElem radius( 0 );
+
+            if( node.firstChild == 0 )
+            {
+                // P2M
+                for( TSize i( node.begin ); i < node.end; i++ )
+                {
+                    types::Vector<NDim,TElem> const distance(
+                            bodiesPosition[ i ] - node.centerOfMass );
+                    expansion->powers( distance, pw );
+                    for( std::size_t t( 0 ); t < Expansion::numTerms; t++ )
+                        multipole[ t ] += bodiesMass[ i ] * pw[ t ];
+
+                    TElem const dist( alpaka::math::sqrt(
+                                acc, distance.absSq() ) );
+                    if( radius < dist )
+                        radius = dist;
+                }
+            }
+            else
+            {
+                // M2M
+                for( std::size_t c( 0 ); c < numChildren; c++ )
+                {
+                    TSize const indexChild( node.firstChild + c );
+                    if( nodes[ indexChild ].end == nodes[ indexChild ].begin )
+                        continue;
+
+                    types::Vector<NDim,TElem> const distance(
+                            nodes[ indexChild ].centerOfMass -
+                            node.centerOfMass );
+                    expansion->powers( distance, pw );
+
+                    Coefficients const & multipoleChild(
+                            multipoles[ indexChild ] );
+                    for( std::size_t p( 0 ); p < Expansion::numPairs; p++ )
+                    {
+                        multipole[ expansion->pairSum[ p ] ] +=
+                            expansion->shiftCoefficient[ p ] *
+                            pw[ expansion->pairA[ p ] ] *
+                            multipoleChild[ expansion->pairB[ p ] ];
+                    }
+
+                    TElem const dist( alpaka::math::sqrt(
+                                acc, distance.absSq() ) +
+                            radii[ indexChild ] );
+                    if( radius < dist )
+                        radius = dist;
+                }
+            }
+
+            multipoles[ indexNode ] = multipole;
+            radii[ indexNode ] = radius;
+        }
+    }
+};
+
+/** Class containing the FMM Interaction Kernel
+ *
+ * Every thread takes care of one target node T. It replays
+ * the dual tree traversal along the path from the root to T:
+ * a pair of nodes is accepted if r_A + r_S < theta * |c_A - c_S|,
+ * a pair of leaves which is not accepted is summed up directly,
+ * otherwise the larger node is split. Only the pairs with T as
+ * target are evaluated by the thread (M2L into the local
+ * expansion of T, P2P into the bodies of T), so every pair is
+ * evaluated exactly once. The pairs of the ancestors of T reach
+ * T by the FmmLocalKernel.
+ *
+ * @tparam TOrder order of the expansions
+ */
+template<
+    std::size_t TOrder>
+class FmmInteractionKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        fmm::Expansion<NDim,TOrder,TElem> const * const expansion,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        TElem const * const radii,
+        typename fmm::Expansion<NDim,TOrder,TElem>::Coefficients const *
+            const multipoles,
+        typename fmm::Expansion<NDim,TOrder,TElem>::Coefficients *
+            const locals,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const & numNodes,
+        TElem const & theta,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const nearAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        using Expansion = fmm::Expansion<NDim,TOrder,TElem>;
+        using Coefficients = typename Expansion::Coefficients;
+        using Node = types::TreeNode<NDim,TElem,TSize>;
+
+        std::size_t const numChildren( Node::numChildren );
+        std::size_t const maxDepth( morton::Depth<NDim>::value );
+        // every split of a source leaves at most numChildren - 1
+        // pairs behind, a split of the target replaces its pair
+        std::size_t const stackSize( maxDepth * ( numChildren - 1 ) + 1 );
+
+        TElem const thetaSq( theta * theta );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexTarget = gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexTarget < numNodes;
+            threadNode++,
+            indexTarget++)
+        {
+            Node const & target( nodes[ indexTarget ] );
+            Coefficients local( static_cast<TElem>( 0 ) );
+
+            if( target.end == target.begin )
+            {
+                locals[ indexTarget ] = local;
+                continue;
+            }
+
+            bool const targetLeaf( target.firstChild == 0 );
+            if( targetLeaf )
+            {
+                for( TSize i( target.begin ); i < target.end; i++ )
+                    nearAcceleration[ i ] =
+                        types::Vector<NDim,TElem>( static_cast<TElem>( 0 ) );
+            }
+
+            // path from the root to the target
+            TSize path[ maxDepth + 1 ];
+            std::size_t targetDepth( 0 );
+            path[ 0 ] = 0;
+            while( path[ targetDepth ] != indexTarget )
+            {
+                Node const & node( nodes[ path[ targetDepth ] ] );
+                TSize next( node.firstChild );
+                for( std::size_t c( 0 ); c < numChildren; c++ )
+                {
+                    Node const & child( nodes[ node.firstChild + c ] );
+                    if( child.begin <= target.begin &&
+                        target.begin < child.end )
+                    {
+                        next = node.firstChild + c;
+                        break;
+                    }
+                }
+                path[ ++targetDepth ] = next;
+            }
+
+            // pairs of ( depth of the target on the path, source )
+            std::size_t stackDepth[ stackSize ];
+            TSize stackSource[ stackSize ];
+            std::size_t stackTop( 0 );
+            stackDepth[ stackTop ] = 0;
+            stackSource[ stackTop ] = 0;
+            stackTop++;
+
+            Coefficients derivatives;
+
+            while( stackTop > 0 )
+            {
+                stackTop--;
+                std::size_t const depth( stackDepth[ stackTop ] );
+                TSize const indexSource( stackSource[ stackTop ] );
+                TSize const indexA( path[ depth ] );
+
+                Node const & a( nodes[ indexA ] );
+                Node const & source( nodes[ indexSource ] );
+
+                if( source.end == source.begin )
+                    continue;
+
+                types::Vector<NDim,TElem> const distance(
+                        a.centerOfMass - source.centerOfMass );
+                TElem const radiusSum(
+                        radii[ indexA ] + radii[ indexSource ] );
+
+                if( radiusSum * radiusSum < thetaSq * distance.absSq() )
+                {
+                    if( depth != targetDepth )
+                        continue;
+
+                    // M2L
+                    expansion->derivatives(
+                            acc, distance, smoothnessFactor, derivatives );
+                    Coefficients const & multipole(
+                            multipoles[ indexSource ] );
+                    for( std::size_t p( 0 ); p < Expansion::numPairs; p++ )
+                    {
+                        local[ expansion->pairB[ p ] ] +=
+                            expansion->m2lCoefficient[ p ] *
+                            multipole[ expansion->pairA[ p ] ] *
+                            derivatives[ expansion->pairSum[ p ] ];
+                    }
+                    continue;
+                }
+
+                bool const aLeaf( a.firstChild == 0 );
+                bool const sourceLeaf( source.firstChild == 0 );
+
+                if( aLeaf && sourceLeaf )
+                {
+                    // a leaf on the path is the target itself: P2P
+                    for( TSize i( target.begin ); i < target.end; i++ )
+                    {
+                        types::Vector<NDim,TElem> const positionInfluenced(
+                                bodiesPosition[ i ] );
+                        types::Vector<NDim,TElem> acceleration(
+                                nearAcceleration[ i ] );
+                        for( TSize j( source.begin ); j < source.end; j++ )
+                        {
+                            if( i == j )
+                                continue;
+                            acceleration += ForceMatrixKernel::interaction(
+                                    acc,
+                                    bodiesPosition[ j ] - positionInfluenced,
+                                    bodiesMass[ j ],
+                                    smoothnessFactor );
+                        }
+                        nearAcceleration[ i ] = acceleration;
+                    }
+                }
+                else if( !aLeaf && ( sourceLeaf || a.size >= source.size ) )
+                {
+                    // the children of the target continue on their own
+                    if( depth == targetDepth )
+                        continue;
+                    stackDepth[ stackTop ] = depth + 1;
+                    stackSource[ stackTop ] = indexSource;
+                    stackTop++;
+                }
+                else
+                {
+                    for( std::size_t c( 0 ); c < numChildren; c++ )
+                    {
+                        stackDepth[ stackTop ] = depth;
+                        stackSource[ stackTop ] = source.firstChild + c;
+                        stackTop++;
+                    }
+                }
+            }
+
+            locals[ indexTarget ] = local;
+        }
+    }
+};
+
+/** Class containing the FMM Local Kernel
+ *
+ * Shifts the local expansions of the nodes of one level
+ * to their children and adds them there (L2L). The levels
+ * have to be processed from the root down.
+ *
+ * @tparam TOrder order of the expansions
+ */
+template<
+    std::size_t TOrder>
+class FmmLocalKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        fmm::Expansion<NDim,TOrder,TElem> const * const expansion,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        typename fmm::Expansion<NDim,TOrder,TElem>::Coefficients *
+            const locals,
+        TSize const & levelBegin,
+        TSize const & levelSize) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        using Expansion = fmm::Expansion<NDim,TOrder,TElem>;
+        using Coefficients = typename Expansion::Coefficients;
+
+        std::size_t const numChildren(
+                types::TreeNode<NDim,TElem,TSize>::numChildren );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = levelBegin + gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < levelBegin + levelSize;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> const & node(
+                    nodes[ indexNode ] );
+            if( node.firstChild == 0 )
+                continue;
+
+            Coefficients const local( locals[ indexNode ] );
+            Coefficients pw;
+
+            for( std::size_t c( 0 ); c < numChildren; c++ )
+            {
+                TSize const indexChild( node.firstChild + c );
+                if( nodes[ indexChild ].end == nodes[ indexChild ].begin )
+                    continue;
+
+                expansion->powers(
+                        nodes[ indexChild ].centerOfMass - node.centerOfMass,
+                        pw );
+
+                Coefficients localChild( locals[ indexChild ] );
+                for( std::size_t p( 0 ); p < Expansion::numPairs; p++ )
+                {
+                    localChild[ expansion->pairB[ p ] ] +=
+                        expansion->shiftCoefficient[ p ] *
+                        pw[ expansion->pairA[ p ] ] *
+                        local[ expansion->pairSum[ p ] ];
+                }
+                locals[ indexChild ] = localChild;
+            }
+        }
+    }
+};
+
+/** Class containing the FMM Evaluate Kernel
+ *
+ * Evaluates the gradient of the local expansions of the
+ * leaves at their bodies (L2P), adds the direct part and
+ * writes the accelerations in the original order.
+ *
+ * @tparam TOrder order of the expansions
+ */
+template<
+    std::size_t TOrder>
+class FmmEvaluateKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        fmm::Expansion<NDim,TOrder,TElem> const * const expansion,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        typename fmm::Expansion<NDim,TOrder,TElem>::Coefficients const *
+            const locals,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        types::Vector<NDim,TElem> const * const nearAcceleration,
+        TSize const * const permutation,
+        TSize const & numNodes,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        using Expansion = fmm::Expansion<NDim,TOrder,TElem>;
+        using Coefficients = typename Expansion::Coefficients;
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < numNodes;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> const & node(
+                    nodes[ indexNode ] );
+            if( node.firstChild != 0 )
+                continue;
+
+            Coefficients const & local( locals[ indexNode ] );
+            Coefficients pw;
+
+            for( TSize i( node.begin ); i < node.end; i++ )
+            {
+                expansion->powers(
+                        bodiesPosition[ i ] - node.centerOfMass,
+                        pw );
+
+                // d/dw_d w^gamma = gamma_d w^(gamma - e_d)
+                types::Vector<NDim,TElem> acceleration(
+                        nearAcceleration[ i ] );
+                for( std::size_t t( 1 ); t < Expansion::numTerms; t++ )
+                {
+                    for( std::size_t d( 0 ); d < NDim; d++ )
+                    {
+                        std::size_t const l( expansion->lower[ t ][ d ] );
+                        if( l == Expansion::none )
+                            continue;
+                        acceleration[ d ] += static_cast<TElem>(
+                                expansion->component[ t ][ d ] ) *
+                            local[ t ] * pw[ l ];
+                    }
+                }
+
+                bodiesAcceleration[ permutation[ i ] ] = acceleration;
+            }
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,236 @@
+/** Force laws of the direct summation kernels
+ *
+ * This file implements the interactions of two bodies
+ * as policies for the direct summation kernels, e.g. the
+ * BasicAccelerationKernel. The law is a template
+ * parameter, so the kernels get the inner loop of every
+ * law without a branch on the law.
+ *
+ * @file forceLaws.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <ratio> // std::ratio
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace forceLaws {
+
+/** Force laws
+ *
+ * Every law has a static interaction( acc, positionRelative,
+ * massInfluencing, smoothnessFactor ) which returns the
+ * acceleration/G of the influenced body. positionRelative is
+ * the position of the influencing body relative to the
+ * influenced one. The gravitationalConstant is applied by
+ * the integrators, once per body.
+ */
+
+/** Plummer softening, the original law
+ *
+ *     a = m r / ( |r|^2 + smoothnessFactor )^(3/2)
+ */
+struct Plummer
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const & smoothnessFactor)
+    -> types::Vector<NDim,TElem>
+    {
+        // Distance squared + smoothnessFactor
+        auto const dist(
+                positionRelative.absSq() +
+                smoothnessFactor);
+
+        auto const distCb(dist*dist*dist);
+
+        auto const rdistCb(alpaka::math::rsqrt(acc,distCb));
+        // force scalar and normalizing factor
+        // force scalar * 1/(distance)
+        TElem const forceFactor(
+                //This is handled by the UpdatePositionsKernel
+                //gravitationalConstant *
+                //bodiesMass[indexBodyInfluenced] *
+                massInfluencing *
+                rdistCb);
+
+        return forceFactor * positionRelative;
+    }
+};
+
+/** Newtonian gravity without softening
+ *
+ * Plummer with a smoothnessFactor of zero folded in at
+ * compile time, the smoothnessFactor is ignored.
+ */
+struct Newton
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const &)
+    -> types::Vector<NDim,TElem>
+    {
+        TElem const dist( positionRelative.absSq() );
+        TElem const rdistCb( alpaka::math::rsqrt( acc, dist * dist * dist ) );
+
+        return ( massInfluencing * rdistCb ) * positionRelative;
+    }
+};
+
+/** Cubic spline softening after Monaghan and Lattanzio
+ *
+ * The mass of the influencing body is smeared out with
+ * the cubic spline kernel of radius h, so the force is
+ * exactly Newtonian beyond h and has no singularity. h is
+ * 2.8 sqrt( smoothnessFactor ), which gives the potential
+ * of the Plummer law at r = 0.
+ */
+struct Spline
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const & smoothnessFactor)
+    -> types::Vector<NDim,TElem>
+    {
+        TElem const h( static_cast<TElem>( 2.8 ) * alpaka::math::sqrt(
+                acc, static_cast<TElem>( smoothnessFactor ) ) );
+        TElem const dist( positionRelative.absSq() );
+
+        TElem forceFactor;
+        if( dist >= h * h )
+        {
+            forceFactor = alpaka::math::rsqrt( acc, dist * dist * dist );
+        }
+        else
+        {
+            TElem const hInv( static_cast<TElem>( 1 ) / h );
+            TElem const hInvCb( hInv * hInv * hInv );
+            TElem const u( alpaka::math::sqrt( acc, dist ) * hInv );
+            if( u < static_cast<TElem>( 0.5 ) )
+                forceFactor = hInvCb * ( static_cast<TElem>( 32.0 / 3.0 ) +
+                        u * u * ( static_cast<TElem>( 32.0 ) * u -
+                        static_cast<TElem>( 38.4 ) ) );
+            else
+                forceFactor = hInvCb * ( static_cast<TElem>( 64.0 / 3.0 ) -
+                        static_cast<TElem>( 48.0 ) * u +
+                        static_cast<TElem>( 38.4 ) * u * u -
+                        static_cast<TElem>( 32.0 / 3.0 ) * u * u * u -
+                        static_cast<TElem>( 1.0 / 15.0 ) / ( u * u * u ) );
+        }
+
+        return ( massInfluencing * forceFactor ) * positionRelative;
+    }
+};
+
+/** Repulsive Coulomb interaction with Plummer softening
+ *
+ * For plasma runs of like charges: the mass of a body is
+ * read as its charge times charge/mass ratio, and the
+ * bodies repel each other.
+ */
+struct Coulomb
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const & smoothnessFactor)
+    -> types::Vector<NDim,TElem>
+    {
+        return Plummer::interaction(
+                acc,
+                positionRelative,
+                -massInfluencing,
+                smoothnessFactor );
+    }
+};
+
+/** Truncated force law
+ *
+ * TForceLaw up to the radius TRadius, no force beyond it.
+ * The radius is a std::ratio, so it is folded in at
+ * compile time.
+ *
+ * @tparam TForceLaw law within the radius
+ * @tparam TRadius radius of the cutoff, e.g. std::ratio<5,2>
+ */
+template<
+    typename TForceLaw,
+    typename TRadius>
+struct Cutoff
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const & smoothnessFactor)
+    -> types::Vector<NDim,TElem>
+    {
+        TElem const radius(
+                static_cast<TElem>( TRadius::num ) /
+                static_cast<TElem>( TRadius::den ) );
+        // zero mass instead of a branch around the law
+        TElem const mass( ( positionRelative.absSq() < radius * radius ) ?
+                massInfluencing : static_cast<TElem>( 0 ) );
+
+        return TForceLaw::interaction(
+                acc,
+                positionRelative,
+                mass,
+                smoothnessFactor );
+    }
+};
+
+} // namespace forceLaws
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
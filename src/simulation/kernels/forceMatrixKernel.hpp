@@ -17,6 +17,8 @@
 #include <stdio.h> // printf
 #include <alpaka/alpaka.hpp>
 #include <simulation/types/vector.hpp> // Vector
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
 
 namespace nbody {
 
@@ -28,8 +30,11 @@ namespace kernels {
  *
  * This class contains the Force Matrix Kernel
  *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
  */
-class ForceMatrixKernel
+template<
+    typename TForceLaw>
+class BasicForceMatrixKernel
 {
 public:
     /** Force Matrix Kernel
@@ -117,25 +122,12 @@ public:
                         bodiesPosition[ indexBodyInfluencing ] -
                         bodiesPosition[ indexBodyInfluenced ] );
 
-                // Distance squared + smoothnessFactor
-                auto const dist(
-                        positionRelative.absSq() +
+                auto const result = interaction(
+                        acc,
+                        positionRelative,
+                        bodiesMass[indexBodyInfluencing],
                         smoothnessFactor);
 
-                auto const distCb(dist*dist*dist);
-
-                auto const rdistCb(alpaka::math::rsqrt(acc,distCb));
-                // force scalar and normalizing factor
-                // force scalar * 1/(distance)
-                TElem const forceFactor(
-                        //This is handled by the UpdatePositionsKernel
-                        //gravitationalConstant *
-                        //bodiesMass[indexBodyInfluenced] *
-                        bodiesMass[indexBodyInfluencing] *
-                        rdistCb);
-
-                auto const result = forceFactor * positionRelative;
-
                 // Save value
                 matrixRow[indexBodyInfluencing] = result;
             }
@@ -144,8 +136,43 @@ public:
                 types::Vector<NDim, TElem>(static_cast<TElem>(0));
         }
     }
+
+    /** Interaction of two bodies
+     *
+     * The formula of a single element of the force matrix.
+     * Other kernels use it for their direct sums.
+     *
+     * @param acc the accelerator
+     * @param positionRelative position of the influencing body
+     *        relative to the influenced body
+     * @param massInfluencing mass of the influencing body
+     * @param smoothnessFactor Smoothness Factor
+     * @return acceleration/G of the influenced body
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto interaction(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const & positionRelative,
+        TElem const & massInfluencing,
+        TFactor const & smoothnessFactor)
+    -> types::Vector<NDim,TElem>
+    {
+        return TForceLaw::interaction(
+                acc,
+                positionRelative,
+                massInfluencing,
+                smoothnessFactor );
+    }
 };
 
+// The original Force Matrix Kernel with Plummer softening
+using ForceMatrixKernel = BasicForceMatrixKernel<forceLaws::Plummer>;
+
 } // namespace kernels
 
 } // namespace simulation
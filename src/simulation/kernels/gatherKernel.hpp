@@ -0,0 +1,113 @@
+/** Kernel for the permutation of arrays
+ *
+ * This file implements two Alpaka Kernels
+ * which reorder an array by a permutation.
+ *
+ * @file gatherKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Gather Kernel
+ *
+ * output[i] = input[ permutation[i] ]
+ */
+class GatherKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TElem const * const input,
+        TSize const * const permutation,
+        TSize const & numElements,
+        TElem * const output) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadElem = 0,
+            index = gridThreadIdx * threadElemExtent;
+            threadElem < threadElemExtent &&
+            index < numElements;
+            threadElem++,
+            index++)
+        {
+            output[ index ] = input[ permutation[ index ] ];
+        }
+    }
+};
+
+/** Class containing the Scatter Kernel
+ *
+ * output[ permutation[i] ] = input[i]
+ * This undoes the GatherKernel.
+ */
+class ScatterKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TElem const * const input,
+        TSize const * const permutation,
+        TSize const & numElements,
+        TElem * const output) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadElem = 0,
+            index = gridThreadIdx * threadElemExtent;
+            threadElem < threadElemExtent &&
+            index < numElements;
+            threadElem++,
+            index++)
+        {
+            output[ permutation[ index ] ] = input[ index ];
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
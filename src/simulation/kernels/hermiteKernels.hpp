@@ -0,0 +1,316 @@
+/** Kernels of the Hermite integrator
+ *
+ * This file implements the Alpaka Kernels of the fourth
+ * order Hermite predictor-corrector scheme: a direct
+ * summation of accelerations and their time derivatives
+ * (jerks), the predictor and the corrector.
+ *
+ * @file hermiteKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Acceleration Jerk Kernel
+ *
+ * Like the AccelerationKernel, but it also reads the
+ * velocities and sums up the jerks
+ *
+ *     j_i = sum_k m_k ( v / r^3 - 3 ( r . v ) r / r^5 )
+ *
+ * with r and v the position and velocity of body k
+ * relative to body i.
+ */
+class AccelerationJerkKernel
+{
+public:
+    /** Acceleration Jerk Kernel
+     *
+     * The gravitationalConstant is not applied here. This is
+     * done by the HermiteCorrectKernel.
+     *
+     * @param bodies positions and masses of the bodies
+     * @param bodiesVelocity velocities of the bodies
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param bodiesJerk array for the bodies' jerk/G
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> const * const bodiesVelocity,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        types::Vector<NDim,TElem> * const bodiesJerk,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const position(
+                    bodies.getPosition( indexBody ) );
+            types::Vector<NDim,TElem> const velocity(
+                    bodiesVelocity[ indexBody ] );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+            types::Vector<NDim,TElem> jerk(
+                    static_cast<TElem>( 0 ) );
+
+            for( TSize indexOther( 0 ); indexOther < numBodies; indexOther++ )
+            {
+                if( indexOther == indexBody )
+                    continue;
+
+                types::Vector<NDim,TElem> const positionRelative(
+                        bodies.getPosition( indexOther ) - position );
+                types::Vector<NDim,TElem> const velocityRelative(
+                        bodiesVelocity[ indexOther ] - velocity );
+
+                // Distance squared + smoothnessFactor
+                TElem const dist(
+                        positionRelative.absSq() +
+                        smoothnessFactor);
+                TElem const rdist( alpaka::math::rsqrt( acc, dist ) );
+                TElem const rdistSq( rdist * rdist );
+                TElem const massRdistCb(
+                        bodies.getMass( indexOther ) * rdist * rdistSq );
+
+                TElem positionDotVelocity( 0 );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                    positionDotVelocity +=
+                        positionRelative[ d ] * velocityRelative[ d ];
+
+                acceleration += massRdistCb * positionRelative;
+                jerk += massRdistCb * ( velocityRelative -
+                        ( static_cast<TElem>( 3 ) * positionDotVelocity *
+                          rdistSq ) * positionRelative );
+            }
+
+            bodiesAcceleration[ indexBody ] = acceleration;
+            bodiesJerk[ indexBody ] = jerk;
+        }
+    }
+};
+
+/** Class containing the Hermite Predict Kernel
+ *
+ * Saves the positions and velocities of the start of the step
+ * and replaces them by their Taylor series up to the jerk:
+ *
+ *     x_p = x + v dt + a dt^2 / 2 + j dt^3 / 6
+ *     v_p = v + a dt + j dt^2 / 2
+ */
+class HermitePredictKernel
+{
+public:
+    /** Hermite Predict Kernel
+     *
+     * @param bodies positions and masses of the bodies
+     * @param bodiesVelocity velocities of the bodies
+     * @param bodiesAcceleration acceleration/G of the start
+     * @param bodiesJerk jerk/G of the start
+     * @param startPosition array for the positions of the start
+     * @param startVelocity array for the velocities of the start
+     * @param numBodies number of bodies
+     * @param gravitationalConstant gravitational constant
+     * @param dt length of the step
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesVelocity,
+        types::Vector<NDim,TElem> const * const bodiesAcceleration,
+        types::Vector<NDim,TElem> const * const bodiesJerk,
+        types::Vector<NDim,TElem> * const startPosition,
+        types::Vector<NDim,TElem> * const startVelocity,
+        TSize const & numBodies,
+        TGrav const & gravitationalConstant,
+        TTime const & dt) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        TElem const h( static_cast<TElem>( dt ) );
+        TElem const g( static_cast<TElem>( gravitationalConstant ) );
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const position(
+                    bodies.getPosition( indexBody ) );
+            types::Vector<NDim,TElem> const velocity(
+                    bodiesVelocity[ indexBody ] );
+            types::Vector<NDim,TElem> const acceleration(
+                    g * bodiesAcceleration[ indexBody ] );
+            types::Vector<NDim,TElem> const jerk(
+                    g * bodiesJerk[ indexBody ] );
+
+            startPosition[ indexBody ] = position;
+            startVelocity[ indexBody ] = velocity;
+
+            bodies.setPosition( indexBody, position + h * ( velocity +
+                    ( h / static_cast<TElem>( 2 ) ) * ( acceleration +
+                    ( h / static_cast<TElem>( 3 ) ) * jerk ) ) );
+            bodiesVelocity[ indexBody ] = velocity + h * ( acceleration +
+                    ( h / static_cast<TElem>( 2 ) ) * jerk );
+        }
+    }
+};
+
+/** Class containing the Hermite Correct Kernel
+ *
+ * Combines the start of the step (0) and the forces at the
+ * predicted bodies (1) to
+ *
+ *     v = v_0 + ( a_0 + a_1 ) dt / 2 + ( j_0 - j_1 ) dt^2 / 12
+ *     x = x_0 + ( v_0 + v ) dt / 2 + ( a_0 - a_1 ) dt^2 / 12
+ */
+class HermiteCorrectKernel
+{
+public:
+    /** Hermite Correct Kernel
+     *
+     * @param bodies positions and masses of the bodies
+     * @param bodiesVelocity velocities of the bodies
+     * @param startPosition positions of the start
+     * @param startVelocity velocities of the start
+     * @param startAcceleration acceleration/G of the start
+     * @param startJerk jerk/G of the start
+     * @param endAcceleration acceleration/G of the prediction
+     * @param endJerk jerk/G of the prediction
+     * @param numBodies number of bodies
+     * @param gravitationalConstant gravitational constant
+     * @param dt length of the step
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesVelocity,
+        types::Vector<NDim,TElem> const * const startPosition,
+        types::Vector<NDim,TElem> const * const startVelocity,
+        types::Vector<NDim,TElem> const * const startAcceleration,
+        types::Vector<NDim,TElem> const * const startJerk,
+        types::Vector<NDim,TElem> const * const endAcceleration,
+        types::Vector<NDim,TElem> const * const endJerk,
+        TSize const & numBodies,
+        TGrav const & gravitationalConstant,
+        TTime const & dt) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        TElem const h( static_cast<TElem>( dt ) );
+        TElem const g( static_cast<TElem>( gravitationalConstant ) );
+        TElem const halfH( h / static_cast<TElem>( 2 ) );
+        TElem const hSqTwelfth( h * h / static_cast<TElem>( 12 ) );
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const velocityStart(
+                    startVelocity[ indexBody ] );
+            types::Vector<NDim,TElem> const accelerationStart(
+                    g * startAcceleration[ indexBody ] );
+            types::Vector<NDim,TElem> const accelerationEnd(
+                    g * endAcceleration[ indexBody ] );
+
+            types::Vector<NDim,TElem> const velocity( velocityStart +
+                    halfH * ( accelerationStart + accelerationEnd ) +
+                    ( g * hSqTwelfth ) *
+                    ( startJerk[ indexBody ] - endJerk[ indexBody ] ) );
+
+            bodies.setPosition( indexBody, startPosition[ indexBody ] +
+                    halfH * ( velocityStart + velocity ) +
+                    hSqTwelfth * ( accelerationStart - accelerationEnd ) );
+            bodiesVelocity[ indexBody ] = velocity;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
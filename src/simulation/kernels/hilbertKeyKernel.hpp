@@ -0,0 +1,162 @@
+/** Kernel for the calculation of Hilbert keys
+ *
+ * This file implements an Alpaka Kernel
+ * which maps the position of every body to
+ * its key on a Hilbert curve.
+ *
+ * @file hilbertKeyKernel.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+// morton::Key, morton::Depth
+#include <simulation/kernels/mortonKeyKernel.hpp>
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Hilbert Key Kernel
+ *
+ * Uses the same cells and the same key type as the
+ * MortonKeyKernel. Unlike the Morton curve, the Hilbert
+ * curve never jumps: bodies with consecutive keys are
+ * in neighbouring cells. The cell coordinates are
+ * transformed after Skilling (2004) and then interleaved
+ * like the Morton key.
+ */
+class HilbertKeyKernel
+{
+public:
+    /** Hilbert Key Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of position
+     * @param acc the accelerator
+     * @param bodiesPosition array of the bodies' position
+     * @param boxMin minimum of all positions
+     * @param boxMax maximum of all positions
+     * @param numBodies number of bodies
+     * @param keys array for the keys
+     * @param indices array which is set to 0, 1, ..., numBodies-1
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        types::Vector<NDim,TElem> const * const boxMin,
+        types::Vector<NDim,TElem> const * const boxMax,
+        TSize const & numBodies,
+        morton::Key * const keys,
+        TSize * const indices) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const depth( morton::Depth<NDim>::value );
+        morton::Key const cellsPerDim( morton::Key(1) << depth );
+        morton::Key const highest( morton::Key(1) << ( depth - 1 ) );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        // edge length of the cube
+        TElem boxSize( 0 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            TElem const extent( (*boxMax)[ d ] - (*boxMin)[ d ] );
+            if( boxSize < extent )
+                boxSize = extent;
+        }
+        TElem const scale( ( boxSize > static_cast<TElem>(0) ) ?
+                static_cast<TElem>( cellsPerDim ) / boxSize :
+                static_cast<TElem>( 0 ) );
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            morton::Key cell[ NDim ];
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TElem const scaled(
+                        ( bodiesPosition[ indexBody ][ d ] -
+                          (*boxMin)[ d ] ) * scale );
+                cell[ d ] = ( scaled > static_cast<TElem>(0) ) ?
+                    static_cast<morton::Key>( scaled ) : 0;
+                // The maximum lies on the upper border of the cube
+                if( cell[ d ] >= cellsPerDim )
+                    cell[ d ] = cellsPerDim - 1;
+            }
+
+            // Undo the excess work of the reflections and rotations
+            for( morton::Key q( highest ); q > 1; q >>= 1 )
+            {
+                morton::Key const lower( q - 1 );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    if( cell[ d ] & q )
+                        cell[ 0 ] ^= lower;
+                    else
+                    {
+                        morton::Key const swap(
+                                ( cell[ 0 ] ^ cell[ d ] ) & lower );
+                        cell[ 0 ] ^= swap;
+                        cell[ d ] ^= swap;
+                    }
+                }
+            }
+
+            // Gray code
+            for( std::size_t d( 1 ); d < NDim; d++ )
+                cell[ d ] ^= cell[ d - 1 ];
+            morton::Key flip( 0 );
+            for( morton::Key q( highest ); q > 1; q >>= 1 )
+                if( cell[ NDim - 1 ] & q )
+                    flip ^= q - 1;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                cell[ d ] ^= flip;
+
+            morton::Key key( 0 );
+            for( std::size_t level( 0 ); level < depth; level++ )
+            {
+                std::size_t const bit( depth - 1 - level );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    key = ( key << 1 ) | ( ( cell[ d ] >> bit ) & 1u );
+                }
+            }
+
+            keys[ indexBody ] = key;
+            indices[ indexBody ] = indexBody;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
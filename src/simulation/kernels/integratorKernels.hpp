@@ -0,0 +1,149 @@
+/** Kernels of the symplectic integrators
+ *
+ * This file implements the two Alpaka Kernels the
+ * symplectic integrators are composed of: the kick
+ * changes the velocities by the accelerations, the
+ * drift moves the bodies with their velocities.
+ *
+ * @file integratorKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Kick Kernel
+ *
+ * v += G * a * h
+ */
+class KickKernel
+{
+public:
+    /** Kick Kernel
+     *
+     * @param accelerations acceleration/G of body i in the first
+     *        element of row i, like the UpdatePositionsKernel reads it
+     * @param pitchBytesAccelerations bytes between two rows
+     * @param bodiesVelocity velocities of the bodies
+     * @param numBodies number of bodies
+     * @param gravitationalConstant gravitational constant
+     * @param h length of the kick
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const accelerations,
+        TSize const & pitchBytesAccelerations,
+        types::Vector<NDim,TElem> * const bodiesVelocity,
+        TSize const & numBodies,
+        TGrav const & gravitationalConstant,
+        TTime const & h) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const acceleration(
+                    *(types::Vector<NDim,TElem> const *)(
+                        (char const *)accelerations +
+                        indexBody * pitchBytesAccelerations ) );
+            bodiesVelocity[ indexBody ] +=
+                ( static_cast<TElem>( gravitationalConstant ) *
+                  static_cast<TElem>( h ) ) * acceleration;
+        }
+    }
+};
+
+/** Class containing the Drift Kernel
+ *
+ * x += v * h
+ */
+class DriftKernel
+{
+public:
+    /** Drift Kernel
+     *
+     * @param bodies positions and masses of the bodies
+     * @param bodiesVelocity velocities of the bodies
+     * @param numBodies number of bodies
+     * @param h length of the drift
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TTime>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> const * const bodiesVelocity,
+        TSize const & numBodies,
+        TTime const & h) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            bodies.setPosition( indexBody,
+                bodies.getPosition( indexBody ) +
+                static_cast<TElem>( h ) * bodiesVelocity[ indexBody ] );
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
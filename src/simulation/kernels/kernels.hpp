@@ -9,5 +9,33 @@
  * @date Tuesday, 15. December 2015 11:05
  */
 
+#include "forceLaws.hpp"
 #include "forceMatrixKernel.hpp"
+#include "accelerationKernel.hpp"
+#include "sourcesSinksKernel.hpp"
+#include "mixedAccelerationKernel.hpp"
+#include "reduceKernel.hpp"
+#include "tiledAccelerationKernel.hpp"
+#include "simdAccelerationKernel.hpp"
+#include "symmetricKernels.hpp"
+#include "mortonKeyKernel.hpp"
+#include "hilbertKeyKernel.hpp"
+#include "reorderKernels.hpp"
+#include "radixSortKernels.hpp"
+#include "scanKernel.hpp"
+#include "gatherKernel.hpp"
+#include "treeKernels.hpp"
+#include "treeWalkKernel.hpp"
+#include "fmmKernels.hpp"
+#include "pmKernels.hpp"
+#include "cellListKernels.hpp"
+#include "p3mKernels.hpp"
+#include "shortRangeKernels.hpp"
+#include "unpackKernel.hpp"
 #include "updatePositionsKernel.hpp"
+#include "integratorKernels.hpp"
+#include "hermiteKernels.hpp"
+#include "blockStepKernels.hpp"
+#include "timestepKernel.hpp"
+#include "ensembleKernels.hpp"
+#include "ringKernels.hpp"
@@ -0,0 +1,383 @@
+/** Kernel for accelerations in mixed precision
+ *
+ * This file implements an Alpaka Kernel which evaluates
+ * the interactions in a cheaper datatype than the bodies
+ * are stored in and sums them up with an accumulator
+ * which loses less precision than a plain sum.
+ *
+ * @file mixedAccelerationKernel.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace accumulate {
+
+/** Accumulators for the MixedAccelerationKernel
+ *
+ * Every accumulator has a class template Sum<NDim,TElem>
+ * with add( term ) and get(), where get() returns the sum
+ * in TElem, the datatype of the bodies.
+ */
+
+/** Plain sum in TElem, like the AccelerationKernel */
+struct Plain
+{
+    template<
+        std::size_t NDim,
+        typename TElem>
+    class Sum
+    {
+    private:
+        types::Vector<NDim,TElem> sum;
+    public:
+        ALPAKA_FN_HOST_ACC Sum() :
+            sum( static_cast<TElem>( 0 ) )
+        {}
+
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TTerm>
+        ALPAKA_FN_HOST_ACC auto add(
+            types::Vector<NDim,TTerm> const & term)
+        -> void
+        {
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                sum[ d ] += static_cast<TElem>( term[ d ] );
+        }
+
+        ALPAKA_FN_HOST_ACC auto get() const
+        -> types::Vector<NDim,TElem>
+        {
+            return sum;
+        }
+    };
+};
+
+/** Sum in a wider datatype
+ *
+ * @tparam TAccumElem datatype of the sum, e.g. double
+ */
+template<
+    typename TAccumElem>
+struct Wide
+{
+    template<
+        std::size_t NDim,
+        typename TElem>
+    class Sum
+    {
+    private:
+        types::Vector<NDim,TAccumElem> sum;
+    public:
+        ALPAKA_FN_HOST_ACC Sum() :
+            sum( static_cast<TAccumElem>( 0 ) )
+        {}
+
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TTerm>
+        ALPAKA_FN_HOST_ACC auto add(
+            types::Vector<NDim,TTerm> const & term)
+        -> void
+        {
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                sum[ d ] += static_cast<TAccumElem>( term[ d ] );
+        }
+
+        ALPAKA_FN_HOST_ACC auto get() const
+        -> types::Vector<NDim,TElem>
+        {
+            types::Vector<NDim,TElem> result;
+            result = sum;
+            return result;
+        }
+    };
+};
+
+/** Compensated sum in TElem
+ *
+ * Neumaier's variant of the Kahan summation: the rounding
+ * error of every addition is collected in a second sum, so
+ * the error does not grow with the number of terms. It must
+ * not be compiled with -ffast-math or similar flags, which
+ * allow the compiler to cancel the compensation.
+ */
+struct Compensated
+{
+    template<
+        std::size_t NDim,
+        typename TElem>
+    class Sum
+    {
+    private:
+        types::Vector<NDim,TElem> sum;
+        types::Vector<NDim,TElem> compensation;
+    public:
+        ALPAKA_FN_HOST_ACC Sum() :
+            sum( static_cast<TElem>( 0 ) ),
+            compensation( static_cast<TElem>( 0 ) )
+        {}
+
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TTerm>
+        ALPAKA_FN_HOST_ACC auto add(
+            types::Vector<NDim,TTerm> const & term)
+        -> void
+        {
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TElem const value( static_cast<TElem>( term[ d ] ) );
+                TElem const total( sum[ d ] + value );
+                TElem const absSum( sum[ d ] < 0 ? -sum[ d ] : sum[ d ] );
+                TElem const absValue( value < 0 ? -value : value );
+                // the low order bits of the smaller one are lost
+                if( absSum >= absValue )
+                    compensation[ d ] += ( sum[ d ] - total ) + value;
+                else
+                    compensation[ d ] += ( value - total ) + sum[ d ];
+                sum[ d ] = total;
+            }
+        }
+
+        ALPAKA_FN_HOST_ACC auto get() const
+        -> types::Vector<NDim,TElem>
+        {
+            return sum + compensation;
+        }
+    };
+};
+
+} // namespace accumulate
+
+/** Class containing the Mixed Centres Kernel
+ *
+ * The bodies are split into groups of groupSize consecutive
+ * bodies. Every thread handles one group: it stores the mean
+ * position of the group in TElem as its centre and the
+ * position of every body of the group relative to the centre,
+ * rounded to TPairElem. The offsets are small compared to
+ * the positions, so they keep the precision of TElem even
+ * far from the origin, as long as the bodies of a group are
+ * close to each other, e.g. after sorting them along a
+ * space filling curve.
+ *
+ * @tparam TPairElem datatype of the offsets and masses
+ */
+template<
+    typename TPairElem>
+class MixedCentresKernel
+{
+public:
+    /** Mixed Centres Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout storage layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param numBodies number of bodies
+     * @param groupSize bodies per group
+     * @param centres centre of every group
+     * @param offsets position of every body relative to
+     *        the centre of its group
+     * @param masses mass of every body
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        TSize const & numBodies,
+        TSize const & groupSize,
+        types::Vector<NDim,TElem> * const centres,
+        types::Vector<NDim,TPairElem> * const offsets,
+        TPairElem * const masses ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        TSize const numGroups( ( numBodies + groupSize - 1 ) / groupSize );
+
+        for( TSize threadGroup = 0,
+            indexGroup = gridThreadIdx * threadElemExtent;
+            threadGroup < threadElemExtent &&
+            indexGroup < numGroups;
+            threadGroup++,
+            indexGroup++)
+        {
+            TSize const begin( indexGroup * groupSize );
+            TSize const end( begin + groupSize < numBodies ?
+                    begin + groupSize : numBodies );
+
+            types::Vector<NDim,TElem> centre( static_cast<TElem>( 0 ) );
+            for( TSize i( begin ); i < end; i++ )
+                centre += bodies.getPosition( i );
+            centre = centre / static_cast<TElem>( end - begin );
+            centres[ indexGroup ] = centre;
+
+            for( TSize i( begin ); i < end; i++ )
+            {
+                offsets[ i ] = bodies.getPosition( i ) - centre;
+                masses[ i ] = static_cast<TPairElem>( bodies.getMass( i ) );
+            }
+        }
+    }
+};
+
+/** Class containing the Mixed Acceleration Kernel
+ *
+ * Like the AccelerationKernel, but the interactions are
+ * evaluated in TPairElem on the offsets of the
+ * MixedCentresKernel. The difference of the centres of
+ * two groups is subtracted in TElem and rounded to
+ * TPairElem once per group of influencing bodies, the
+ * loop over the bodies of the group only adds offsets in
+ * TPairElem. The interactions are summed up by the
+ * accumulator TAccumulate.
+ *
+ * @tparam TPairElem datatype of the interactions
+ * @tparam TAccumulate accumulator, see namespace accumulate
+ * @tparam TForceLaw interaction of two bodies, see forceLaws,
+ *         evaluated in TPairElem
+ */
+template<
+    typename TPairElem,
+    typename TAccumulate,
+    typename TForceLaw = forceLaws::Plummer>
+class MixedAccelerationKernel
+{
+public:
+    /** Mixed Acceleration Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param centres centre of every group
+     * @param offsets position of every body relative to
+     *        the centre of its group
+     * @param masses mass of every body
+     * @param groupSize bodies per group
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const centres,
+        types::Vector<NDim,TPairElem> const * const offsets,
+        TPairElem const * const masses,
+        TSize const & groupSize,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        TPairElem const smoothness( static_cast<TPairElem>( smoothnessFactor ) );
+
+        for( TSize threadBodyInfluenced = 0,
+            indexBodyInfluenced = gridThreadIdx * threadElemExtent;
+            threadBodyInfluenced < threadElemExtent &&
+            indexBodyInfluenced < numBodies;
+            threadBodyInfluenced++,
+            indexBodyInfluenced++)
+        {
+            types::Vector<NDim,TElem> const centreInfluenced(
+                    centres[ indexBodyInfluenced / groupSize ] );
+            types::Vector<NDim,TPairElem> const offsetInfluenced(
+                    offsets[ indexBodyInfluenced ] );
+
+            typename TAccumulate::template Sum<NDim,TElem> acceleration;
+
+            for( TSize groupBegin = 0, indexGroup = 0;
+                 groupBegin < numBodies;
+                 groupBegin += groupSize, indexGroup++)
+            {
+                // offset of the group, subtracted in TElem
+                types::Vector<NDim,TPairElem> groupRelative;
+                groupRelative = centres[ indexGroup ] - centreInfluenced;
+                groupRelative -= offsetInfluenced;
+
+                TSize const groupEnd( groupBegin + groupSize < numBodies ?
+                        groupBegin + groupSize : numBodies );
+
+                for( TSize indexBodyInfluencing = groupBegin;
+                     indexBodyInfluencing < groupEnd;
+                     indexBodyInfluencing++)
+                {
+                    if( indexBodyInfluencing == indexBodyInfluenced )
+                        continue;
+
+                    types::Vector<NDim,TPairElem> const positionRelative(
+                            offsets[ indexBodyInfluencing ] +
+                            groupRelative );
+
+                    acceleration.add( TForceLaw::interaction(
+                            acc,
+                            positionRelative,
+                            masses[ indexBodyInfluencing ],
+                            smoothness ) );
+                }
+            }
+
+            bodiesAcceleration[ indexBodyInfluenced ] = acceleration.get();
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
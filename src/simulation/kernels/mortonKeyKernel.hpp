@@ -0,0 +1,157 @@
+/** Kernel for the calculation of Morton keys
+ *
+ * This file implements an Alpaka Kernel
+ * which maps the position of every body to
+ * its key on a Morton (Z-order) curve.
+ *
+ * @file mortonKeyKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <cstdint> // std::uint64_t
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace morton {
+
+/** Type of the Morton keys */
+using Key = std::uint64_t;
+
+/** Number of levels which fit into a key
+ *
+ * Every level adds one bit per dimension
+ */
+template<
+    std::size_t NDim>
+struct Depth
+{
+    static_assert( NDim > 0 && NDim < 64 , "Keys have 63 usable bits." );
+    std::size_t const static value = 63 / NDim;
+};
+
+/** Number of significant bits of a key */
+template<
+    std::size_t NDim>
+struct Bits
+{
+    std::size_t const static value = NDim * Depth<NDim>::value;
+};
+
+} // namespace morton
+
+/** Class containing the Morton Key Kernel
+ *
+ * The cube which contains all bodies is divided in
+ * 2^Depth cells per dimension. The key of a body
+ * interleaves the bits of its cell coordinates,
+ * most significant level first.
+ */
+class MortonKeyKernel
+{
+public:
+    /** Morton Key Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of position
+     * @param acc the accelerator
+     * @param bodiesPosition array of the bodies' position
+     * @param boxMin minimum of all positions
+     * @param boxMax maximum of all positions
+     * @param numBodies number of bodies
+     * @param keys array for the keys
+     * @param indices array which is set to 0, 1, ..., numBodies-1
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        types::Vector<NDim,TElem> const * const boxMin,
+        types::Vector<NDim,TElem> const * const boxMax,
+        TSize const & numBodies,
+        morton::Key * const keys,
+        TSize * const indices) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const depth( morton::Depth<NDim>::value );
+        morton::Key const cellsPerDim( morton::Key(1) << depth );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        // edge length of the cube
+        TElem boxSize( 0 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            TElem const extent( (*boxMax)[ d ] - (*boxMin)[ d ] );
+            if( boxSize < extent )
+                boxSize = extent;
+        }
+        TElem const scale( ( boxSize > static_cast<TElem>(0) ) ?
+                static_cast<TElem>( cellsPerDim ) / boxSize :
+                static_cast<TElem>( 0 ) );
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            morton::Key cell[ NDim ];
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TElem const scaled(
+                        ( bodiesPosition[ indexBody ][ d ] -
+                          (*boxMin)[ d ] ) * scale );
+                cell[ d ] = ( scaled > static_cast<TElem>(0) ) ?
+                    static_cast<morton::Key>( scaled ) : 0;
+                // The maximum lies on the upper border of the cube
+                if( cell[ d ] >= cellsPerDim )
+                    cell[ d ] = cellsPerDim - 1;
+            }
+
+            morton::Key key( 0 );
+            for( std::size_t level( 0 ); level < depth; level++ )
+            {
+                std::size_t const bit( depth - 1 - level );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    key = ( key << 1 ) | ( ( cell[ d ] >> bit ) & 1u );
+                }
+            }
+
+            keys[ indexBody ] = key;
+            indices[ indexBody ] = indexBody;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
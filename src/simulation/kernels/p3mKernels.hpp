@@ -0,0 +1,169 @@
+/** Kernel for the short range forces of P3M
+ *
+ * This file implements the Alpaka Kernel which adds the
+ * short range part of the forces, which the mesh leaves
+ * out, with a direct summation over the neighbouring
+ * cells of a cell list.
+ *
+ * @file p3mKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <cstdint> // std::int64_t
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+// cells::Geometry
+#include <simulation/kernels/cellListKernels.hpp>
+// ForceMatrixKernel::interaction
+#include <simulation/kernels/forceMatrixKernel.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the P3M Short Range Kernel
+ *
+ * The mesh with split radius r_s contains the forces of the
+ * potential erf(r / 2 r_s) / r. The rest is the force of the
+ * ForceMatrixKernel times
+ * erfc(r / 2 r_s) + r / ( r_s sqrt(pi) ) exp(-r^2 / 4 r_s^2),
+ * which is summed up for all pairs closer than the cutoff.
+ * Periodic cells use the nearest image of every pair.
+ *
+ * The bodies are processed in the order of the cell list,
+ * the accelerations are added in the original order.
+ *
+ * @tparam TPeriodic periodic cells
+ */
+template<
+    bool TPeriodic>
+class P3mShortRangeKernel
+{
+public:
+    /** P3M Short Range Kernel
+     *
+     * @param geometry placement of the cells
+     * @param keys cell of every sorted body
+     * @param cellBegin first sorted body of every cell
+     * @param cellEnd behind the last sorted body of every cell
+     * @param bodiesPosition sorted positions
+     * @param bodiesMass sorted masses
+     * @param permutation original index of every sorted body
+     * @param numBodies number of bodies
+     * @param splitRadius split radius r_s
+     * @param cutoff largest distance of a pair
+     * @param smoothnessFactor Smoothness Factor
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        cells::Geometry<NDim,TElem,TSize> const & geometry,
+        TSize const * const keys,
+        TSize const * const cellBegin,
+        TSize const * const cellEnd,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const * const permutation,
+        TSize const & numBodies,
+        TElem const & splitRadius,
+        TElem const & cutoff,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const pi( 3.14159265358979323846 );
+        TElem const cutoffSq( cutoff * cutoff );
+        TElem const rsplit2( static_cast<TElem>( 0.5 ) / splitRadius );
+        TElem const gaussFactor( alpaka::math::rsqrt( acc, pi ) / splitRadius );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodiesPosition[ indexBody ] );
+
+            cells::Neighbourhood<TPeriodic,NDim,TElem,TSize> const
+                neighbourhood( geometry, keys[ indexBody ] );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( std::size_t neighbour( 0 );
+                 neighbour < neighbourhood.size();
+                 neighbour++ )
+            {
+                TSize indexCell;
+                if( !neighbourhood.cell( neighbour, indexCell ) )
+                    continue;
+
+                for( TSize indexBodyInfluencing( cellBegin[ indexCell ] );
+                     indexBodyInfluencing < cellEnd[ indexCell ];
+                     indexBodyInfluencing++ )
+                {
+                    if( indexBodyInfluencing == indexBody )
+                        continue;
+
+                    types::Vector<NDim,TElem> bodyRelative(
+                            bodiesPosition[ indexBodyInfluencing ] -
+                            positionInfluenced );
+                    cells::nearestImage<TPeriodic>(
+                            acc, geometry, bodyRelative );
+
+                    TElem const distSq( bodyRelative.absSq() );
+                    if( distSq >= cutoffSq )
+                        continue;
+
+                    TElem const dist( alpaka::math::sqrt( acc, distSq ) );
+                    TElem const shortRange(
+                            static_cast<TElem>( 1 ) -
+                            alpaka::math::erf( acc, dist * rsplit2 ) +
+                            dist * gaussFactor * alpaka::math::exp(
+                                acc, -distSq * rsplit2 * rsplit2 ) );
+
+                    acceleration += shortRange *
+                        ForceMatrixKernel::interaction(
+                            acc,
+                            bodyRelative,
+                            bodiesMass[ indexBodyInfluencing ],
+                            smoothnessFactor );
+                }
+            }
+
+            bodiesAcceleration[ permutation[ indexBody ] ] += acceleration;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,745 @@
+/** Kernels of the particle mesh method
+ *
+ * This file implements the Alpaka Kernels of the particle
+ * mesh solver: the assignment of the masses to a grid, a
+ * radix-2 FFT, the Green's function of the softened
+ * potential (|r|^2 + smoothnessFactor)^(-1/2) and the
+ * interpolation of the accelerations back to the bodies.
+ * Complex numbers are stored as Vector<2> ( real, imaginary ).
+ *
+ * @file pmKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <cstdint> // std::int64_t
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace pm {
+
+template<
+    typename TElem>
+using Complex = types::Vector<2,TElem>;
+
+/** Placement of the grid
+ *
+ * Grid point i of the grid lies at origin + i * cellSize.
+ */
+template<
+    std::size_t NDim,
+    typename TElem>
+struct Grid
+{
+    types::Vector<NDim,TElem> origin;
+    TElem cellSize;
+};
+
+/** Nearest grid point assignment
+ *
+ * The whole mass goes to the nearest grid point.
+ */
+struct Ngp
+{
+    static constexpr std::size_t support = 1;
+
+    /** Weights of one dimension
+     *
+     * @param x position in units of the cell size
+     * @param first first grid point of the support
+     * @param weights weights of the support grid points
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem>
+    ALPAKA_FN_ACC static auto weights(
+        TAcc const & acc,
+        TElem const x,
+        std::int64_t & first,
+        TElem * const weights)
+    -> void
+    {
+        first = static_cast<std::int64_t>( alpaka::math::floor(
+                    acc, x + static_cast<TElem>( 0.5 ) ) );
+        weights[ 0 ] = static_cast<TElem>( 1 );
+    }
+};
+
+/** Cloud in cell assignment
+ *
+ * The mass is shared linearly between the two
+ * neighbouring grid points of every dimension.
+ */
+struct Cic
+{
+    static constexpr std::size_t support = 2;
+
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem>
+    ALPAKA_FN_ACC static auto weights(
+        TAcc const & acc,
+        TElem const x,
+        std::int64_t & first,
+        TElem * const weights)
+    -> void
+    {
+        TElem const lower( alpaka::math::floor( acc, x ) );
+        TElem const fraction( x - lower );
+        first = static_cast<std::int64_t>( lower );
+        weights[ 0 ] = static_cast<TElem>( 1 ) - fraction;
+        weights[ 1 ] = fraction;
+    }
+};
+
+/** Triangular shaped cloud assignment
+ *
+ * The mass is shared quadratically between the nearest
+ * grid point and its two neighbours of every dimension.
+ */
+struct Tsc
+{
+    static constexpr std::size_t support = 3;
+
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem>
+    ALPAKA_FN_ACC static auto weights(
+        TAcc const & acc,
+        TElem const x,
+        std::int64_t & first,
+        TElem * const weights)
+    -> void
+    {
+        TElem const nearest( alpaka::math::floor(
+                    acc, x + static_cast<TElem>( 0.5 ) ) );
+        TElem const d( x - nearest );
+        TElem const half( 0.5 );
+        first = static_cast<std::int64_t>( nearest ) - 1;
+        weights[ 0 ] = half * ( half - d ) * ( half - d );
+        weights[ 1 ] = static_cast<TElem>( 0.75 ) - d * d;
+        weights[ 2 ] = half * ( half + d ) * ( half + d );
+    }
+};
+
+// grid points between the bodies and the border of an
+// isolated grid, enough for the TSC support and the gradient
+std::size_t const margin = 2;
+
+} // namespace pm
+
+/** Class containing the PM Grid Kernel
+ *
+ * Places an isolated grid of gridSize^NDim cubic cells
+ * around the bounding box of the bodies, keeping
+ * pm::margin grid points free on every side.
+ * Has to be started with a single thread.
+ */
+class PmGridKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const &,
+        types::Vector<NDim,TElem> const * const boxMin,
+        types::Vector<NDim,TElem> const * const boxMax,
+        TSize const & gridSize,
+        pm::Grid<NDim,TElem> * const grid) const
+    -> void
+    {
+        TElem boxSize( 0 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            TElem const extent( (*boxMax)[ d ] - (*boxMin)[ d ] );
+            if( boxSize < extent )
+                boxSize = extent;
+        }
+        // a single body still needs a valid cell size
+        if( boxSize == static_cast<TElem>( 0 ) )
+            boxSize = static_cast<TElem>( 1 );
+
+        TElem const cellSize( boxSize /
+                static_cast<TElem>( gridSize - 1 - 2 * pm::margin ) );
+        grid->cellSize = cellSize;
+        grid->origin = *boxMin -
+            types::Vector<NDim,TElem>(
+                    static_cast<TElem>( pm::margin ) * cellSize );
+    }
+};
+
+/** Class containing the PM Clear Kernel
+ *
+ * Sets numElements complex numbers to zero.
+ */
+class PmClearKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const & numElements,
+        pm::Complex<TElem> * const data) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadElem = 0,
+            index = gridThreadIdx * threadElemExtent;
+            threadElem < threadElemExtent &&
+            index < numElements;
+            threadElem++,
+            index++)
+        {
+            data[ index ] = pm::Complex<TElem>( static_cast<TElem>( 0 ) );
+        }
+    }
+};
+
+/** Class containing the PM Assign Kernel
+ *
+ * Adds the masses of the bodies to the real part of the
+ * grid points of their support with atomic operations.
+ * The grid has length points per dimension, the first
+ * gridSize of them cover the bodies.
+ *
+ * @tparam TAssignment pm::Ngp, pm::Cic or pm::Tsc
+ * @tparam TPeriodic wrap the grid points around
+ */
+template<
+    typename TAssignment,
+    bool TPeriodic>
+class PmAssignKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        pm::Grid<NDim,TElem> const * const grid,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const & numBodies,
+        TSize const & gridSize,
+        TSize const & length,
+        pm::Complex<TElem> * const density) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const support( TAssignment::support );
+        std::size_t numStencil( 1 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            numStencil *= support;
+
+        std::int64_t const n( static_cast<std::int64_t>( gridSize ) );
+        TElem const rcellSize( static_cast<TElem>( 1 ) / grid->cellSize );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            std::int64_t first[ NDim ];
+            TElem weights[ NDim ][ support ];
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TAssignment::weights(
+                        acc,
+                        ( bodiesPosition[ indexBody ][ d ] -
+                          grid->origin[ d ] ) * rcellSize,
+                        first[ d ],
+                        weights[ d ] );
+            }
+
+            for( std::size_t s( 0 ); s < numStencil; s++ )
+            {
+                std::size_t rest( s );
+                TSize index( 0 );
+                TSize stride( 1 );
+                TElem weight( bodiesMass[ indexBody ] );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    std::size_t const offset( rest % support );
+                    rest /= support;
+
+                    std::int64_t point( first[ d ] +
+                            static_cast<std::int64_t>( offset ) );
+                    if( TPeriodic )
+                        point = ( ( point % n ) + n ) % n;
+
+                    index += static_cast<TSize>( point ) * stride;
+                    stride *= length;
+                    weight *= weights[ d ][ offset ];
+                }
+                alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(
+                        acc,
+                        &density[ index ][ 0 ],
+                        weight );
+            }
+        }
+    }
+};
+
+/** Class containing the PM FFT Kernel
+ *
+ * Every thread transforms one line of a grid with length
+ * points per dimension along one axis with the iterative
+ * radix-2 Cooley-Tukey algorithm. length has to be a power
+ * of two. The transformation is not normalized.
+ */
+class PmFftKernel
+{
+public:
+    /** PM FFT Kernel
+     *
+     * @param data complex grid
+     * @param length points per dimension
+     * @param stride distance of two points of a line,
+     *        length^axis
+     * @param numLines number of lines, length^(NDim-1)
+     * @param sign -1 forward, +1 backward transformation
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        pm::Complex<TElem> * const data,
+        TSize const & length,
+        TSize const & stride,
+        TSize const & numLines,
+        TElem const & sign) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const pi( 3.14159265358979323846 );
+
+        TSize numBits( 0 );
+        while( ( static_cast<TSize>( 1 ) << numBits ) < length )
+            numBits++;
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadLine = 0,
+            indexLine = gridThreadIdx * threadElemExtent;
+            threadLine < threadElemExtent &&
+            indexLine < numLines;
+            threadLine++,
+            indexLine++)
+        {
+            pm::Complex<TElem> * const line( data +
+                    ( indexLine / stride ) * stride * length +
+                    indexLine % stride );
+
+            // bit reversed order
+            for( TSize i( 0 ); i < length; i++ )
+            {
+                TSize j( 0 );
+                for( TSize bit( 0 ); bit < numBits; bit++ )
+                    j |= ( ( i >> bit ) & 1 ) << ( numBits - 1 - bit );
+                if( i < j )
+                {
+                    pm::Complex<TElem> const swap( line[ i * stride ] );
+                    line[ i * stride ] = line[ j * stride ];
+                    line[ j * stride ] = swap;
+                }
+            }
+
+            // butterflies
+            for( TSize size( 2 ); size <= length; size *= 2 )
+            {
+                TSize const half( size / 2 );
+                TElem const angle( sign * 2 * pi / static_cast<TElem>( size ) );
+                for( TSize k( 0 ); k < half; k++ )
+                {
+                    TElem const wRe( alpaka::math::cos(
+                                acc, angle * static_cast<TElem>( k ) ) );
+                    TElem const wIm( alpaka::math::sin(
+                                acc, angle * static_cast<TElem>( k ) ) );
+                    for( TSize start( 0 ); start < length; start += size )
+                    {
+                        pm::Complex<TElem> & a(
+                                line[ ( start + k ) * stride ] );
+                        pm::Complex<TElem> & b(
+                                line[ ( start + k + half ) * stride ] );
+                        pm::Complex<TElem> const u( a );
+                        pm::Complex<TElem> const v( {
+                                b[ 0 ] * wRe - b[ 1 ] * wIm,
+                                b[ 0 ] * wIm + b[ 1 ] * wRe } );
+                        a = u + v;
+                        b = u - v;
+                    }
+                }
+            }
+        }
+    }
+};
+
+/** Class containing the PM Green Kernel
+ *
+ * Isolated grids have length = 2 * gridSize points per
+ * dimension. The kernel stores the softened potential
+ * -(|r|^2 + smoothnessFactor)^(-1/2) of the nearest image
+ * of every grid point in real space, it has to be
+ * transformed afterwards. The grid point itself counts as
+ * half a cell away.
+ *
+ * Periodic grids have length = gridSize. The kernel stores
+ * the transformed potential of a unit mass -4 pi / k^2 in 3
+ * dimensions and -2 pi / |k| in 2 dimensions, divided by the
+ * cell volume, directly in Fourier space.
+ *
+ * With a split radius r_s > 0 only the long range part of the
+ * potential is stored, -erf(r / 2 r_s) / r in real space and
+ * the potential times exp(-k^2 r_s^2) in Fourier space. The
+ * short range part is left to a direct summation.
+ *
+ * @tparam TPeriodic periodic grid
+ */
+template<
+    bool TPeriodic>
+class PmGreenKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        pm::Grid<NDim,TElem> const * const grid,
+        TSize const & gridSize,
+        TSize const & length,
+        TFactor const & smoothnessFactor,
+        TElem const & splitRadius,
+        pm::Complex<TElem> * const green) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const pi( 3.14159265358979323846 );
+        TElem const cellSize( grid->cellSize );
+        // the split radius is given in cells
+        TElem const split( splitRadius * cellSize );
+
+        TSize numElements( 1 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            numElements *= length;
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadElem = 0,
+            index = gridThreadIdx * threadElemExtent;
+            threadElem < threadElemExtent &&
+            index < numElements;
+            threadElem++,
+            index++)
+        {
+            TElem value( 0 );
+            TElem distSq( 0 );
+            TSize rest( index );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TSize const point( rest % length );
+                rest /= length;
+
+                // nearest image, for the periodic grid the
+                // frequency in units of 2 pi / ( gridSize * cellSize )
+                TSize const half( TPeriodic ? length / 2 : gridSize );
+                TElem const offset( point <= half ?
+                        static_cast<TElem>( point ) :
+                        static_cast<TElem>( point ) -
+                            static_cast<TElem>( length ) );
+                distSq += offset * offset;
+            }
+
+            if( TPeriodic )
+            {
+                if( distSq > static_cast<TElem>( 0 ) )
+                {
+                    TElem const k( 2 * pi /
+                            ( static_cast<TElem>( gridSize ) * cellSize ) *
+                            alpaka::math::sqrt( acc, distSq ) );
+                    TElem volume( 1 );
+                    for( std::size_t d( 0 ); d < NDim; d++ )
+                        volume *= cellSize;
+                    value = ( NDim == 2 ) ?
+                        -2 * pi / ( k * volume ) :
+                        -4 * pi / ( k * k * volume );
+                    if( split > static_cast<TElem>( 0 ) )
+                        value *= alpaka::math::exp(
+                                acc, -k * k * split * split );
+                }
+            }
+            else if( split > static_cast<TElem>( 0 ) )
+            {
+                TElem const dist( alpaka::math::sqrt( acc,
+                            distSq * cellSize * cellSize + smoothnessFactor ) );
+                // the limit of erf(r / 2 r_s) / r for r -> 0
+                value = ( dist > static_cast<TElem>( 0 ) ) ?
+                    -alpaka::math::erf( acc, dist / ( 2 * split ) ) / dist :
+                    -alpaka::math::rsqrt( acc, pi ) / split;
+            }
+            else
+            {
+                TElem dist( distSq * cellSize * cellSize + smoothnessFactor );
+                if( distSq == static_cast<TElem>( 0 ) )
+                    dist += static_cast<TElem>( 0.25 ) * cellSize * cellSize;
+                value = -alpaka::math::rsqrt( acc, dist );
+            }
+
+            green[ index ] = pm::Complex<TElem>( {
+                    value,
+                    static_cast<TElem>( 0 ) } );
+        }
+    }
+};
+
+/** Class containing the PM Convolve Kernel
+ *
+ * Multiplies the transformed density with the transformed
+ * Green's function and by the normalization of the
+ * backward transformation.
+ */
+class PmConvolveKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        pm::Complex<TElem> const * const green,
+        TSize const & numElements,
+        pm::Complex<TElem> * const density) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const normalization( static_cast<TElem>( 1 ) /
+                static_cast<TElem>( numElements ) );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadElem = 0,
+            index = gridThreadIdx * threadElemExtent;
+            threadElem < threadElemExtent &&
+            index < numElements;
+            threadElem++,
+            index++)
+        {
+            pm::Complex<TElem> const a( density[ index ] );
+            pm::Complex<TElem> const b( green[ index ] );
+            density[ index ] = normalization * pm::Complex<TElem>( {
+                    a[ 0 ] * b[ 0 ] - a[ 1 ] * b[ 1 ],
+                    a[ 0 ] * b[ 1 ] + a[ 1 ] * b[ 0 ] } );
+        }
+    }
+};
+
+/** Class containing the PM Interpolate Kernel
+ *
+ * Calculates the accelerations -grad(phi) on the grid
+ * points of the support of every body with central
+ * differences of the potential and interpolates them with
+ * the weights of the assignment. Using the same weights as
+ * the assignment avoids self forces.
+ * Like in the ForceMatrixKernel the gravitationalConstant
+ * is not applied here.
+ *
+ * @tparam TAssignment pm::Ngp, pm::Cic or pm::Tsc
+ * @tparam TPeriodic wrap the grid points around
+ */
+template<
+    typename TAssignment,
+    bool TPeriodic>
+class PmInterpolateKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        pm::Grid<NDim,TElem> const * const grid,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TSize const & numBodies,
+        TSize const & gridSize,
+        TSize const & length,
+        pm::Complex<TElem> const * const potential,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const support( TAssignment::support );
+        std::size_t numStencil( 1 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            numStencil *= support;
+
+        std::int64_t const n( static_cast<std::int64_t>( gridSize ) );
+        TElem const rcellSize( static_cast<TElem>( 1 ) / grid->cellSize );
+        TElem const factor( static_cast<TElem>( -0.5 ) * rcellSize );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            std::int64_t first[ NDim ];
+            TElem weights[ NDim ][ support ];
+            for( std::size_t d( 0 ); d < NDim; d++ )
+            {
+                TAssignment::weights(
+                        acc,
+                        ( bodiesPosition[ indexBody ][ d ] -
+                          grid->origin[ d ] ) * rcellSize,
+                        first[ d ],
+                        weights[ d ] );
+            }
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( std::size_t s( 0 ); s < numStencil; s++ )
+            {
+                std::size_t rest( s );
+                std::int64_t point[ NDim ];
+                TElem weight( 1 );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                {
+                    std::size_t const offset( rest % support );
+                    rest /= support;
+                    point[ d ] = first[ d ] + static_cast<std::int64_t>( offset );
+                    weight *= weights[ d ][ offset ];
+                }
+
+                for( std::size_t axis( 0 ); axis < NDim; axis++ )
+                {
+                    // indices of the neighbours along the axis
+                    TSize indexPlus( 0 );
+                    TSize indexMinus( 0 );
+                    TSize stride( 1 );
+                    for( std::size_t d( 0 ); d < NDim; d++ )
+                    {
+                        std::int64_t plus( point[ d ] );
+                        std::int64_t minus( point[ d ] );
+                        if( d == axis )
+                        {
+                            plus++;
+                            minus--;
+                        }
+                        if( TPeriodic )
+                        {
+                            plus = ( ( plus % n ) + n ) % n;
+                            minus = ( ( minus % n ) + n ) % n;
+                        }
+                        indexPlus += static_cast<TSize>( plus ) * stride;
+                        indexMinus += static_cast<TSize>( minus ) * stride;
+                        stride *= length;
+                    }
+
+                    acceleration[ axis ] += weight * factor *
+                        ( potential[ indexPlus ][ 0 ] -
+                          potential[ indexMinus ][ 0 ] );
+                }
+            }
+
+            bodiesAcceleration[ indexBody ] = acceleration;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
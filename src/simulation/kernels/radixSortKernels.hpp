@@ -0,0 +1,177 @@
+/** Kernels for a radix sort
+ *
+ * This file implements the Alpaka Kernels
+ * of one pass of a stable least significant
+ * digit radix sort of key-value pairs.
+ *
+ * Every thread owns a contiguous chunk of the input.
+ * The RadixHistogramKernel counts the digits of every chunk,
+ * the ScanKernel turns the counts into offsets and the
+ * RadixScatterKernel moves the pairs to their new place.
+ * The counts are stored digit-major (digit * numChunks + chunk),
+ * so the scan yields the offsets in the right order and
+ * the sort is stable without any atomics.
+ *
+ * @file radixSortKernels.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace radix {
+
+/** Number of bits sorted in one pass */
+std::size_t const bits = 8;
+/** Number of different digits */
+std::size_t const numDigits = 1u << bits;
+
+} // namespace radix
+
+/** Class containing the Radix Histogram Kernel
+ *
+ * One thread per chunk.
+ */
+class RadixHistogramKernel
+{
+public:
+    /** Radix Histogram Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TKey unsigned integer type of the keys
+     * @param acc the accelerator
+     * @param keys keys to sort
+     * @param numElements number of keys
+     * @param chunkLength keys per chunk
+     * @param numChunks number of chunks
+     * @param shift position of the digit in the key
+     * @param counts array of numDigits * numChunks counts
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TKey,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TKey const * const keys,
+        TSize const & numElements,
+        TSize const & chunkLength,
+        TSize const & numChunks,
+        std::size_t const & shift,
+        TSize * const counts) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const chunk(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        if( chunk >= numChunks )
+            return;
+
+        for( std::size_t digit( 0 ); digit < radix::numDigits; digit++ )
+            counts[ digit * numChunks + chunk ] = 0;
+
+        TSize const begin( chunk * chunkLength );
+        TSize const endHelp( begin + chunkLength );
+        TSize const end( ( endHelp < numElements ) ?
+                endHelp : numElements );
+
+        for( TSize i( begin ); i < end; i++ )
+        {
+            std::size_t const digit(
+                    ( keys[ i ] >> shift ) & ( radix::numDigits - 1 ) );
+            counts[ digit * numChunks + chunk ]++;
+        }
+    }
+};
+
+/** Class containing the Radix Scatter Kernel
+ *
+ * One thread per chunk. The offsets are the
+ * exclusive prefix sum of the counts of the
+ * RadixHistogramKernel.
+ */
+class RadixScatterKernel
+{
+public:
+    /** Radix Scatter Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TKey unsigned integer type of the keys
+     * @tparam TValue type of the values
+     * @param acc the accelerator
+     * @param keys keys to sort
+     * @param values values to sort
+     * @param numElements number of pairs
+     * @param chunkLength pairs per chunk
+     * @param numChunks number of chunks
+     * @param shift position of the digit in the key
+     * @param offsets array of numDigits * numChunks offsets
+     * @param keysOut sorted keys
+     * @param valuesOut sorted values
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TKey,
+        typename TValue,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TKey const * const keys,
+        TValue const * const values,
+        TSize const & numElements,
+        TSize const & chunkLength,
+        TSize const & numChunks,
+        std::size_t const & shift,
+        TSize * const offsets,
+        TKey * const keysOut,
+        TValue * const valuesOut) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const chunk(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        if( chunk >= numChunks )
+            return;
+
+        TSize const begin( chunk * chunkLength );
+        TSize const endHelp( begin + chunkLength );
+        TSize const end( ( endHelp < numElements ) ?
+                endHelp : numElements );
+
+        // Only this thread touches the offsets of its chunk
+        for( TSize i( begin ); i < end; i++ )
+        {
+            std::size_t const digit(
+                    ( keys[ i ] >> shift ) & ( radix::numDigits - 1 ) );
+            TSize const destination(
+                    offsets[ digit * numChunks + chunk ]++ );
+            keysOut[ destination ] = keys[ i ];
+            valuesOut[ destination ] = values[ i ];
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
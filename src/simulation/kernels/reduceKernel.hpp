@@ -0,0 +1,289 @@
+/** Kernel for the reduction of rows
+ *
+ * This file implements an Alpaka Kernel
+ * which reduces every row of a pitched 2D
+ * array to a single value in one launch.
+ *
+ * @file reduceKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace reduce {
+
+/** Binary operations for the ReduceKernel
+ *
+ * Every operation has to be associative and commutative
+ */
+struct Add
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TElem>
+    ALPAKA_FN_HOST_ACC auto operator()(
+            TElem const & a,
+            TElem const & b) const
+    -> TElem
+    {
+        return a + b;
+    }
+};
+
+struct Min
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TElem>
+    ALPAKA_FN_HOST_ACC auto operator()(
+            TElem const & a,
+            TElem const & b) const
+    -> TElem
+    {
+        return ( b < a ) ? b : a;
+    }
+};
+
+struct Max
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TElem>
+    ALPAKA_FN_HOST_ACC auto operator()(
+            TElem const & a,
+            TElem const & b) const
+    -> TElem
+    {
+        return ( a < b ) ? b : a;
+    }
+};
+
+/** Elementwise minimum of two vectors
+ *
+ * TElem has to be a Vector or any other type
+ * with a static member dim and operator[]
+ */
+struct MinElementwise
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TElem>
+    ALPAKA_FN_HOST_ACC auto operator()(
+            TElem const & a,
+            TElem const & b) const
+    -> TElem
+    {
+        TElem result( a );
+        for( std::size_t i( 0 ); i < TElem::dim; i++ )
+        {
+            if( b[ i ] < result[ i ] )
+                result[ i ] = b[ i ];
+        }
+        return result;
+    }
+};
+
+/** Elementwise maximum of two vectors */
+struct MaxElementwise
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TElem>
+    ALPAKA_FN_HOST_ACC auto operator()(
+            TElem const & a,
+            TElem const & b) const
+    -> TElem
+    {
+        TElem result( a );
+        for( std::size_t i( 0 ); i < TElem::dim; i++ )
+        {
+            if( result[ i ] < b[ i ] )
+                result[ i ] = b[ i ];
+        }
+        return result;
+    }
+};
+
+} // namespace reduce
+
+/** Class containing the Reduce Kernel
+ *
+ * Every block reduces one row. First every thread reduces
+ * the elements threadIdx, threadIdx + blockThreads, ...
+ * sequentially, then the partial results of the block are
+ * combined by a tree reduction in shared memory.
+ *
+ * The kernel has to be started with a grid of (numRows, 1)
+ * blocks and (1, blockThreads) threads per block with
+ * blockThreads <= TBlockSize. getWorkDiv creates such a
+ * work division.
+ *
+ * @tparam TBlockSize maximum number of threads per block
+ */
+template<
+    std::size_t TBlockSize>
+class ReduceKernel
+{
+public:
+    /** Reduce Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TElem datatype of the elements
+     * @tparam TOp binary operation, e.g. reduce::Add
+     * @param acc the accelerator
+     * @param input first element of the first row
+     * @param pitchBytesInput bytes between two rows of input
+     * @param numRows number of rows
+     * @param rowLength number of elements per row
+     * @param output destination of the result of row 0
+     * @param pitchBytesOutput bytes between two results
+     * @param op binary operation
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize,
+        typename TOp>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TElem const * const input,
+        TSize const & pitchBytesInput,
+        TSize const & numRows,
+        TSize const & rowLength,
+        TElem * const output,
+        TSize const & pitchBytesOutput,
+        TOp const & op) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 2,
+                "This kernel required 2-dimensional indices");
+
+        TElem * const shared(
+                alpaka::block::shared::allocArr<TElem, TBlockSize>( acc ));
+
+        auto const row(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>
+                    ( acc )[0u]);
+        auto const blockThreadIdx(
+                alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>
+                    ( acc )[1u]);
+        auto const blockThreads(
+                alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>
+                    ( acc )[1u]);
+
+        // Threads which get at least one element
+        TSize const activeThreads( ( rowLength < blockThreads ) ?
+                rowLength : static_cast<TSize>( blockThreads ) );
+
+        // no return before the barriers, every thread has to reach them
+        bool const active( row < numRows &&
+                blockThreadIdx < activeThreads );
+
+        if( active )
+        {
+            TElem const * const beginOfRow(
+                    (TElem const *)(
+                        (char const *)input +
+                        row * pitchBytesInput));
+
+            TElem value( beginOfRow[ blockThreadIdx ] );
+            for( TSize i( blockThreadIdx + blockThreads );
+                 i < rowLength;
+                 i += blockThreads )
+            {
+                value = op( value, beginOfRow[ i ] );
+            }
+            shared[ blockThreadIdx ] = value;
+        }
+
+        alpaka::block::sync::syncBlockThreads( acc );
+
+        TSize half( 1 );
+        while( half < activeThreads ) half <<= 1;
+
+        for( half >>= 1; half > 0; half >>= 1 )
+        {
+            if( active &&
+                blockThreadIdx < half &&
+                blockThreadIdx + half < activeThreads )
+            {
+                shared[ blockThreadIdx ] = op(
+                        shared[ blockThreadIdx ],
+                        shared[ blockThreadIdx + half ] );
+            }
+            alpaka::block::sync::syncBlockThreads( acc );
+        }
+
+        if( active && blockThreadIdx == 0 )
+        {
+            *(TElem *)(
+                (char *)output +
+                row * pitchBytesOutput) = shared[ 0 ];
+        }
+    }
+
+    /** Work division for the Reduce Kernel
+     *
+     * One block per row with as many threads as
+     * the accelerator and TBlockSize allow.
+     *
+     * @tparam TAcc 2-dimensional accelerator
+     * @param devAcc device of the accelerator
+     * @param numRows number of rows
+     * @param rowLength number of elements per row
+     */
+    template<
+        typename TAcc,
+        typename TDev,
+        typename TSize>
+    static auto getWorkDiv(
+        TDev const & devAcc,
+        TSize const & numRows,
+        TSize const & rowLength)
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<2u>,
+        TSize>
+    {
+        auto const devProps(
+                alpaka::acc::getAccDevProps<TAcc>( devAcc ));
+
+        TSize maxThreads( TBlockSize );
+        if( devProps.m_blockThreadExtentMax[1u] < maxThreads )
+            maxThreads = devProps.m_blockThreadExtentMax[1u];
+        if( devProps.m_blockThreadCountMax < maxThreads )
+            maxThreads = devProps.m_blockThreadCountMax;
+
+        // more threads than elements would just idle
+        TSize blockThreads( 1 );
+        while( blockThreads * 2 <= maxThreads &&
+               blockThreads < rowLength )
+            blockThreads <<= 1;
+
+        return alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<2u>,
+            TSize>(
+                alpaka::Vec<alpaka::dim::DimInt<2u>, TSize>(
+                    numRows, static_cast<TSize>(1) ),
+                alpaka::Vec<alpaka::dim::DimInt<2u>, TSize>(
+                    static_cast<TSize>(1), blockThreads ),
+                alpaka::Vec<alpaka::dim::DimInt<2u>, TSize>::ones() );
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,147 @@
+/** Kernels of the reordering of the bodies
+ *
+ * This file implements the Alpaka Kernels which
+ * move the bodies of the simulation to the order
+ * of their keys on a space-filling curve.
+ *
+ * @file reorderKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+// morton::Key, morton::Bits
+#include <simulation/kernels/mortonKeyKernel.hpp>
+#include <simulation/types/bodies.hpp> // Bodies
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Tracer Key Kernel
+ *
+ * Sets the bit above the curve in the keys of the
+ * tracers, so they stay behind the massive bodies.
+ * The keys have to be in the order of the bodies.
+ */
+class TracerKeyKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        morton::Key * const keys,
+        TSize const & numMassive,
+        TSize const & numBodies,
+        std::size_t const & bitTracer) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            if( indexBody >= numMassive )
+                keys[ indexBody ] |= morton::Key(1) << bitTracer;
+        }
+    }
+};
+
+/** Class containing the Reorder Kernel
+ *
+ * Gathers everything that belongs to a body:
+ * out[i] = in[ permutation[i] ] for the position and mass
+ * in the layout, the velocity and the original index.
+ */
+class ReorderKernel
+{
+public:
+    /** Reorder Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass, position and velocity
+     * @param acc the accelerator
+     * @param permutation new position i holds old body permutation[i]
+     * @param numBodies number of bodies
+     * @param bodies positions and masses in the old order
+     * @param bodiesVelocity velocities in the old order
+     * @param order original indices in the old order
+     * @param bodiesOut positions and masses in the new order
+     * @param bodiesVelocityOut velocities in the new order
+     * @param orderOut original indices in the new order
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TSize const * const permutation,
+        TSize const & numBodies,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> const * const bodiesVelocity,
+        TSize const * const order,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodiesOut,
+        types::Vector<NDim,TElem> * const bodiesVelocityOut,
+        TSize * const orderOut) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            TSize const source( permutation[ indexBody ] );
+            bodiesOut.setPosition( indexBody, bodies.getPosition( source ) );
+            bodiesOut.setMass( indexBody, bodies.getMass( source ) );
+            bodiesVelocityOut[ indexBody ] = bodiesVelocity[ source ];
+            orderOut[ indexBody ] = order[ source ];
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,126 @@
+/** Kernel of the ring solver
+ *
+ * This file implements the Alpaka Kernel which sums up
+ * the interactions of a block of sinks with a block of
+ * sources. The blocks are parts of the same set of bodies,
+ * so a body is not its own source.
+ *
+ * @file ringKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Ring Acceleration Kernel
+ *
+ * Sink i is body sinkBegin + i and source j is body
+ * sourceBegin + j of the whole set.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicRingAccelerationKernel
+{
+public:
+    /** Ring Acceleration Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param sinksPosition positions of the sinks
+     * @param sinkBegin index of the first sink in the whole set
+     * @param numSinks number of sinks
+     * @param sourcesPosition positions of the sources
+     * @param sourcesMass masses of the sources
+     * @param sourceBegin index of the first source in the whole set
+     * @param numSources number of sources
+     * @param smoothnessFactor Smoothness Factor
+     * @param accelerations acceleration/G of every sink
+     * @param accumulate adds to accelerations instead of
+     *        overwriting them
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const sinksPosition,
+        TSize const & sinkBegin,
+        TSize const & numSinks,
+        types::Vector<NDim,TElem> const * const sourcesPosition,
+        TElem const * const sourcesMass,
+        TSize const & sourceBegin,
+        TSize const & numSources,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const accelerations,
+        bool const & accumulate) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc)[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        for( TSize threadX = 0,
+            indexX = gridThreadIdx * threadElemExtent;
+            threadX < threadElemExtent &&
+            indexX < numSinks;
+            threadX++,
+            indexX++)
+        {
+            types::Vector<NDim,TElem> const position(
+                    sinksPosition[ indexX ] );
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( TSize j( 0 ); j < numSources; j++ )
+            {
+                if( sourceBegin + j == sinkBegin + indexX )
+                    continue;
+                acceleration += TForceLaw::interaction(
+                        acc,
+                        sourcesPosition[ j ] - position,
+                        sourcesMass[ j ],
+                        smoothnessFactor );
+            }
+
+            if( accumulate )
+                accelerations[ indexX ] += acceleration;
+            else
+                accelerations[ indexX ] = acceleration;
+        }
+    }
+};
+
+using RingAccelerationKernel =
+    BasicRingAccelerationKernel<forceLaws::Plummer>;
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
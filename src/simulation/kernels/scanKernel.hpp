@@ -0,0 +1,172 @@
+/** Kernel for an exclusive prefix sum
+ *
+ * This file implements an Alpaka Kernel
+ * which calculates the exclusive prefix sum
+ * of an array with a single block.
+ *
+ * @file scanKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Scan Kernel
+ *
+ * Every thread of the single block takes a contiguous
+ * segment of the array and sums it up. The first thread
+ * scans these partial sums in shared memory, afterwards
+ * every thread writes the prefix sums of its segment.
+ *
+ * The kernel has to be started with one block of at most
+ * TBlockSize threads, getWorkDiv creates such a work division.
+ *
+ * @tparam TBlockSize maximum number of threads per block
+ */
+template<
+    std::size_t TBlockSize>
+class ScanKernel
+{
+public:
+    /** Scan Kernel
+     *
+     * output[i] = input[0] + ... + input[i-1]
+     * input and output may be the same array.
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TIn datatype of the input
+     * @tparam TOut datatype of the sums
+     * @param acc the accelerator
+     * @param input array to scan
+     * @param output array for the prefix sums
+     * @param numElements number of elements
+     * @param total sum of all elements, may be nullptr
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TIn,
+        typename TOut,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TIn const * const input,
+        TOut * const output,
+        TSize const & numElements,
+        TOut * const total) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TOut * const shared(
+                alpaka::block::shared::allocArr<TOut, TBlockSize>( acc ));
+
+        auto const blockThreadIdx(
+                alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>
+                    ( acc )[0u]);
+        auto const blockThreads(
+                alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>
+                    ( acc )[0u]);
+
+        TSize const segmentLength(
+                ( numElements + blockThreads - 1 ) / blockThreads );
+        TSize const segmentBegin( blockThreadIdx * segmentLength );
+        TSize const segmentEndHelp( segmentBegin + segmentLength );
+        TSize const segmentEnd( ( segmentEndHelp < numElements ) ?
+                segmentEndHelp : numElements );
+
+        TOut sum( 0 );
+        for( TSize i( segmentBegin ); i < segmentEnd; i++ )
+        {
+            sum += static_cast<TOut>( input[ i ] );
+        }
+        shared[ blockThreadIdx ] = sum;
+
+        alpaka::block::sync::syncBlockThreads( acc );
+
+        if( blockThreadIdx == 0 )
+        {
+            TOut running( 0 );
+            for( TSize t( 0 ); t < blockThreads; t++ )
+            {
+                TOut const value( shared[ t ] );
+                shared[ t ] = running;
+                running += value;
+            }
+            if( total != nullptr )
+                *total = running;
+        }
+
+        alpaka::block::sync::syncBlockThreads( acc );
+
+        TOut running( shared[ blockThreadIdx ] );
+        for( TSize i( segmentBegin ); i < segmentEnd; i++ )
+        {
+            // read before write, input and output may alias
+            TOut const value( static_cast<TOut>( input[ i ] ) );
+            output[ i ] = running;
+            running += value;
+        }
+    }
+
+    /** Work division for the Scan Kernel
+     *
+     * One block with as many threads as
+     * the accelerator and TBlockSize allow.
+     *
+     * @tparam TAcc 1-dimensional accelerator
+     * @param devAcc device of the accelerator
+     * @param numElements number of elements
+     */
+    template<
+        typename TAcc,
+        typename TDev,
+        typename TSize>
+    static auto getWorkDiv(
+        TDev const & devAcc,
+        TSize const & numElements)
+    -> alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        auto const devProps(
+                alpaka::acc::getAccDevProps<TAcc>( devAcc ));
+
+        TSize maxThreads( TBlockSize );
+        if( devProps.m_blockThreadExtentMax[0u] < maxThreads )
+            maxThreads = devProps.m_blockThreadExtentMax[0u];
+        if( devProps.m_blockThreadCountMax < maxThreads )
+            maxThreads = devProps.m_blockThreadCountMax;
+
+        TSize blockThreads( 1 );
+        while( blockThreads * 2 <= maxThreads &&
+               blockThreads < numElements )
+            blockThreads <<= 1;
+
+        return alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>(
+                alpaka::Vec<alpaka::dim::DimInt<1u>, TSize>(
+                    static_cast<TSize>(1) ),
+                alpaka::Vec<alpaka::dim::DimInt<1u>, TSize>(
+                    blockThreads ),
+                alpaka::Vec<alpaka::dim::DimInt<1u>, TSize>::ones() );
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,417 @@
+/** Kernels of the short range solver
+ *
+ * This file implements the Alpaka Kernels for interactions
+ * with a cutoff: a direct summation over the neighbouring
+ * cells of a cell list, the Verlet lists of the neighbours
+ * within the cutoff plus a skin, the summation over these
+ * lists and the displacements since the lists were built.
+ *
+ * @file shortRangeKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+// cells::Geometry, cells::Neighbourhood, cells::nearestImage
+#include <simulation/kernels/cellListKernels.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Cell Cutoff Kernel
+ *
+ * Sums up TForceLaw for all pairs closer than the cutoff,
+ * only the neighbouring cells of a body are visited.
+ * Periodic cells use the nearest image of every pair.
+ *
+ * The bodies are processed in the order of the cell list,
+ * the accelerations are written in the original order.
+ *
+ * @tparam TPeriodic periodic cells
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    bool TPeriodic,
+    typename TForceLaw>
+class CellCutoffKernel
+{
+public:
+    /** Cell Cutoff Kernel
+     *
+     * @param geometry placement of the cells
+     * @param keys cell of every sorted body
+     * @param cellBegin first sorted body of every cell
+     * @param cellEnd behind the last sorted body of every cell
+     * @param bodiesPosition sorted positions
+     * @param bodiesMass sorted masses
+     * @param permutation original index of every sorted body
+     * @param numBodies number of bodies
+     * @param cutoff largest distance of a pair
+     * @param smoothnessFactor Smoothness Factor
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        cells::Geometry<NDim,TElem,TSize> const & geometry,
+        TSize const * const keys,
+        TSize const * const cellBegin,
+        TSize const * const cellEnd,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const * const permutation,
+        TSize const & numBodies,
+        TElem const & cutoff,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const cutoffSq( cutoff * cutoff );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodiesPosition[ indexBody ] );
+
+            cells::Neighbourhood<TPeriodic,NDim,TElem,TSize> const
+                neighbourhood( geometry, keys[ indexBody ] );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( std::size_t neighbour( 0 );
+                 neighbour < neighbourhood.size();
+                 neighbour++ )
+            {
+                TSize indexCell;
+                if( !neighbourhood.cell( neighbour, indexCell ) )
+                    continue;
+
+                for( TSize indexBodyInfluencing( cellBegin[ indexCell ] );
+                     indexBodyInfluencing < cellEnd[ indexCell ];
+                     indexBodyInfluencing++ )
+                {
+                    if( indexBodyInfluencing == indexBody )
+                        continue;
+
+                    types::Vector<NDim,TElem> bodyRelative(
+                            bodiesPosition[ indexBodyInfluencing ] -
+                            positionInfluenced );
+                    cells::nearestImage<TPeriodic>(
+                            acc, geometry, bodyRelative );
+
+                    if( bodyRelative.absSq() >= cutoffSq )
+                        continue;
+
+                    acceleration += TForceLaw::interaction(
+                            acc,
+                            bodyRelative,
+                            bodiesMass[ indexBodyInfluencing ],
+                            smoothnessFactor );
+                }
+            }
+
+            bodiesAcceleration[ permutation[ indexBody ] ] = acceleration;
+        }
+    }
+};
+
+/** Class containing the Verlet List Kernel
+ *
+ * Collects the original indices of all bodies closer than
+ * radius, the cutoff plus the skin, in the list of every
+ * body and saves its position as the reference for the
+ * displacements. If a list is too short, numNeighbours
+ * still counts all neighbours, so the caller can detect
+ * the overflow and build the lists again.
+ *
+ * @tparam TPeriodic periodic cells
+ */
+template<
+    bool TPeriodic>
+class VerletListKernel
+{
+public:
+    /** Verlet List Kernel
+     *
+     * @param geometry placement of the cells
+     * @param keys cell of every sorted body
+     * @param cellBegin first sorted body of every cell
+     * @param cellEnd behind the last sorted body of every cell
+     * @param bodiesPosition sorted positions
+     * @param permutation original index of every sorted body
+     * @param numBodies number of bodies
+     * @param radius largest distance of a neighbour
+     * @param maxNeighbours length of every list
+     * @param neighbours list of body i at i * maxNeighbours
+     * @param numNeighbours number of neighbours of every body
+     * @param referencePosition positions the lists were built for
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        cells::Geometry<NDim,TElem,TSize> const & geometry,
+        TSize const * const keys,
+        TSize const * const cellBegin,
+        TSize const * const cellEnd,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TSize const * const permutation,
+        TSize const & numBodies,
+        TElem const & radius,
+        TSize const & maxNeighbours,
+        TSize * const neighbours,
+        TSize * const numNeighbours,
+        types::Vector<NDim,TElem> * const referencePosition) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const radiusSq( radius * radius );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const position(
+                    bodiesPosition[ indexBody ] );
+            TSize const indexOriginal( permutation[ indexBody ] );
+            TSize * const list( neighbours + indexOriginal * maxNeighbours );
+
+            cells::Neighbourhood<TPeriodic,NDim,TElem,TSize> const
+                neighbourhood( geometry, keys[ indexBody ] );
+
+            TSize count( 0 );
+            for( std::size_t neighbour( 0 );
+                 neighbour < neighbourhood.size();
+                 neighbour++ )
+            {
+                TSize indexCell;
+                if( !neighbourhood.cell( neighbour, indexCell ) )
+                    continue;
+
+                for( TSize indexOther( cellBegin[ indexCell ] );
+                     indexOther < cellEnd[ indexCell ];
+                     indexOther++ )
+                {
+                    if( indexOther == indexBody )
+                        continue;
+
+                    types::Vector<NDim,TElem> bodyRelative(
+                            bodiesPosition[ indexOther ] - position );
+                    cells::nearestImage<TPeriodic>(
+                            acc, geometry, bodyRelative );
+
+                    if( bodyRelative.absSq() >= radiusSq )
+                        continue;
+
+                    if( count < maxNeighbours )
+                        list[ count ] = permutation[ indexOther ];
+                    count++;
+                }
+            }
+
+            numNeighbours[ indexOriginal ] = count;
+            referencePosition[ indexOriginal ] = position;
+        }
+    }
+};
+
+/** Class containing the Verlet Force Kernel
+ *
+ * Sums up TForceLaw for the pairs of the Verlet lists which
+ * are closer than the cutoff. The bodies are read in their
+ * original order.
+ *
+ * @tparam TPeriodic periodic cells
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    bool TPeriodic,
+    typename TForceLaw>
+class VerletForceKernel
+{
+public:
+    /** Verlet Force Kernel
+     *
+     * @param geometry placement of the cells the lists were built in
+     * @param bodiesPosition positions of the bodies
+     * @param bodiesMass masses of the bodies
+     * @param neighbours list of body i at i * maxNeighbours
+     * @param numNeighbours number of neighbours of every body
+     * @param maxNeighbours length of every list
+     * @param numBodies number of bodies
+     * @param cutoff largest distance of a pair
+     * @param smoothnessFactor Smoothness Factor
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        cells::Geometry<NDim,TElem,TSize> const & geometry,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const * const neighbours,
+        TSize const * const numNeighbours,
+        TSize const & maxNeighbours,
+        TSize const & numBodies,
+        TElem const & cutoff,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TElem const cutoffSq( cutoff * cutoff );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodiesPosition[ indexBody ] );
+            TSize const * const list( neighbours + indexBody * maxNeighbours );
+            TSize const count( ( numNeighbours[ indexBody ] < maxNeighbours ) ?
+                    numNeighbours[ indexBody ] : maxNeighbours );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>( 0 ) );
+
+            for( TSize neighbour( 0 ); neighbour < count; neighbour++ )
+            {
+                TSize const indexBodyInfluencing( list[ neighbour ] );
+
+                types::Vector<NDim,TElem> bodyRelative(
+                        bodiesPosition[ indexBodyInfluencing ] -
+                        positionInfluenced );
+                cells::nearestImage<TPeriodic>(
+                        acc, geometry, bodyRelative );
+
+                if( bodyRelative.absSq() >= cutoffSq )
+                    continue;
+
+                acceleration += TForceLaw::interaction(
+                        acc,
+                        bodyRelative,
+                        bodiesMass[ indexBodyInfluencing ],
+                        smoothnessFactor );
+            }
+
+            bodiesAcceleration[ indexBody ] = acceleration;
+        }
+    }
+};
+
+/** Class containing the Displacement Kernel
+ *
+ * displacementSq[i] = |x_i - reference_i|^2
+ */
+class DisplacementKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        types::Vector<NDim,TElem> const * const referencePosition,
+        TSize const & numBodies,
+        TElem * const displacementSq) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            displacementSq[ indexBody ] = ( bodiesPosition[ indexBody ] -
+                    referencePosition[ indexBody ] ).absSq();
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,523 @@
+/** Kernel for the vectorised calculation of accelerations
+ *
+ * This file implements an Alpaka Kernel for the CPU
+ * backends. It calculates the same accelerations as the
+ * AccelerationKernel but interacts a whole pack of
+ * influencing bodies with the influenced body at once.
+ *
+ * @file simdAccelerationKernel.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+#if !defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && \
+    ( defined(__AVX2__) || defined(__AVX512F__) )
+    #include <immintrin.h> // __m256, __m512
+#endif
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace simd {
+
+// widest pack of floats the target supports
+#if !defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__AVX512F__)
+constexpr std::size_t defaultWidth = 16;
+#else
+constexpr std::size_t defaultWidth = 8;
+#endif
+
+/** Pack of TWidth values
+ *
+ * This is the portable pack, the loops over the lanes are
+ * left to the vectoriser of the compiler. The packs of
+ * floats with intrinsics are below.
+ *
+ * @tparam TElem type of the values
+ * @tparam TWidth number of values
+ */
+template<
+    typename TElem,
+    std::size_t TWidth>
+class Pack
+{
+public:
+    TElem lane[ TWidth ];
+
+    ALPAKA_FN_ACC static auto load(
+        TElem const * const values)
+    -> Pack
+    {
+        Pack result;
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+            result.lane[ l ] = values[ l ];
+        return result;
+    }
+
+    ALPAKA_FN_ACC static auto broadcast(
+        TElem const value)
+    -> Pack
+    {
+        Pack result;
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+            result.lane[ l ] = value;
+        return result;
+    }
+
+    ALPAKA_FN_ACC auto operator+(
+        Pack const & other) const
+    -> Pack
+    {
+        Pack result;
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+            result.lane[ l ] = lane[ l ] + other.lane[ l ];
+        return result;
+    }
+
+    ALPAKA_FN_ACC auto operator*(
+        Pack const & other) const
+    -> Pack
+    {
+        Pack result;
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+            result.lane[ l ] = lane[ l ] * other.lane[ l ];
+        return result;
+    }
+
+    // 1 / sqrt(x) of every lane
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC static auto rsqrt(
+        TAcc const & acc,
+        Pack const & x)
+    -> Pack
+    {
+        Pack result;
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+            result.lane[ l ] = alpaka::math::rsqrt( acc, x.lane[ l ] );
+        return result;
+    }
+
+    // sum of all lanes
+    ALPAKA_FN_ACC auto sum() const
+    -> TElem
+    {
+        TElem result( lane[ 0 ] );
+        for( std::size_t l( 1 ); l < TWidth; l++ )
+            result += lane[ l ];
+        return result;
+    }
+};
+
+#if !defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__AVX2__)
+/** Pack of 8 floats in an AVX register
+ *
+ * The reciprocal square root is approximated with 12 bits
+ * and refined by one Newton step.
+ */
+template<>
+class Pack<
+    float,
+    8>
+{
+public:
+    __m256 value;
+
+    static auto load(
+        float const * const values)
+    -> Pack
+    {
+        return Pack{ _mm256_loadu_ps( values ) };
+    }
+
+    static auto broadcast(
+        float const value)
+    -> Pack
+    {
+        return Pack{ _mm256_set1_ps( value ) };
+    }
+
+    auto operator+(
+        Pack const & other) const
+    -> Pack
+    {
+        return Pack{ _mm256_add_ps( value, other.value ) };
+    }
+
+    auto operator*(
+        Pack const & other) const
+    -> Pack
+    {
+        return Pack{ _mm256_mul_ps( value, other.value ) };
+    }
+
+    // y = y * ( 1.5 - 0.5 * x * y * y )
+    template<
+        typename TAcc>
+    static auto rsqrt(
+        TAcc const &,
+        Pack const & x)
+    -> Pack
+    {
+        __m256 const y( _mm256_rsqrt_ps( x.value ) );
+        __m256 const halfXYY( _mm256_mul_ps(
+                _mm256_mul_ps( _mm256_set1_ps( 0.5f ), x.value ),
+                _mm256_mul_ps( y, y ) ) );
+        return Pack{ _mm256_mul_ps(
+                y,
+                _mm256_sub_ps( _mm256_set1_ps( 1.5f ), halfXYY ) ) };
+    }
+
+    auto sum() const
+    -> float
+    {
+        __m128 const half( _mm_add_ps(
+                _mm256_castps256_ps128( value ),
+                _mm256_extractf128_ps( value, 1 ) ) );
+        __m128 const quarter( _mm_add_ps(
+                half,
+                _mm_movehl_ps( half, half ) ) );
+        return _mm_cvtss_f32( _mm_add_ss(
+                quarter,
+                _mm_shuffle_ps( quarter, quarter, 1 ) ) );
+    }
+};
+#endif
+
+#if !defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__AVX512F__)
+/** Pack of 16 floats in an AVX-512 register
+ *
+ * The reciprocal square root is approximated with 14 bits
+ * and refined by one Newton step.
+ */
+template<>
+class Pack<
+    float,
+    16>
+{
+public:
+    __m512 value;
+
+    static auto load(
+        float const * const values)
+    -> Pack
+    {
+        return Pack{ _mm512_loadu_ps( values ) };
+    }
+
+    static auto broadcast(
+        float const value)
+    -> Pack
+    {
+        return Pack{ _mm512_set1_ps( value ) };
+    }
+
+    auto operator+(
+        Pack const & other) const
+    -> Pack
+    {
+        return Pack{ _mm512_add_ps( value, other.value ) };
+    }
+
+    auto operator*(
+        Pack const & other) const
+    -> Pack
+    {
+        return Pack{ _mm512_mul_ps( value, other.value ) };
+    }
+
+    // y = y * ( 1.5 - 0.5 * x * y * y )
+    template<
+        typename TAcc>
+    static auto rsqrt(
+        TAcc const &,
+        Pack const & x)
+    -> Pack
+    {
+        __m512 const y( _mm512_rsqrt14_ps( x.value ) );
+        __m512 const halfXYY( _mm512_mul_ps(
+                _mm512_mul_ps( _mm512_set1_ps( 0.5f ), x.value ),
+                _mm512_mul_ps( y, y ) ) );
+        return Pack{ _mm512_mul_ps(
+                y,
+                _mm512_sub_ps( _mm512_set1_ps( 1.5f ), halfXYY ) ) };
+    }
+
+    auto sum() const
+    -> float
+    {
+        return _mm512_reduce_add_ps( value );
+    }
+};
+#endif
+
+/** Interactions of a pack of influencing bodies
+ *
+ * add() adds the acceleration/G due to every lane to the
+ * lanes of acceleration. The laws without a pack version
+ * are evaluated lane by lane, which is left to the
+ * vectoriser of the compiler.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+struct Interaction
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        std::size_t TWidth,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto add(
+        TAcc const & acc,
+        TElem const (& relative)[ NDim ][ TWidth ],
+        TElem const (& mass)[ TWidth ],
+        TFactor const & smoothnessFactor,
+        Pack<TElem,TWidth> (& acceleration)[ NDim ])
+    -> void
+    {
+        TElem lanes[ NDim ][ TWidth ];
+        for( std::size_t l( 0 ); l < TWidth; l++ )
+        {
+            types::Vector<NDim,TElem> positionRelative;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                positionRelative[ d ] = relative[ d ][ l ];
+            types::Vector<NDim,TElem> const interaction(
+                    TForceLaw::interaction(
+                        acc,
+                        positionRelative,
+                        mass[ l ],
+                        smoothnessFactor ) );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                lanes[ d ][ l ] = interaction[ d ];
+        }
+
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            acceleration[ d ] = acceleration[ d ] +
+                Pack<TElem,TWidth>::load( lanes[ d ] );
+    }
+};
+
+/** Plummer law with the operations of Pack */
+template<>
+struct Interaction<
+    forceLaws::Plummer>
+{
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        std::size_t TWidth,
+        typename TFactor>
+    ALPAKA_FN_ACC static auto add(
+        TAcc const & acc,
+        TElem const (& relative)[ NDim ][ TWidth ],
+        TElem const (& mass)[ TWidth ],
+        TFactor const & smoothnessFactor,
+        Pack<TElem,TWidth> (& acceleration)[ NDim ])
+    -> void
+    {
+        using PackElem = Pack<TElem,TWidth>;
+
+        PackElem positionRelative[ NDim ];
+        // Distance squared + smoothnessFactor
+        PackElem dist(
+                PackElem::broadcast( static_cast<TElem>( smoothnessFactor ) ) );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            positionRelative[ d ] = PackElem::load( relative[ d ] );
+            dist = dist + positionRelative[ d ] * positionRelative[ d ];
+        }
+
+        PackElem const rdist( PackElem::rsqrt( acc, dist ) );
+        PackElem const forceFactor(
+                PackElem::load( mass ) * rdist * rdist * rdist );
+
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            acceleration[ d ] = acceleration[ d ] +
+                forceFactor * positionRelative[ d ];
+    }
+};
+
+} // namespace simd
+
+/** Class containing the SIMD Acceleration Kernel
+ *
+ * The influencing bodies are processed in packs of TWidth.
+ * A pack is loaded lane by lane relative to the influenced
+ * body, then the interactions of all lanes are calculated
+ * with the operations of simd::Pack. Lanes behind the last
+ * body and the influenced body itself get no mass.
+ *
+ * With AVX2 or AVX-512 and float the packs of 8 or 16 use
+ * intrinsics, everything else the portable pack.
+ *
+ * @tparam TWidth influencing bodies per iteration
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ *         and simd::Interaction
+ */
+template<
+    std::size_t TWidth = simd::defaultWidth,
+    typename TForceLaw = forceLaws::Plummer>
+class SimdAccelerationKernel
+{
+public:
+    /** SIMD Acceleration Kernel
+     *
+     * Like in the ForceMatrixKernel the gravitationalConstant
+     * is not applied here. This is done by the UpdatePositionsKernel.
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout storage layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     *
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        using Pack = simd::Pack<TElem,TWidth>;
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        for( TSize threadBodyInfluenced = 0,
+            indexBodyInfluenced = gridThreadIdx * threadElemExtent;
+            threadBodyInfluenced < threadElemExtent &&
+            indexBodyInfluenced < numBodies;
+            threadBodyInfluenced++,
+            indexBodyInfluenced++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodies.getPosition( indexBodyInfluenced ) );
+
+            Pack acceleration[ NDim ];
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                acceleration[ d ] = Pack::broadcast( static_cast<TElem>( 0 ) );
+
+            for( TSize packFirst( 0 );
+                 packFirst < numBodies;
+                 packFirst += TWidth )
+            {
+                // empty lanes are one unit away, so the
+                // distance is never zero
+                TElem relative[ NDim ][ TWidth ];
+                TElem mass[ TWidth ];
+                for( std::size_t l( 0 ); l < TWidth; l++ )
+                {
+                    TSize const indexBodyInfluencing( packFirst + l );
+                    if( indexBodyInfluencing < numBodies &&
+                        indexBodyInfluencing != indexBodyInfluenced )
+                    {
+                        types::Vector<NDim,TElem> const positionRelative(
+                                bodies.getPosition( indexBodyInfluencing ) -
+                                positionInfluenced );
+                        for( std::size_t d( 0 ); d < NDim; d++ )
+                            relative[ d ][ l ] = positionRelative[ d ];
+                        mass[ l ] = bodies.getMass( indexBodyInfluencing );
+                    }
+                    else
+                    {
+                        for( std::size_t d( 0 ); d < NDim; d++ )
+                            relative[ d ][ l ] = static_cast<TElem>( d == 0 );
+                        mass[ l ] = static_cast<TElem>( 0 );
+                    }
+                }
+
+                simd::Interaction<TForceLaw>::add(
+                        acc,
+                        relative,
+                        mass,
+                        smoothnessFactor,
+                        acceleration );
+            }
+
+            types::Vector<NDim,TElem> result;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                result[ d ] = acceleration[ d ].sum();
+            bodiesAcceleration[ indexBodyInfluenced ] = result;
+        }
+    }
+
+    /** SIMD Acceleration Kernel for separate arrays
+     *
+     * @param bodiesPosition array of the bodies' position
+     * @param bodiesMass array of the bodies' mass
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        // the kernel only reads the bodies
+        (*this)(
+            acc,
+            types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                const_cast<TElem *>( bodiesMass ) ),
+            bodiesAcceleration,
+            numBodies,
+            smoothnessFactor );
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
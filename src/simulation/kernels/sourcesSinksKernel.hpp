@@ -0,0 +1,126 @@
+/** Kernel for the accelerations of sinks by sources
+ *
+ * This file implements an Alpaka Kernel which only
+ * sums up the interactions of the first bodies, the
+ * sources, on all bodies, the sinks. The bodies after
+ * the sources are massless tracers.
+ *
+ * @file sourcesSinksKernel.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Sources Sinks Kernel
+ *
+ * Like the AccelerationKernel, but the inner loop only
+ * runs over the numSources first bodies, so the work is
+ * M x N for M sources and the tracers are never read as
+ * sources.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicSourcesSinksKernel
+{
+public:
+    /** Sources Sinks Kernel
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout storage layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param numBodies number of bodies, the sinks
+     * @param numSources number of the first bodies which are sources
+     * @param smoothnessFactor Smoothness Factor
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TSize const & numSources,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx< alpaka::Grid,alpaka::Threads >
+                    ( acc )[0u]);
+
+        for( TSize threadSink = 0,
+            indexSink = gridThreadIdx * threadElemExtent;
+            threadSink < threadElemExtent &&
+            indexSink < numBodies;
+            threadSink++,
+            indexSink++)
+        {
+            types::Vector<NDim,TElem> const positionSink(
+                    bodies.getPosition( indexSink ) );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>(0) );
+
+            for( TSize indexSource = 0;
+                 indexSource < numSources;
+                 indexSource++)
+            {
+                if( indexSource == indexSink )
+                    continue;
+
+                types::Vector<NDim,TElem> const positionRelative(
+                        bodies.getPosition( indexSource ) -
+                        positionSink );
+
+                acceleration += TForceLaw::interaction(
+                        acc,
+                        positionRelative,
+                        bodies.getMass( indexSource ),
+                        smoothnessFactor );
+            }
+
+            bodiesAcceleration[ indexSink ] = acceleration;
+        }
+    }
+};
+
+using SourcesSinksKernel = BasicSourcesSinksKernel<forceLaws::Plummer>;
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
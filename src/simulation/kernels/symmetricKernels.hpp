@@ -0,0 +1,229 @@
+/** Kernels for the symmetric calculation of accelerations
+ *
+ * This file implements two Alpaka Kernels which use
+ * Newton's third law: Every pair of bodies is evaluated
+ * once and acts on both bodies. This is the triangle
+ * method of kernels.md.
+ *
+ * @file symmetricKernels.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+namespace symmetric {
+
+/** First pair of a row of the triangle
+ *
+ * The pairs (i,j) with i < j are numbered row by row,
+ * row i has numBodies - 1 - i pairs.
+ */
+template<
+    typename TSize>
+ALPAKA_FN_HOST_ACC auto rowBegin(
+    TSize const row,
+    TSize const numBodies)
+-> TSize
+{
+    return row * ( 2 * numBodies - row - 1 ) / 2;
+}
+
+} // namespace symmetric
+
+/** Class containing the Symmetric Pair Kernel
+ *
+ * The N (N - 1) / 2 pairs are split into one contiguous range
+ * of equal length per thread, so every thread does the same
+ * work although the rows of the triangle differ in length.
+ * A thread owns one row of numBodies partial accelerations.
+ * It adds the interaction of a pair to the first body in a
+ * register and subtracts it from the second in its row, so
+ * no atomics are needed. The SymmetricMergeKernel sums up
+ * the rows.
+ *
+ * Has to be started with one element per thread.
+ *
+ * The law is evaluated once per pair with a unit mass and
+ * scaled by the mass of either body, so it has to be
+ * proportional to the mass of the influencing body and odd
+ * in positionRelative, like all laws in forceLaws.
+ *
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicSymmetricPairKernel
+{
+public:
+    /** Symmetric Pair Kernel
+     *
+     * Like in the ForceMatrixKernel the gravitationalConstant
+     * is not applied here. This is done by the UpdatePositionsKernel.
+     *
+     * @param bodies positions and masses of the bodies
+     * @param numBodies number of bodies
+     * @param numPartitions number of threads
+     * @param smoothnessFactor Smoothness Factor
+     * @param partialAcceleration numPartitions rows of numBodies
+     *        partial accelerations/G
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        TSize const & numBodies,
+        TSize const & numPartitions,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const partialAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        TSize const partition(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+        if( partition >= numPartitions )
+            return;
+
+        types::Vector<NDim,TElem> * const partial(
+                partialAcceleration + partition * numBodies );
+        for( TSize i( 0 ); i < numBodies; i++ )
+            partial[ i ] = types::Vector<NDim,TElem>( static_cast<TElem>( 0 ) );
+
+        TSize const numPairs( symmetric::rowBegin( numBodies, numBodies ) );
+        TSize const pairBegin( numPairs * partition / numPartitions );
+        TSize const pairEnd( numPairs * ( partition + 1 ) / numPartitions );
+        if( pairBegin >= pairEnd )
+            return;
+
+        // last row which begins before the first pair
+        TSize rowFirst( 0 );
+        TSize rowLast( numBodies - 1 );
+        while( rowFirst < rowLast )
+        {
+            TSize const row( ( rowFirst + rowLast + 1 ) / 2 );
+            if( symmetric::rowBegin( row, numBodies ) <= pairBegin )
+                rowFirst = row;
+            else
+                rowLast = row - 1;
+        }
+
+        TSize pair( pairBegin );
+        for( TSize row( rowFirst ); pair < pairEnd; row++ )
+        {
+            TSize const rowEnd( symmetric::rowBegin( row + 1, numBodies ) );
+            TSize const columnBegin(
+                    row + 1 + pair - symmetric::rowBegin( row, numBodies ) );
+            TSize const columnEnd(
+                    columnBegin + ( ( rowEnd < pairEnd ) ? rowEnd : pairEnd ) - pair );
+
+            types::Vector<NDim,TElem> const positionRow(
+                    bodies.getPosition( row ) );
+            TElem const massRow( bodies.getMass( row ) );
+            types::Vector<NDim,TElem> accelerationRow(
+                    static_cast<TElem>( 0 ) );
+
+            for( TSize column( columnBegin ); column < columnEnd; column++ )
+            {
+                // position of the column relative to the row body
+                // ( direction of force on the row body )
+                types::Vector<NDim,TElem> const positionRelative(
+                        bodies.getPosition( column ) - positionRow );
+
+                // acceleration/G due to a unit mass
+                types::Vector<NDim,TElem> const interaction(
+                        TForceLaw::interaction(
+                            acc,
+                            positionRelative,
+                            static_cast<TElem>( 1 ),
+                            smoothnessFactor ) );
+
+                accelerationRow += bodies.getMass( column ) * interaction;
+                partial[ column ] -= massRow * interaction;
+            }
+
+            partial[ row ] += accelerationRow;
+            pair += columnEnd - columnBegin;
+        }
+    }
+};
+
+using SymmetricPairKernel = BasicSymmetricPairKernel<forceLaws::Plummer>;
+
+/** Class containing the Symmetric Merge Kernel
+ *
+ * bodiesAcceleration[i] = sum of partialAcceleration[p * numBodies + i]
+ */
+class SymmetricMergeKernel
+{
+public:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const partialAcceleration,
+        TSize const & numBodies,
+        TSize const & numPartitions,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> acceleration(
+                    partialAcceleration[ indexBody ] );
+            for( TSize partition( 1 ); partition < numPartitions; partition++ )
+                acceleration +=
+                    partialAcceleration[ partition * numBodies + indexBody ];
+            bodiesAcceleration[ indexBody ] = acceleration;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
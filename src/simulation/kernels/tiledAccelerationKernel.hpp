@@ -0,0 +1,237 @@
+/** Kernel for the tiled calculation of accelerations
+ *
+ * This file implements an Alpaka Kernel
+ * for the n body simulation. It calculates the
+ * same accelerations as the AccelerationKernel but
+ * loads the influencing bodies tile by tile into
+ * shared memory, where every thread of the block
+ * reuses them.
+ *
+ * @file tiledAccelerationKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Tiled Acceleration Kernel
+ *
+ * The classic all-pairs tiling: The block loads TTileSize
+ * influencing bodies into shared memory, synchronizes, and
+ * every thread interacts its influenced bodies with the whole
+ * tile before the next tile is loaded.
+ *
+ * A thread keeps TSinksPerPass influenced bodies in registers,
+ * so every loaded influencing body is used TSinksPerPass times.
+ * If a thread has more elements, it needs several passes.
+ * This is what gives the block backends with only one thread
+ * per block their reuse.
+ *
+ * @tparam TTileSize number of influencing bodies per tile
+ * @tparam TSinksPerPass influenced bodies per thread and pass
+ * @tparam TForceLaw interaction of two bodies, see forceLaws
+ */
+template<
+    std::size_t TTileSize,
+    std::size_t TSinksPerPass = 4,
+    typename TForceLaw = forceLaws::Plummer>
+class TiledAccelerationKernel
+{
+public:
+    /** Tiled Acceleration Kernel
+     *
+     * Like in the ForceMatrixKernel the gravitationalConstant
+     * is not applied here. This is done by the UpdatePositionsKernel.
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam TLayout storage layout of the bodies
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param bodies positions and masses of the bodies
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     * @param numBodies number of bodies
+     * @param smoothnessFactor Smoothness Factor
+     *
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TLayout,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        types::Vector<NDim,TElem> * const tilePosition(
+                alpaka::block::shared::allocArr<
+                    types::Vector<NDim,TElem>,
+                    TTileSize>( acc ));
+        TElem * const tileMass(
+                alpaka::block::shared::allocArr<
+                    TElem,
+                    TTileSize>( acc ));
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const blockThreads(
+                alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>
+                    ( acc )[0u]);
+        auto const blockThreadIdx(
+                alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        TSize const threadFirstBody( gridThreadIdx * threadElemExtent );
+
+        // Every thread of the block does the same number of passes
+        // and tiles, otherwise the barriers would deadlock.
+        for( TSize passFirstElem( 0 );
+             passFirstElem < threadElemExtent;
+             passFirstElem += TSinksPerPass )
+        {
+            types::Vector<NDim,TElem> positionInfluenced[ TSinksPerPass ];
+            types::Vector<NDim,TElem> acceleration[ TSinksPerPass ];
+
+            for( std::size_t s( 0 ); s < TSinksPerPass; s++ )
+            {
+                TSize const indexBodyInfluenced(
+                        threadFirstBody + passFirstElem + s );
+                acceleration[ s ] =
+                    types::Vector<NDim,TElem>( static_cast<TElem>(0) );
+                positionInfluenced[ s ] =
+                    ( indexBodyInfluenced < numBodies ) ?
+                    bodies.getPosition( indexBodyInfluenced ) :
+                    types::Vector<NDim,TElem>( static_cast<TElem>(0) );
+            }
+
+            for( TSize tileBegin( 0 );
+                 tileBegin < numBodies;
+                 tileBegin += TTileSize )
+            {
+                TSize const tileLength(
+                        ( numBodies - tileBegin < TTileSize ) ?
+                        numBodies - tileBegin :
+                        static_cast<TSize>( TTileSize ) );
+
+                // Load the tile cooperatively
+                for( TSize i( blockThreadIdx );
+                     i < tileLength;
+                     i += blockThreads )
+                {
+                    tilePosition[ i ] = bodies.getPosition( tileBegin + i );
+                    tileMass[ i ] = bodies.getMass( tileBegin + i );
+                }
+
+                alpaka::block::sync::syncBlockThreads( acc );
+
+                for( TSize i( 0 ); i < tileLength; i++ )
+                {
+                    types::Vector<NDim,TElem> const positionInfluencing(
+                            tilePosition[ i ] );
+                    TElem const massInfluencing( tileMass[ i ] );
+
+                    for( std::size_t s( 0 ); s < TSinksPerPass; s++ )
+                    {
+                        // the force matrix has zeros on its diagonal
+                        if( tileBegin + i ==
+                                threadFirstBody + passFirstElem + s )
+                            continue;
+
+                        // position of influencing relative to
+                        // influenced body ( direction of force )
+                        types::Vector<NDim,TElem> const positionRelative(
+                                positionInfluencing -
+                                positionInfluenced[ s ] );
+
+                        acceleration[ s ] += TForceLaw::interaction(
+                                acc,
+                                positionRelative,
+                                massInfluencing,
+                                smoothnessFactor );
+                    }
+                }
+
+                // The tile must not be overwritten while others use it
+                alpaka::block::sync::syncBlockThreads( acc );
+            }
+
+            for( std::size_t s( 0 ); s < TSinksPerPass; s++ )
+            {
+                TSize const indexBodyInfluenced(
+                        threadFirstBody + passFirstElem + s );
+                if( passFirstElem + s < threadElemExtent &&
+                    indexBodyInfluenced < numBodies )
+                {
+                    bodiesAcceleration[ indexBodyInfluenced ] =
+                        acceleration[ s ];
+                }
+            }
+        }
+    }
+
+    /** Tiled Acceleration Kernel for separate arrays
+     *
+     * @param bodiesPosition array of the bodies' position
+     * @param bodiesMass array of the bodies' mass
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        types::Vector<NDim,TElem> * const bodiesAcceleration,
+        TSize const & numBodies,
+        TFactor const & smoothnessFactor ) const
+    -> void
+    {
+        // the kernel only reads the bodies
+        (*this)(
+            acc,
+            types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                const_cast<TElem *>( bodiesMass ) ),
+            bodiesAcceleration,
+            numBodies,
+            smoothnessFactor );
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
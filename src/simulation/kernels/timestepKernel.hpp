@@ -0,0 +1,123 @@
+/** Kernel for the timestep criteria of the bodies
+ *
+ * This file implements an Alpaka Kernel which
+ * calculates the largest safe step of every body.
+ * The ReduceKernel takes the minimum of them.
+ *
+ * @file timestepKernel.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Timestep Kernel
+ *
+ * The step of body i is the minimum of
+ *
+ *     maxStep,
+ *     eta * sqrt( length / |G a_i| ),
+ *     eta * length / |v_i|,
+ *
+ * so a body may neither be accelerated nor move much
+ * further than length times eta.
+ */
+class TimestepKernel
+{
+public:
+    /** Timestep Kernel
+     *
+     * @param accelerations acceleration/G of body i in the first
+     *        element of row i, like the UpdatePositionsKernel reads it
+     * @param pitchBytesAccelerations bytes between two rows
+     * @param bodiesVelocity velocities of the bodies
+     * @param numBodies number of bodies
+     * @param gravitationalConstant gravitational constant
+     * @param eta accuracy factor
+     * @param length length scale, e.g. the softening length
+     * @param maxStep upper bound of the steps
+     * @param steps array for the steps of the bodies
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::Vector<NDim,TElem> const * const accelerations,
+        TSize const & pitchBytesAccelerations,
+        types::Vector<NDim,TElem> const * const bodiesVelocity,
+        TSize const & numBodies,
+        TGrav const & gravitationalConstant,
+        TElem const & eta,
+        TElem const & length,
+        TElem const & maxStep,
+        TElem * const steps) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const acceleration(
+                    static_cast<TElem>( gravitationalConstant ) *
+                    *(types::Vector<NDim,TElem> const *)(
+                        (char const *)accelerations +
+                        indexBody * pitchBytesAccelerations ) );
+            TElem const accelerationSq( acceleration.absSq() );
+            TElem const velocitySq( bodiesVelocity[ indexBody ].absSq() );
+
+            TElem step( maxStep );
+            if( accelerationSq > static_cast<TElem>( 0 ) )
+            {
+                // sqrt( length / |a| ) = sqrt( length ) / |a|^(1/4)
+                TElem const stepAcceleration( eta *
+                        alpaka::math::sqrt( acc, length *
+                            alpaka::math::rsqrt( acc, accelerationSq ) ) );
+                if( stepAcceleration < step )
+                    step = stepAcceleration;
+            }
+            if( velocitySq > static_cast<TElem>( 0 ) )
+            {
+                TElem const stepVelocity( eta * length *
+                        alpaka::math::rsqrt( acc, velocitySq ) );
+                if( stepVelocity < step )
+                    step = stepVelocity;
+            }
+            steps[ indexBody ] = step;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,403 @@
+/** Kernels for the construction of the tree
+ *
+ * This file implements the Alpaka Kernels which
+ * build the 2^NDim-ary tree of the tree code level
+ * by level and calculate the moments of the nodes.
+ * The bodies have to be sorted by their Morton keys.
+ *
+ * @file treeKernels.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/treeNode.hpp> // TreeNode
+// morton::Key, morton::Depth
+#include <simulation/kernels/mortonKeyKernel.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Tree Root Kernel
+ *
+ * Has to be started with a single thread.
+ */
+class TreeRootKernel
+{
+public:
+    /** Tree Root Kernel
+     *
+     * @param nodes array of the nodes
+     * @param boxMin minimum of all positions
+     * @param boxMax maximum of all positions
+     * @param numBodies number of bodies
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const &,
+        types::TreeNode<NDim,TElem,TSize> * const nodes,
+        types::Vector<NDim,TElem> const * const boxMin,
+        types::Vector<NDim,TElem> const * const boxMax,
+        TSize const & numBodies) const
+    -> void
+    {
+        TElem boxSize( 0 );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+        {
+            TElem const extent( (*boxMax)[ d ] - (*boxMin)[ d ] );
+            if( boxSize < extent )
+                boxSize = extent;
+        }
+
+        nodes[ 0 ].begin = 0;
+        nodes[ 0 ].end = numBodies;
+        nodes[ 0 ].firstChild = 0;
+        nodes[ 0 ].size = boxSize;
+    }
+};
+
+/** Class containing the Tree Split Kernel
+ *
+ * Marks the nodes of one level which get children.
+ */
+class TreeSplitKernel
+{
+public:
+    /** Tree Split Kernel
+     *
+     * @param nodes array of the nodes
+     * @param levelBegin index of the first node of the level
+     * @param levelSize number of nodes of the level
+     * @param level depth of the level, 0 is the root
+     * @param leafSize maximum number of bodies of a leaf
+     * @param split array of levelSize flags
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        TSize const & levelBegin,
+        TSize const & levelSize,
+        TSize const & level,
+        TSize const & leafSize,
+        TSize * const split) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < levelSize;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> const & node(
+                    nodes[ levelBegin + indexNode ] );
+            split[ indexNode ] = (
+                    node.end - node.begin > leafSize &&
+                    level < morton::Depth<NDim>::value ) ? 1 : 0;
+        }
+    }
+};
+
+/** Class containing the Tree Children Kernel
+ *
+ * Creates the children of the nodes of one level.
+ * The offsets are the exclusive prefix sum of the
+ * flags of the TreeSplitKernel.
+ */
+class TreeChildrenKernel
+{
+public:
+    /** Tree Children Kernel
+     *
+     * @param nodes array of the nodes
+     * @param keys sorted Morton keys of the bodies
+     * @param levelBegin index of the first node of the level
+     * @param levelSize number of nodes of the level
+     * @param level depth of the level, 0 is the root
+     * @param leafSize maximum number of bodies of a leaf
+     * @param offsets number of split nodes before each node
+     * @param nextLevelBegin index of the first node of the next level
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::TreeNode<NDim,TElem,TSize> * const nodes,
+        morton::Key const * const keys,
+        TSize const & levelBegin,
+        TSize const & levelSize,
+        TSize const & level,
+        TSize const & leafSize,
+        TSize const * const offsets,
+        TSize const & nextLevelBegin) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const numChildren(
+                types::TreeNode<NDim,TElem,TSize>::numChildren );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < levelSize;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> & node(
+                    nodes[ levelBegin + indexNode ] );
+
+            // same condition as in the TreeSplitKernel
+            if( !( node.end - node.begin > leafSize &&
+                   level < morton::Depth<NDim>::value ) )
+            {
+                node.firstChild = 0;
+                continue;
+            }
+
+            TSize const firstChild( nextLevelBegin +
+                    offsets[ indexNode ] * numChildren );
+            node.firstChild = firstChild;
+
+            // bits below the digit of the children
+            std::size_t const shift( NDim *
+                    ( morton::Depth<NDim>::value - level - 1 ) );
+            morton::Key const prefix(
+                    keys[ node.begin ] >> ( shift + NDim ) );
+
+            TSize childBegin( node.begin );
+            for( std::size_t child( 0 ); child < numChildren; child++ )
+            {
+                // first body which belongs to a later child
+                TSize childEnd( node.end );
+                if( child + 1 < numChildren )
+                {
+                    morton::Key const nextKey(
+                            ( ( prefix << NDim ) | ( child + 1 ) ) << shift );
+                    TSize low( childBegin );
+                    TSize high( node.end );
+                    while( low < high )
+                    {
+                        TSize const middle( low + ( high - low ) / 2 );
+                        if( keys[ middle ] < nextKey )
+                            low = middle + 1;
+                        else
+                            high = middle;
+                    }
+                    childEnd = low;
+                }
+
+                types::TreeNode<NDim,TElem,TSize> & childNode(
+                        nodes[ firstChild + child ] );
+                childNode.begin = childBegin;
+                childNode.end = childEnd;
+                childNode.firstChild = 0;
+                childNode.size = node.size / static_cast<TElem>(2);
+
+                childBegin = childEnd;
+            }
+        }
+    }
+};
+
+/** Class containing the Tree Moments Kernel
+ *
+ * Calculates the mass and the center of mass of the
+ * nodes of one level and, if TQuadrupole is set, their
+ * quadrupole moment Q = sum m * ( 3 d d^T - |d|^2 I ) with
+ * d relative to the center of mass.
+ * The levels have to be processed from the deepest one
+ * up to the root.
+ *
+ * @tparam TQuadrupole calculate the quadrupole moments
+ */
+template<
+    bool TQuadrupole>
+class TreeMomentsKernel
+{
+public:
+    /** Tree Moments Kernel
+     *
+     * @param nodes array of the nodes
+     * @param quadrupoles array of the quadrupole moments,
+     *        row major NDim x NDim, unused without TQuadrupole
+     * @param bodiesPosition sorted positions
+     * @param bodiesMass sorted masses
+     * @param levelBegin index of the first node of the level
+     * @param levelSize number of nodes of the level
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::TreeNode<NDim,TElem,TSize> * const nodes,
+        types::Vector<NDim*NDim,TElem> * const quadrupoles,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const & levelBegin,
+        TSize const & levelSize) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const numChildren(
+                types::TreeNode<NDim,TElem,TSize>::numChildren );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadNode = 0,
+            indexNode = levelBegin + gridThreadIdx * threadElemExtent;
+            threadNode < threadElemExtent &&
+            indexNode < levelBegin + levelSize;
+            threadNode++,
+            indexNode++)
+        {
+            types::TreeNode<NDim,TElem,TSize> & node( nodes[ indexNode ] );
+            bool const leaf( node.firstChild == 0 );
+
+            TElem mass( 0 );
+            types::Vector<NDim,TElem> weighted( static_cast<TElem>(0) );
+            if( leaf )
+            {
+                for( TSize i( node.begin ); i < node.end; i++ )
+                {
+                    mass += bodiesMass[ i ];
+                    weighted += bodiesMass[ i ] * bodiesPosition[ i ];
+                }
+            }
+            else
+            {
+                for( std::size_t c( 0 ); c < numChildren; c++ )
+                {
+                    types::TreeNode<NDim,TElem,TSize> const & child(
+                            nodes[ node.firstChild + c ] );
+                    mass += child.mass;
+                    weighted += child.mass * child.centerOfMass;
+                }
+            }
+
+            node.mass = mass;
+            if( mass > static_cast<TElem>(0) )
+                node.centerOfMass = weighted / mass;
+            else if( node.end > node.begin )
+                node.centerOfMass = bodiesPosition[ node.begin ];
+            else
+                node.centerOfMass =
+                    types::Vector<NDim,TElem>( static_cast<TElem>(0) );
+
+            if( !TQuadrupole )
+                continue;
+
+            // Inner nodes shift the moments of their children
+            // (parallel axis theorem).
+            types::Vector<NDim*NDim,TElem> quadrupole(
+                    static_cast<TElem>(0) );
+            if( leaf )
+            {
+                for( TSize i( node.begin ); i < node.end; i++ )
+                {
+                    addPointQuadrupole(
+                            quadrupole,
+                            bodiesPosition[ i ] - node.centerOfMass,
+                            bodiesMass[ i ] );
+                }
+            }
+            else
+            {
+                for( std::size_t c( 0 ); c < numChildren; c++ )
+                {
+                    TSize const indexChild( node.firstChild + c );
+                    quadrupole += quadrupoles[ indexChild ];
+                    addPointQuadrupole(
+                            quadrupole,
+                            nodes[ indexChild ].centerOfMass -
+                                node.centerOfMass,
+                            nodes[ indexChild ].mass );
+                }
+            }
+            quadrupoles[ indexNode ] = quadrupole;
+        }
+    }
+
+private:
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        std::size_t NDim,
+        typename TElem>
+    ALPAKA_FN_ACC static auto addPointQuadrupole(
+        types::Vector<NDim*NDim,TElem> & quadrupole,
+        types::Vector<NDim,TElem> const & distance,
+        TElem const & mass)
+    -> void
+    {
+        TElem const distanceSq( distance.absSq() );
+        for( std::size_t a( 0 ); a < NDim; a++ )
+        {
+            for( std::size_t b( 0 ); b < NDim; b++ )
+            {
+                quadrupole[ a * NDim + b ] += mass * (
+                        static_cast<TElem>(3) * distance[ a ] * distance[ b ] -
+                        ( ( a == b ) ? distanceSq : static_cast<TElem>(0) ) );
+            }
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,218 @@
+/** Kernel for the tree walk of the tree code
+ *
+ * This file implements the Alpaka Kernel which
+ * calculates the accelerations by walking the tree
+ * built by the tree kernels (Barnes-Hut).
+ *
+ * @file treeWalkKernel.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
+#include <alpaka/alpaka.hpp>
+#include <simulation/types/vector.hpp> // Vector
+#include <simulation/types/treeNode.hpp> // TreeNode
+#include <simulation/kernels/mortonKeyKernel.hpp> // morton::Depth
+
+namespace nbody {
+
+namespace simulation {
+
+namespace kernels {
+
+/** Class containing the Tree Walk Kernel
+ *
+ * @tparam TQuadrupole add the quadrupole moments of the
+ *         accepted nodes to the monopole approximation
+ */
+template<
+    bool TQuadrupole>
+class TreeWalkKernel
+{
+public:
+    /** Tree Walk Kernel
+     *
+     * Every thread walks the tree for threadElemExtent bodies
+     * with an explicit stack. A node is approximated by its
+     * moments if size < theta * distance and the body is not
+     * one of its own, otherwise its children are visited.
+     * The bodies of leaves are summed up directly with the
+     * formula of the ForceMatrixKernel.
+     *
+     * The bodies are processed in the sorted order, the
+     * accelerations are written in the original order.
+     * Like in the ForceMatrixKernel the gravitationalConstant
+     * is not applied here.
+     *
+     * @tparam TAcc Accelerator type
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @param acc the accelerator
+     * @param nodes array of the nodes, the root is node 0
+     * @param quadrupoles quadrupole moments of the nodes
+     * @param bodiesPosition sorted positions
+     * @param bodiesMass sorted masses
+     * @param permutation original index of every sorted body
+     * @param numBodies number of bodies
+     * @param theta opening angle
+     * @param smoothnessFactor Smoothness Factor
+     * @param bodiesAcceleration array for the bodies' acceleration/G
+     */
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TFactor>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        types::TreeNode<NDim,TElem,TSize> const * const nodes,
+        types::Vector<NDim*NDim,TElem> const * const quadrupoles,
+        types::Vector<NDim,TElem> const * const bodiesPosition,
+        TElem const * const bodiesMass,
+        TSize const * const permutation,
+        TSize const & numBodies,
+        TElem const & theta,
+        TFactor const & smoothnessFactor,
+        types::Vector<NDim,TElem> * const bodiesAcceleration) const
+    -> void
+    {
+        static_assert(
+                alpaka::dim::Dim<TAcc>::value == 1,
+                "This kernel required 1-dimensional indices");
+
+        std::size_t const numChildren(
+                types::TreeNode<NDim,TElem,TSize>::numChildren );
+        // every level leaves at most numChildren - 1 nodes behind
+        std::size_t const stackSize(
+                morton::Depth<NDim>::value * ( numChildren - 1 ) + 1 );
+
+        TElem const thetaSq( theta * theta );
+
+        auto const threadElemExtent(
+                alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>
+                    ( acc )[0u]);
+        auto const gridThreadIdx(
+                alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>
+                    ( acc )[0u]);
+
+        for( TSize threadBody = 0,
+            indexBody = gridThreadIdx * threadElemExtent;
+            threadBody < threadElemExtent &&
+            indexBody < numBodies;
+            threadBody++,
+            indexBody++)
+        {
+            types::Vector<NDim,TElem> const positionInfluenced(
+                    bodiesPosition[ indexBody ] );
+
+            types::Vector<NDim,TElem> acceleration(
+                    static_cast<TElem>(0) );
+
+            TSize stack[ stackSize ];
+            std::size_t stackTop( 0 );
+            stack[ stackTop++ ] = 0;
+
+            while( stackTop > 0 )
+            {
+                TSize const indexNode( stack[ --stackTop ] );
+                types::TreeNode<NDim,TElem,TSize> const & node(
+                        nodes[ indexNode ] );
+
+                if( node.end == node.begin )
+                    continue;
+
+                bool const ownNode( indexBody >= node.begin &&
+                        indexBody < node.end );
+
+                types::Vector<NDim,TElem> const positionRelative(
+                        node.centerOfMass - positionInfluenced );
+                TElem const distSq( positionRelative.absSq() );
+
+                if( !ownNode && node.size * node.size < thetaSq * distSq )
+                {
+                    // Distance squared + smoothnessFactor
+                    TElem const dist( distSq + smoothnessFactor );
+                    TElem const rdist( alpaka::math::rsqrt( acc, dist ) );
+                    TElem const rdistCb( rdist * rdist * rdist );
+
+                    acceleration += ( node.mass * rdistCb ) *
+                        positionRelative;
+
+                    if( TQuadrupole )
+                    {
+                        types::Vector<NDim*NDim,TElem> const & quadrupole(
+                                quadrupoles[ indexNode ] );
+                        TElem const rdist5( rdistCb * rdist * rdist );
+                        TElem const rdist7( rdist5 * rdist * rdist );
+
+                        // Q p and p^T Q p
+                        types::Vector<NDim,TElem> qp(
+                                static_cast<TElem>(0) );
+                        TElem pqp( 0 );
+                        for( std::size_t a( 0 ); a < NDim; a++ )
+                        {
+                            for( std::size_t b( 0 ); b < NDim; b++ )
+                            {
+                                qp[ a ] += quadrupole[ a * NDim + b ] *
+                                    positionRelative[ b ];
+                            }
+                            pqp += positionRelative[ a ] * qp[ a ];
+                        }
+
+                        acceleration += ( static_cast<TElem>(2.5) *
+                                pqp * rdist7 ) * positionRelative;
+                        acceleration += ( -rdist5 ) * qp;
+                    }
+                }
+                else if( node.firstChild == 0 )
+                {
+                    for( TSize indexBodyInfluencing( node.begin );
+                         indexBodyInfluencing < node.end;
+                         indexBodyInfluencing++ )
+                    {
+                        if( indexBodyInfluencing == indexBody )
+                            continue;
+
+                        types::Vector<NDim,TElem> const bodyRelative(
+                                bodiesPosition[ indexBodyInfluencing ] -
+                                positionInfluenced );
+
+                        auto const dist(
+                                bodyRelative.absSq() +
+                                smoothnessFactor);
+
+                        auto const distCb(dist*dist*dist);
+
+                        auto const rdistCb(alpaka::math::rsqrt(acc,distCb));
+
+                        TElem const forceFactor(
+                                bodiesMass[indexBodyInfluencing] *
+                                rdistCb);
+
+                        acceleration += forceFactor * bodyRelative;
+                    }
+                }
+                else
+                {
+                    for( std::size_t child( 0 ); child < numChildren; child++ )
+                    {
+                        stack[ stackTop++ ] = node.firstChild + child;
+                    }
+                }
+            }
+
+            bodiesAcceleration[ permutation[ indexBody ] ] = acceleration;
+        }
+    }
+};
+
+} // namespace kernels
+
+} // namespace simulation
+
+} // namespace nbody
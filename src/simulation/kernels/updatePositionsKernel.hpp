@@ -14,6 +14,7 @@
 // alpaka, ALPAKA_FN_ACC, ALPAKA_NO_HOST_ACC_WARNING
 #include <alpaka/alpaka.hpp>
 #include <simulation/types/vector.hpp> //vector
+#include <simulation/types/bodies.hpp> // Bodies, layouts
 
 namespace nbody {
 
@@ -32,6 +33,7 @@ public:
 	ALPAKA_NO_HOST_ACC_WARNING
 	template<
         typename TAcc,
+        typename TLayout,
         std::size_t NDim,
         typename TElem,
         typename TSize,
@@ -41,7 +43,7 @@ public:
     ALPAKA_FN_ACC auto operator()(
 		TAcc const & acc,
 		types::Vector<NDim,TElem> const * const forceMatrix,
-		types::Vector<NDim, TElem> * const bodiesPosition,
+		types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
 		types::Vector<NDim,TElem> * const bodiesVelocity,
         TSize const & pitchSizeForceMatrix,
         TSize const & numBodies,
@@ -80,12 +82,48 @@ public:
             //acceleration/G is stored in first element of line
             types::Vector<NDim,TElem> acceleration(beginOfLine[0]*gravitationalConstant);
             //calculate new position p=a/2*dt² +v*dt + p_0
-            bodiesPosition[p]+= (0.5f*acceleration*dt + bodiesVelocity[p])*dt;
+            bodies.setPosition(p, bodies.getPosition(p) +
+                    (0.5f*acceleration*dt + bodiesVelocity[p])*dt);
             //calculate velocity v=a*dt
             bodiesVelocity[p]+=acceleration*dt;
 		
 	    }
     }
+
+    //Update Positions Kernel for a separate array of positions
+	ALPAKA_NO_HOST_ACC_WARNING
+	template<
+        typename TAcc,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize,
+        typename TGrav,
+        typename TTime
+    >
+    ALPAKA_FN_ACC auto operator()(
+		TAcc const & acc,
+		types::Vector<NDim,TElem> const * const forceMatrix,
+		types::Vector<NDim, TElem> * const bodiesPosition,
+		types::Vector<NDim,TElem> * const bodiesVelocity,
+        TSize const & pitchSizeForceMatrix,
+        TSize const & numBodies,
+        TGrav const & gravitationalConstant,
+		TTime const & dt
+		) const
+	->void
+	{
+        //the masses are not needed
+        (*this)(
+            acc,
+            forceMatrix,
+            types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                bodiesPosition, nullptr),
+            bodiesVelocity,
+            pitchSizeForceMatrix,
+            numBodies,
+            gravitationalConstant,
+            dt);
+    }
 };
 
 } // namespace kernels
@@ -1,104 +1,400 @@
 #pragma once
 
 #include <alpaka/alpaka.hpp>
-// ForceMatrixKernel
-#include <simulation/kernels/forceMatrixKernel.hpp>
-// AddKernel
-#include <simulation/kernels/addKernel.hpp>
-//updatePositionKernel
-#include <simulation/kernels/updatePositionsKernel.hpp>
+// ForceMatrix, Fused, Tiled, Simd, Mixed, Symmetric, SourcesSinks,
+// BarnesHut, Fmm, ParticleMesh, P3m
+#include <simulation/solvers/solvers.hpp>
+// Euler, Leapfrog, ForestRuth, Hermite, BlockSteps
+#include <simulation/integrators/integrators.hpp>
+// Timestep
+#include <simulation/algorithms/timestep.hpp>
+// Reorder
+#include <simulation/algorithms/reorder.hpp>
 // Vector
 #include <simulation/types/vector.hpp> 
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+#include <algorithm> // std::fill
+#include <memory> // std::unique_ptr
+#include <ostream> // std::ostream
+#include <type_traits> // std::is_same, std::integral_constant, std::true_type
+#include <vector> // std::vector
 
 #if defined(ALPAKA_ACC_GPU_CUDA_ENABLED)
     #define ACC_FORCEM alpaka::acc::AccGpuCudaRt<alpaka::dim::DimInt<2u>,std::size_t>
     #define ACC_UPDATEP alpaka::acc::AccGpuCudaRt<alpaka::dim::DimInt<1u>,std::size_t>
-    #define STREAM alpaka::stream::StreamCudaRtSync
+    #define STREAM alpaka::stream::StreamCudaRtAsync
+    #define STREAM_READBACK alpaka::stream::StreamCudaRtAsync
 #elif defined(ALPAKA_ACC_CPU_BT_OMP4_ENABLE)
     #define ACC_FORCEM alpaka::acc::AccCpuOmp4<alpaka::dim::DimInt<2u>,std::size_t>
     #define ACC_UPDATEP alpaka::acc::AccCpuOmp4<alpaka::dim::DimInt<1u>,std::size_t>
-    #define STREAM alpaka::stream::StreamCpuSync
+    #define STREAM alpaka::stream::StreamCpuAsync
+    #define STREAM_READBACK alpaka::stream::StreamCpuAsync
 #elif defined(ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED)
     #define ACC_FORCEM alpaka::acc::AccCpuOmp2Blocks<alpaka::dim::DimInt<2u>,std::size_t>
     #define ACC_UPDATEP alpaka::acc::AccCpuOmp2Blocks<alpaka::dim::DimInt<1u>,std::size_t>
-    #define STREAM alpaka::stream::StreamCpuSync
+    #define STREAM alpaka::stream::StreamCpuAsync
+    #define STREAM_READBACK alpaka::stream::StreamCpuAsync
 #else
     #define ACC_FORCEM alpaka::acc::AccCpuSerial<alpaka::dim::DimInt<2u>,std::size_t>
     #define ACC_UPDATEP alpaka::acc::AccCpuSerial<alpaka::dim::DimInt<1u>,std::size_t>
-    #define STREAM alpaka::stream::StreamCpuSync
+    #define STREAM alpaka::stream::StreamCpuAsync
+    #define STREAM_READBACK alpaka::stream::StreamCpuAsync
 #endif
     
 namespace nbody {
 
 namespace simulation {
+
+    //true for the solvers which build the whole N x N force matrix
+    template<typename TSolver>
+    struct IsForceMatrix : std::false_type {};
+
+    template<typename TForceLaw>
+    struct IsForceMatrix< solvers::BasicForceMatrix<TForceLaw> > :
+        std::true_type {};
     
     /** Class Simulation
      *
      * This Class provides an esay interface to the N-body simulation
+     *
+     * The solver calculates the accelerations. solvers::ForceMatrix
+     * builds the whole N x N force matrix, solvers::Fused sums up
+     * the interactions directly and only needs O(N) memory.
+     * solvers::Tiled additionally shares the influencing bodies
+     * of a block in shared memory. solvers::Simd vectorises the
+     * interactions on the CPU, solvers::Symmetric evaluates every
+     * pair only once. solvers::BarnesHut approximates
+     * distant groups of bodies with a tree, solvers::Fmm uses
+     * the fast multipole method on the same tree and runs in linear
+     * time. solvers::ParticleMesh solves the Poisson equation on a
+     * grid with FFTs for large, smooth mass distributions,
+     * solvers::P3m adds the short range forces directly.
+     * solvers::Ring splits the direct sum over all devices of the
+     * node and passes the bodies on between them in a ring. Their
+     * parameters can be set through the public member solver.
+     * The direct summation solvers, like solvers::BasicFused, and
+     * integrators::BasicBlockSteps take the force law as a
+     * template parameter, see kernels::forceLaws.
+     *
+     * The positions and masses are stored on the accelerator in
+     * the layout TLayout, see types::layouts. The host arrays are
+     * always AoS and are converted once. The direct summation
+     * solvers read every layout, the others get separate arrays.
+     *
+     * The integrator TIntegrator moves the bodies. integrators::Euler
+     * is the original first order update, integrators::Leapfrog and
+     * integrators::ForestRuth are symplectic of second and fourth
+     * order, so they keep the energy with much larger steps.
+     * integrators::Hermite is a fourth order predictor-corrector
+     * for collisional systems, it sums up the forces and jerks
+     * directly and does not use the solver.
+     * integrators::BlockSteps gives every body its own power of two
+     * step and only evaluates the forces on the bodies which need them.
+     * Neither calls the solver in a step, but the simulation builds
+     * it and uses it for the first adaptive step, so they have to
+     * be paired with a solver of O(N) memory like solvers::Fused.
+     * With the force matrix solvers they do not compile.
+     *
+     * For tracer runs the first numMassive bodies are the massive
+     * ones, all bodies after them are massless tracers. Their masses
+     * are stored as zero, so every solver leaves them out, and
+     * solvers::SourcesSinks does not even read them as sources.
+     *
+     * With reorder.interval = k the bodies are sorted along a
+     * Hilbert curve every k steps on the accelerator, so the
+     * kernels read bodies which are close in space from close
+     * addresses. getPositions and the snapshots still return the
+     * bodies in the original order. Integrators with per-body
+     * state start again after a reordering, integrators::BlockSteps
+     * assigns the levels of the bodies anew.
+     *
+     * If the accelerator runs on the host and the layout is AoS,
+     * the kernels work in place on the caller's position and
+     * velocity arrays, so the bodies are neither stored twice
+     * nor copied, and getPositions only waits for the steps. The
+     * arrays change with every step then. Only the masses are
+     * copied once, because the tracers have to read zero. The
+     * first reordering leaves this mode and copies the bodies,
+     * so does disableZeroCopy().
+     *
+     * This mode is chosen automatically and is the default of the
+     * CPU backends. Earlier versions copied the arrays in the
+     * constructor and only wrote the positions in getPositions.
+     * Now the steps write both arrays, and the positions change
+     * between two calls of getPositions. Code which reuses one
+     * set of initial conditions for several simulations has to
+     * pass every simulation its own arrays, or call
+     * disableZeroCopy() right after the constructor, before the
+     * first step.
+     *
+     * getPositions waits for the steps and copies the positions.
+     * snapshot() copies the bodies in the background instead, so
+     * writing them overlaps with the next enqueueSteps.
      */
 template<
     std::size_t NDim,
     typename TElem,
     typename TTime,
-    typename TSize
+    typename TSize,
+    typename TSolver = solvers::ForceMatrix,
+    typename TLayout = types::layouts::AoS,
+    typename TIntegrator = integrators::Euler
     >
 class Simulation
 {
 private:
+    using Bodies = types::Bodies<TLayout,NDim,TElem,TSize>;
+
+    static_assert(
+        TIntegrator::usesSolver || !IsForceMatrix<TSolver>::value,
+        "This integrator does not use the solver, pair it with an "
+        "O(N) solver like solvers::Fused instead of the force matrix");
+
+    //the accelerator can work on the caller's arrays
+    static constexpr bool zeroCopy =
+        std::is_same<
+            alpaka::dev::Dev<ACC_FORCEM>,
+            alpaka::dev::DevCpu>::value &&
+        std::is_same<
+            TLayout,
+            types::layouts::AoS>::value;
     //alpaka
     decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) ) devAccForceM;
     decltype( alpaka::dev::DevMan<ACC_UPDATEP>::getDevByIdx(0) ) devAccUpdateP;
+    //all kernels of a step are enqueued here, so they keep their order,
+    //asynchronous on every backend so the steps run beside the host
     STREAM streamForceM;
-    STREAM streamUpdateP;
+    //copies of the snapshots to the host, runs beside the steps
+    STREAM_READBACK streamReadback;
     alpaka::dev::DevCpu devHost;
-    TSize pitchBytesForceMatrix;
 
     alpaka::Vec<
         alpaka::dim::DimInt<1u>,TSize>
         const extentBodies;
-
+    //number of TElem of the positions and masses in the layout
     alpaka::Vec<
-        alpaka::dim::DimInt<2u>,TSize>
-        const extentForceMatrix;
+        alpaka::dim::DimInt<1u>,TSize>
+        const extentStorage;
     
     //Data on Host
-    alpaka::mem::view::ViewPlainPtr<
-        //std::decay<decltype(devHost)>::type,
-        alpaka::dev::DevCpu,
-        types::Vector<NDim,TElem>,
-        alpaka::dim::DimInt<1u>,
-        TSize> hostBodiesPosition;
+    types::Vector<NDim,TElem> * const hostBodiesPosition;
     alpaka::mem::view::ViewPlainPtr<
         //std::decay<decltype(devHost)>::type,
         alpaka::dev::DevCpu,
         types::Vector<NDim,TElem>,
         alpaka::dim::DimInt<1u>,
         TSize> hostBodiesVelocity;
-    alpaka::mem::view::ViewPlainPtr<
-        //std::decay<decltype(devHost)>::type,
-        alpaka::dev::DevCpu,
-        TElem,
-        alpaka::dim::DimInt<1u>,
-        TSize> hostBodiesMass;
+    //positions and masses in the layout
+    decltype( alpaka::mem::buf::alloc
+            <TElem, TSize>(devHost, 1) ) hostBodies;
 
     //Data on Acc
     decltype( alpaka::mem::buf::alloc
-            <types::Vector<NDim,TElem> , TSize>(devAccForceM, extentForceMatrix) ) accForceMatrix;
-    decltype( alpaka::mem::buf::alloc
-            <types::Vector<NDim,TElem> , TSize>(devAccForceM, extentBodies) ) accBodiesPosition;
+            <TElem, TSize>(devAccForceM, 1) ) accBodies;
     decltype( alpaka::mem::buf::alloc
             <types::Vector<NDim,TElem> , TSize>(devAccForceM, extentBodies) ) accBodiesVelocity;
+    //masses of the zero-copy mode, the tracers' are zero
     decltype( alpaka::mem::buf::alloc
             <TElem, TSize>(devAccForceM, 1) ) accBodiesMass;
+    //flag if the kernels work on the caller's arrays
+    bool inPlace;
 
     TSize numBodies;
+    //bodies before the tracers
+    TSize numMassive;
     float gravitationalConstant;// = 6.674e-11;
     float smoothnessFactor;
     //flag if a new step had been done
     bool stepFlag = true;
+    //flag if timestep holds the step of the current bodies
+    bool timestepValid = false;
+    //flag if the integrator has evaluated the forces
+    bool integratorStarted = false;
+    std::size_t stepsSinceReorder = 0;
+    //original indices of the reordered bodies
+    decltype( alpaka::mem::buf::alloc
+            <TSize, TSize>(devHost, 1) ) hostOrder;
 public:
     std::size_t elements = 8; //Alpaka elements
-    /**
+
+    typename TSolver::template Solver<
+        ACC_FORCEM,
+        ACC_UPDATEP,
+        NDim,
+        TElem,
+        TSize> solver;
+
+    typename TIntegrator::template Integrator<
+        ACC_UPDATEP,
+        NDim,
+        TElem,
+        TSize> integrator;
+
+    //chooses the steps of stepAdaptive, its parameters can be set here
+    algorithms::Timestep<
+        ACC_FORCEM,
+        ACC_UPDATEP,
+        NDim,
+        TElem,
+        TSize> timestep;
+
+    //sorts the bodies along a space-filling curve, off by default
+    algorithms::Reorder<
+        ACC_FORCEM,
+        ACC_UPDATEP,
+        NDim,
+        TElem,
+        TSize,
+        TLayout> reorder;
+
+private:
+    /*** Snapshots ***/
+    //copy of the bodies at one point of the simulation
+    struct SnapshotSlot
+    {
+        TSize numBodies;
+        //copy on the accelerator, taken in the order of the steps
+        decltype( alpaka::mem::buf::alloc
+                <TElem, TSize>(devAccForceM, 1) ) accBodies;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(devAccForceM, 1) ) accBodiesVelocity;
+        //copy on the host, read back on streamReadback, page-locked on CUDA
+        decltype( alpaka::mem::buf::alloc
+                <TElem, TSize>(devHost, 1) ) hostBodies;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(devHost, 1) ) hostBodiesVelocity;
+        //original indices, if the bodies were reordered
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(devAccForceM, 1) ) accOrder;
+        decltype( alpaka::mem::buf::alloc
+                <TSize, TSize>(devHost, 1) ) hostOrder;
+        bool reordered;
+        alpaka::event::Event<STREAM> taken;
+        alpaka::event::Event<STREAM_READBACK> readBack;
+        //the bodies converted from the layout, filled on the first access
+        std::vector<types::Vector<NDim,TElem> > positions;
+        std::vector<types::Vector<NDim,TElem> > velocities;
+        std::vector<TElem> masses;
+        bool unpacked;
+
+        SnapshotSlot(
+                decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) ) const & devAcc,
+                alpaka::dev::DevCpu const & devHost,
+                alpaka::Vec<alpaka::dim::DimInt<1u>,TSize> const & extentStorage,
+                alpaka::Vec<alpaka::dim::DimInt<1u>,TSize> const & extentBodies) :
+            numBodies(extentBodies[0]),
+            accBodies( alpaka::mem::buf::alloc<TElem , TSize>
+                ( devAcc, extentStorage ) ),
+            accBodiesVelocity( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            hostBodies( alpaka::mem::buf::alloc<TElem , TSize>
+                ( devHost, extentStorage ) ),
+            hostBodiesVelocity( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+                ( devHost, extentBodies ) ),
+            accOrder( alpaka::mem::buf::alloc<TSize , TSize>
+                ( devAcc, extentBodies ) ),
+            hostOrder( alpaka::mem::buf::alloc<TSize , TSize>
+                ( devHost, extentBodies ) ),
+            reordered(false),
+            taken(devAcc),
+            readBack(devAcc),
+            positions(extentBodies[0]),
+            velocities(extentBodies[0]),
+            masses(extentBodies[0]),
+            unpacked(false)
+        {
+#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED)
+            //copies into pageable memory would not overlap with the steps
+            alpaka::mem::buf::pin( hostBodies );
+            alpaka::mem::buf::pin( hostBodiesVelocity );
+            alpaka::mem::buf::pin( hostOrder );
+#endif
+        }
+
+        //the buffers must outlive a running copy
+        ~SnapshotSlot()
+        {
+            alpaka::wait::wait( readBack );
+        }
+    };
+
+    //two slots, so one can be read while the next is copied
+    std::unique_ptr<SnapshotSlot> snapshotSlots[2];
+    std::size_t nextSnapshotSlot = 0;
+public:
+    /** Handle of a snapshot
+     *
+     * The snapshot is copied to the host in the background.
+     * The getters wait for the copy. A handle stays valid
+     * until the second snapshot after it is taken, because
+     * that one reuses its buffers.
+     */
+    class Snapshot
+    {
+    private:
+        SnapshotSlot * slot;
+    public:
+        explicit Snapshot(SnapshotSlot & slot) :
+            slot(&slot)
+        {}
+
+        //true if the copy to the host is done
+        bool ready() const
+        {
+            return alpaka::event::test( slot->readBack );
+        }
+
+        //waits for the copy to the host
+        void wait()
+        {
+            alpaka::wait::wait( slot->readBack );
+            if(slot->unpacked)
+                return;
+
+            Bodies const host(
+                alpaka::mem::view::getPtrNative( slot->hostBodies ),
+                slot->numBodies );
+            types::Vector<NDim,TElem> const * const velocity(
+                alpaka::mem::view::getPtrNative( slot->hostBodiesVelocity ) );
+            TSize const * const order(
+                alpaka::mem::view::getPtrNative( slot->hostOrder ) );
+            for( TSize i( 0 ); i < slot->numBodies; i++ )
+            {
+                TSize const original( slot->reordered ? order[ i ] : i );
+                slot->positions[ original ] = host.getPosition( i );
+                slot->velocities[ original ] = velocity[ i ];
+                slot->masses[ original ] = host.getMass( i );
+            }
+            slot->unpacked = true;
+        }
+
+        types::Vector<NDim,TElem> const * getPositions()
+        {
+            wait();
+            return slot->positions.data();
+        }
+
+        types::Vector<NDim,TElem> const * getVelocities()
+        {
+            wait();
+            return slot->velocities.data();
+        }
+
+        TElem const * getMasses()
+        {
+            wait();
+            return slot->masses.data();
+        }
+    };
+
+
+    /** Simulation of numBodies massive bodies
+     *
+     * In the zero-copy mode, see isZeroCopy, the steps move the
+     * bodies in bodiesPosition and bodiesVelocity directly, so
+     * both arrays have to outlive the simulation and change with
+     * every step. disableZeroCopy() copies the bodies instead.
      */
     Simulation(
             types::Vector<NDim,TElem> * bodiesPosition,
@@ -107,182 +403,581 @@ public:
             TSize numBodies,
             float smoothnessFactor,
             float gravitationalConstant) :
+        Simulation(
+            bodiesPosition,
+            bodiesVelocity,
+            bodiesMass,
+            numBodies,
+            smoothnessFactor,
+            gravitationalConstant,
+            numBodies)
+    {}
+
+    /** Simulation of massive bodies and tracers
+     *
+     * The arrays hold the numMassive massive bodies first and
+     * the tracers after them. The masses of the tracers are
+     * not read. The arrays are used like in the constructor above.
+     *
+     * @param numMassive number of massive bodies
+     */
+    Simulation(
+            types::Vector<NDim,TElem> * bodiesPosition,
+            types::Vector<NDim,TElem> * bodiesVelocity,
+            TElem * bodiesMass,
+            TSize numBodies,
+            float smoothnessFactor,
+            float gravitationalConstant,
+            TSize numMassive) :
         devAccForceM(alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0)),
         devAccUpdateP(alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0)),
         streamForceM(devAccForceM),
-        streamUpdateP(devAccUpdateP),
+        streamReadback(devAccForceM),
         devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
         extentBodies(numBodies),
-        extentForceMatrix(numBodies,numBodies),
-        hostBodiesPosition(bodiesPosition, devHost, extentBodies),
+        extentStorage(Bodies::size(numBodies)),
+        hostBodiesPosition(bodiesPosition),
         hostBodiesVelocity(bodiesVelocity, devHost, extentBodies),
-        hostBodiesMass(bodiesMass, devHost, extentBodies),
-        accForceMatrix( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
-            ( devAccForceM, extentForceMatrix ) ),
-        accBodiesPosition( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
-            ( devAccForceM, extentBodies ) ),
+        hostBodies( alpaka::mem::buf::alloc<TElem , TSize>
+            ( devHost, zeroCopy ?
+                static_cast<TSize>(1) : extentStorage[0] ) ),
+        accBodies( alpaka::mem::buf::alloc<TElem , TSize>
+            ( devAccForceM, zeroCopy ?
+                static_cast<TSize>(1) : extentStorage[0] ) ),
         accBodiesVelocity( alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
-            ( devAccForceM, extentBodies ) ),
+            ( devAccForceM, zeroCopy ?
+                static_cast<TSize>(1) : numBodies ) ),
         accBodiesMass( alpaka::mem::buf::alloc<TElem , TSize>
-            ( devAccForceM, extentBodies ) ),
+            ( devAccForceM, zeroCopy ?
+                numBodies : static_cast<TSize>(1) ) ),
+        inPlace( zeroCopy ),
         numBodies(numBodies),
+        numMassive( ( numMassive < numBodies ) ? numMassive : numBodies ),
         gravitationalConstant(gravitationalConstant),
-        smoothnessFactor(smoothnessFactor)
+        smoothnessFactor(smoothnessFactor),
+        hostOrder( alpaka::mem::buf::alloc<TSize , TSize>
+            ( devHost, extentBodies ) ),
+        solver( devAccForceM, numBodies ),
+        integrator( devAccUpdateP, numBodies ),
+        timestep( devAccUpdateP, numBodies ),
+        reorder( devAccUpdateP, numBodies )
 
     {
+        setSolverSources( solver, 0 );
+        updatePlan();
 
-        /*** Memory copy ***/
-        alpaka::mem::view::copy(
-            streamForceM,
-            accBodiesPosition,
-            hostBodiesPosition,
-            extentBodies );
-
-        alpaka::mem::view::copy(
-            streamForceM,
-            accBodiesVelocity,
-            hostBodiesVelocity,
-            extentBodies );
-
-        alpaka::mem::view::copy(
-            streamForceM,
-            accBodiesMass,
-            hostBodiesMass,
-            extentBodies );
-        //Wait for data
-        alpaka::wait::wait( streamForceM );
+        if(inPlace)
+        {
+            //the accelerator memory is host memory
+            TElem * const mass( alpaka::mem::view::getPtrNative( accBodiesMass ) );
+            for( TSize i( 0 ); i < numBodies; i++ )
+                mass[ i ] = ( i < this->numMassive ) ?
+                    bodiesMass[ i ] : static_cast<TElem>( 0 );
+        }
+        else
+            uploadBodies( bodiesMass );
+    }
 
+    //the buffers of the solver and the integrator must outlive the steps
+    ~Simulation()
+    {
+        wait();
     }
+
     /*** Funtion to execute a simulation step ***/
     void step(TTime dt)
     {   
+        steps(dt, 1);
+    }
+
+    /** Function to execute numSteps simulation steps
+     *
+     * The steps are enqueued back to back and the host only
+     * waits for the last one. Solvers which need a value on the
+     * host, like the P3m cell size, still wait for it.
+     */
+    void steps(TTime dt, std::size_t numSteps)
+    {
+        enqueueSteps(dt, numSteps);
+        wait();
+    }
+
+    /** Function to start numSteps simulation steps
+     *
+     * Returns as soon as the steps are enqueued, so the host can
+     * write a snapshot meanwhile. wait() waits for them. Solvers
+     * and integrators which need a value on the host, like the
+     * tree of BarnesHut or the levels of BlockSteps, wait for
+     * the steps before it inside the call.
+     */
+    void enqueueSteps(TTime dt, std::size_t numSteps)
+    {
         this->stepFlag = true;
+        this->timestepValid = false;
+        updatePlan();
+
+        for(std::size_t i(0); i < numSteps; i++)
+            enqueueStep(dt);
+    }
 
-        //Executing the ForceMatrixKernel
-        auto const workDivForceM(
-                alpaka::workdiv::getValidWorkDiv< ACC_FORCEM >(
-                    devAccForceM,
-                    extentForceMatrix,
-                    alpaka::Vec<
-                        alpaka::dim::DimInt<2u>,
-                        TSize
-                    >(this->elements,this->elements),
-                    false,
-                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
-                    EqualExtent
-                )
-        );
-
-        kernels::ForceMatrixKernel forceMatrixKernel;
-
-        auto const forceKernelExec(
-                alpaka::exec::create<ACC_FORCEM>(
-                    workDivForceM,
-                    forceMatrixKernel,
-                    alpaka::mem::view::getPtrNative( accBodiesPosition ),
-                    alpaka::mem::view::getPtrNative( accBodiesMass ),
-                    alpaka::mem::view::getPtrNative( accForceMatrix ),
-                    static_cast<TSize>(
-                        alpaka::mem::view::getPitchBytes<1u>
-                            (accForceMatrix)
-                    ),
+    /** Function to execute a simulation step with an adaptive dt
+     *
+     * The step is chosen on the accelerator from the accelerations
+     * and velocities of the bodies, see algorithms::Timestep. The
+     * step after it is chosen right away, so only one value is
+     * copied to the host per step. If there was no step before,
+     * the first call evaluates the forces once more.
+     *
+     * @return length of the step
+     */
+    TTime stepAdaptive()
+    {
+        this->stepFlag = true;
+        updatePlan();
+
+        if(!timestepValid)
+        {
+            if(integratorStarted)
+                enqueueTimestep(
+                    integrator.getAccelerations( solver ),
+                    integrator.getPitchBytesAccelerations( solver ) );
+            else
+            {
+                solver(
+                    streamForceM,
+                    getAccBodies(),
                     numBodies,
-                    smoothnessFactor
-                )
-        );
-        
-        alpaka::stream::enqueue( streamForceM, forceKernelExec);
+                    smoothnessFactor,
+                    this->elements );
+                enqueueTimestep(
+                    solver.getAccelerations(),
+                    solver.getPitchBytesAccelerations() );
+            }
+            wait();
+            timestepValid = true;
+        }
+
+        TTime const dt( static_cast<TTime>( timestep.getStep() ) );
+        enqueueStep(dt);
+        enqueueTimestep(
+            integrator.getAccelerations( solver ),
+            integrator.getPitchBytesAccelerations( solver ) );
+        wait();
+        return dt;
+    }
+
+    /*** Waits for the enqueued steps ***/
+    void wait()
+    {
         alpaka::wait::wait( streamForceM );
-        
-        /*** Execute addKernel ***/
-        unsigned int width(1);
-        while( width < numBodies ) width <<=1;
-
-        do {
-            width>>=1;
-
-            alpaka::Vec<alpaka::dim::DimInt<2u>,TSize>
-                extentWorkParallelAdd(numBodies,width);
-            auto const workDivAdd(
-                    alpaka::workdiv::getValidWorkDiv<ACC_FORCEM>(
-                        devAccForceM,
-                        extentWorkParallelAdd,
-                        alpaka::Vec<
-                            alpaka::dim::DimInt<2u>,
-                            TSize
-                        >(elements,1u),
-                        false,
-                        alpaka::workdiv::GridBlockExtentSubDivRestrictions::Unrestricted
-                    )
-            );
-            kernels::AddKernel addKernel;
-            auto const addKernelExec(
-                    alpaka::exec::create<ACC_FORCEM>(
-                        workDivAdd,
-                        addKernel,
-                        alpaka::mem::view::getPtrNative( accForceMatrix ),
-                        static_cast<TSize>(
-                            alpaka::mem::view::getPitchBytes<1u>
-                            (accForceMatrix)
-                        ),
-                        numBodies
-                        )
-            );
-
-            alpaka::stream::enqueue(streamForceM,addKernelExec);
-            alpaka::wait::wait(streamForceM);
-        } while(width>1);
-        
-        /*** Execute updatePositionKernel ***/
-        auto const workDivUpdatePositions(
-                alpaka::workdiv::getValidWorkDiv< ACC_UPDATEP >(
-                    devAccUpdateP,
-                    extentBodies,
-                    alpaka::Vec<
-                        alpaka::dim::DimInt<1u>,
-                        TSize
-                    >(this->elements),
-                    false,
-                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
-                    Unrestricted
-                )
-        );
-        kernels::UpdatePositionsKernel updatePositionsKernel;
-        auto const updatePositionsExec(
-                alpaka::exec::create<ACC_UPDATEP>(
-                    workDivUpdatePositions,
-                    updatePositionsKernel,
-                    alpaka::mem::view::getPtrNative( accForceMatrix ),
-                    alpaka::mem::view::getPtrNative( accBodiesPosition ),
-                    alpaka::mem::view::getPtrNative( accBodiesVelocity ),
-                    static_cast<TSize>(
-                        alpaka::mem::view::getPitchBytes<1u>
-                            ( accForceMatrix )
-                    ),
-                    numBodies,
-                    gravitationalConstant,
-                    dt
-                )
-        );
+    }
+
+    /** Takes a snapshot of the positions, velocities and masses
+     *
+     * The bodies are copied on the accelerator in the order of the
+     * steps and then read back on a separate stream, so the next
+     * steps run while the snapshot is copied and written. See
+     * Snapshot for how long the handle is valid.
+     */
+    Snapshot snapshot()
+    {
+        std::unique_ptr<SnapshotSlot> & slot(
+            snapshotSlots[ nextSnapshotSlot ] );
+        nextSnapshotSlot = 1 - nextSnapshotSlot;
+
+        if(!slot)
+            slot.reset( new SnapshotSlot(
+                devAccForceM,
+                devHost,
+                extentStorage,
+                extentBodies ) );
+        else
+            //the read back of the last snapshot in this slot has to be done
+            alpaka::wait::wait( streamForceM, slot->readBack );
+        slot->unpacked = false;
+
+        if(inPlace)
+            copyBodiesInPlace( slot->accBodies, slot->accBodiesVelocity );
+        else
+        {
+            alpaka::mem::view::copy(
+                streamForceM,
+                slot->accBodies,
+                accBodies,
+                extentStorage );
+            alpaka::mem::view::copy(
+                streamForceM,
+                slot->accBodiesVelocity,
+                accBodiesVelocity,
+                extentBodies );
+        }
+        slot->reordered = reorder.isReordered();
+        if(slot->reordered)
+            alpaka::mem::view::copy(
+                streamForceM,
+                slot->accOrder,
+                getAccOrder(),
+                extentBodies );
+        alpaka::stream::enqueue( streamForceM, slot->taken );
 
-        alpaka::stream::enqueue( streamUpdateP, updatePositionsExec);
-        alpaka::wait::wait( streamUpdateP );
+        alpaka::wait::wait( streamReadback, slot->taken );
+        alpaka::mem::view::copy(
+            streamReadback,
+            slot->hostBodies,
+            slot->accBodies,
+            extentStorage );
+        alpaka::mem::view::copy(
+            streamReadback,
+            slot->hostBodiesVelocity,
+            slot->accBodiesVelocity,
+            extentBodies );
+        if(slot->reordered)
+            alpaka::mem::view::copy(
+                streamReadback,
+                slot->hostOrder,
+                slot->accOrder,
+                extentBodies );
+        alpaka::stream::enqueue( streamReadback, slot->readBack );
 
+        return Snapshot( *slot );
     }
 
     types::Vector<NDim,TElem> * getPositions(){
+        if(inPlace)
+        {
+            //the steps work on the array itself
+            wait();
+            stepFlag = false;
+            return hostBodiesPosition;
+        }
         if(stepFlag)
         {
             alpaka::mem::view::copy(
                 streamForceM,
-                hostBodiesPosition,
-                accBodiesPosition,
-                extentBodies);
+                hostBodies,
+                accBodies,
+                extentStorage);
+            if(reorder.isReordered())
+                alpaka::mem::view::copy(
+                    streamForceM,
+                    hostOrder,
+                    getAccOrder(),
+                    extentBodies);
 
             alpaka::wait::wait( streamForceM );
+
+            Bodies const host(
+                alpaka::mem::view::getPtrNative( hostBodies ),
+                numBodies );
+            TSize const * const order(
+                alpaka::mem::view::getPtrNative( hostOrder ) );
+            for( TSize i( 0 ); i < numBodies; i++ )
+                hostBodiesPosition[ reorder.isReordered() ? order[ i ] : i ] =
+                    host.getPosition( i );
         }
         stepFlag = false;
-        return alpaka::mem::view::getPtrNative(hostBodiesPosition);
+        return hostBodiesPosition;
+    }
+
+    //true if the kernels work on the caller's arrays
+    bool isZeroCopy() const
+    {
+        return inPlace;
+    }
+
+    /** Stops working on the caller's arrays
+     *
+     * Copies the bodies into own buffers, from then on the
+     * velocity array is not written any more and the position
+     * array only by getPositions, like on the other accelerators.
+     */
+    void disableZeroCopy()
+    {
+        if(inPlace)
+            leaveInPlace();
+    }
+
+    /** Writes the plan of a step to os
+     *
+     * The plan holds the work divisions of the kernels of a
+     * step. It is chosen when the simulation is created and
+     * again when elements changes, every step reuses it.
+     * Solvers whose launches depend on the bodies, like the
+     * tree levels of BarnesHut, choose them in every step.
+     */
+    void printPlan(std::ostream & os)
+    {
+        updatePlan();
+        os << "bodies: " << numBodies << ", elements: " << this->elements << "\n";
+        printSolverPlan( os, solver, 0 );
+        integrator.printPlan( os );
+        timestep.printPlan( os );
+    }
+
+private:
+    /*** Chooses the work divisions again if elements changed ***/
+    void updatePlan()
+    {
+        integrator.updatePlan( this->elements );
+        //the solver also checks its own parameters
+        updateSolverPlan( solver, 0 );
+    }
+
+    /*** Solvers with a plan have updatePlan and printPlan ***/
+    template<typename TSolverInstance>
+    auto updateSolverPlan(TSolverInstance & solverInstance, int)
+    -> decltype( solverInstance.updatePlan( this->elements ) )
+    {
+        solverInstance.updatePlan( this->elements );
+    }
+
+    template<typename TSolverInstance>
+    void updateSolverPlan(TSolverInstance &, long)
+    {}
+
+    /*** Solvers which skip the tracers have numSources ***/
+    template<typename TSolverInstance>
+    auto setSolverSources(TSolverInstance & solverInstance, int)
+    -> decltype( void( solverInstance.numSources = this->numMassive ) )
+    {
+        solverInstance.numSources = this->numMassive;
+    }
+
+    template<typename TSolverInstance>
+    void setSolverSources(TSolverInstance &, long)
+    {}
+
+    /*** Solvers which keep per-body data between calls have invalidate ***/
+    template<typename TSolverInstance>
+    auto invalidateSolver(TSolverInstance & solverInstance, int)
+    -> decltype( solverInstance.invalidate() )
+    {
+        solverInstance.invalidate();
+    }
+
+    template<typename TSolverInstance>
+    void invalidateSolver(TSolverInstance &, long)
+    {}
+
+    template<typename TSolverInstance>
+    auto printSolverPlan(
+            std::ostream & os,
+            TSolverInstance const & solverInstance,
+            int) const
+    -> decltype( solverInstance.printPlan( os ) )
+    {
+        solverInstance.printPlan( os );
+    }
+
+    template<typename TSolverInstance>
+    void printSolverPlan(std::ostream & os, TSolverInstance const &, long) const
+    {
+        os << "solver: chosen in every step\n";
+    }
+
+    /*** Enqueues a simulation step without waiting for it ***/
+    void enqueueStep(TTime dt)
+    {
+        if(reorder.interval > 0 && stepsSinceReorder >= reorder.interval)
+        {
+            //the caller's arrays keep their order
+            if(inPlace)
+                leaveInPlace();
+            reorder(
+                streamForceM,
+                accBodies,
+                accBodiesVelocity,
+                numBodies,
+                numMassive,
+                this->elements );
+            //the cached data of the bodies is in the old order
+            integrator.restart();
+            invalidateSolver( solver, 0 );
+            stepsSinceReorder = 0;
+        }
+        stepsSinceReorder++;
+
+        integratorStarted = true;
+        integrator(
+            streamForceM,
+            solver,
+            getAccBodies(),
+            getAccVelocity(),
+            numBodies,
+            smoothnessFactor,
+            gravitationalConstant,
+            dt,
+            this->elements );
+    }
+
+    /*** Enqueues the choice of the step of the current bodies ***/
+    void enqueueTimestep(
+        types::Vector<NDim,TElem> const * accelerations,
+        TSize pitchBytesAccelerations)
+    {
+        timestep(
+            streamForceM,
+            accelerations,
+            pitchBytesAccelerations,
+            static_cast<types::Vector<NDim,TElem> const *>(
+                getAccVelocity() ),
+            numBodies,
+            gravitationalConstant,
+            smoothnessFactor,
+            this->elements );
+    }
+
+    //View of the original indices on the accelerator
+    auto getAccOrder()
+    -> alpaka::mem::view::ViewPlainPtr<
+        decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) ),
+        TSize,
+        alpaka::dim::DimInt<1u>,
+        TSize>
+    {
+        return alpaka::mem::view::ViewPlainPtr<
+            decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) ),
+            TSize,
+            alpaka::dim::DimInt<1u>,
+            TSize>( reorder.getOrder(), devAccForceM, extentBodies );
+    }
+
+    //View of the positions and masses on the accelerator
+    auto getAccBodies()
+    -> Bodies
+    {
+        if(inPlace)
+            return getBodiesInPlace( std::integral_constant<bool,zeroCopy>() );
+        return Bodies(
+            alpaka::mem::view::getPtrNative( accBodies ),
+            numBodies );
+    }
+
+    //Velocities on the accelerator
+    auto getAccVelocity()
+    -> types::Vector<NDim,TElem> *
+    {
+        if(inPlace)
+            return alpaka::mem::view::getPtrNative( hostBodiesVelocity );
+        return alpaka::mem::view::getPtrNative( accBodiesVelocity );
+    }
+
+    //The caller's arrays are only used in place with the AoS layout
+    auto getBodiesInPlace(std::true_type)
+    -> Bodies
+    {
+        return Bodies(
+            hostBodiesPosition,
+            alpaka::mem::view::getPtrNative( accBodiesMass ) );
+    }
+
+    auto getBodiesInPlace(std::false_type)
+    -> Bodies
+    {
+        return Bodies(
+            alpaka::mem::view::getPtrNative( accBodies ),
+            numBodies );
+    }
+
+    /*** Converts the bodies into the layout and copies them to the accelerator ***/
+    void uploadBodies(TElem const * bodiesMass)
+    {
+        /*** Conversion into the layout ***/
+        Bodies const host(
+            alpaka::mem::view::getPtrNative( hostBodies ),
+            numBodies );
+        //the padding of the layout is never read, but copied
+        std::fill(
+            alpaka::mem::view::getPtrNative( hostBodies ),
+            alpaka::mem::view::getPtrNative( hostBodies ) + extentStorage[0],
+            static_cast<TElem>( 0 ) );
+        for( TSize i( 0 ); i < numBodies; i++ )
+        {
+            host.setPosition( i, hostBodiesPosition[ i ] );
+            host.setMass( i, ( i < this->numMassive ) ?
+                bodiesMass[ i ] : static_cast<TElem>( 0 ) );
+        }
+
+        /*** Memory copy ***/
+        alpaka::mem::view::copy(
+            streamForceM,
+            accBodies,
+            hostBodies,
+            extentStorage );
+
+        alpaka::mem::view::copy(
+            streamForceM,
+            accBodiesVelocity,
+            hostBodiesVelocity,
+            extentBodies );
+        //Wait for data
+        alpaka::wait::wait( streamForceM );
+    }
+
+    /*** Copies the bodies into own buffers, the kernels use these from now on ***/
+    void leaveInPlace()
+    {
+        wait();
+        hostBodies = alpaka::mem::buf::alloc<TElem , TSize>
+            ( devHost, extentStorage );
+        accBodies = alpaka::mem::buf::alloc<TElem , TSize>
+            ( devAccForceM, extentStorage );
+        accBodiesVelocity = alpaka::mem::buf::alloc<types::Vector<NDim,TElem> , TSize>
+            ( devAccForceM, extentBodies );
+        uploadBodies( alpaka::mem::view::getPtrNative( accBodiesMass ) );
+        inPlace = false;
+    }
+
+    /** Copies the bodies of the zero-copy mode into a storage of the layout
+     *
+     * Only called in the zero-copy mode, so the storage is AoS:
+     * the positions first, then the masses.
+     */
+    template<
+        typename TBufBodies,
+        typename TBufVelocity>
+    void copyBodiesInPlace(TBufBodies & storage, TBufVelocity & velocity)
+    {
+        using DevAcc = decltype( alpaka::dev::DevMan<ACC_FORCEM>::getDevByIdx(0) );
+        TElem * const storagePtr( alpaka::mem::view::getPtrNative( storage ) );
+
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::DevCpu,
+            types::Vector<NDim,TElem>,
+            alpaka::dim::DimInt<1u>,
+            TSize> position( hostBodiesPosition, devHost, extentBodies );
+        alpaka::mem::view::ViewPlainPtr<
+            DevAcc,
+            types::Vector<NDim,TElem>,
+            alpaka::dim::DimInt<1u>,
+            TSize> storagePosition(
+                reinterpret_cast<types::Vector<NDim,TElem> *>( storagePtr ),
+                devAccForceM,
+                extentBodies );
+        alpaka::mem::view::ViewPlainPtr<
+            DevAcc,
+            TElem,
+            alpaka::dim::DimInt<1u>,
+            TSize> storageMass(
+                storagePtr + numBodies * static_cast<TSize>( NDim ),
+                devAccForceM,
+                extentBodies );
+
+        alpaka::mem::view::copy(
+            streamForceM,
+            storagePosition,
+            position,
+            extentBodies );
+        alpaka::mem::view::copy(
+            streamForceM,
+            storageMass,
+            accBodiesMass,
+            extentBodies );
+        alpaka::mem::view::copy(
+            streamForceM,
+            velocity,
+            hostBodiesVelocity,
+            extentBodies );
     }
 
 };
@@ -0,0 +1,270 @@
+/** Barnes-Hut solver
+ *
+ * This file implements a tree code which approximates
+ * groups of distant bodies by the moments of their cell.
+ * The tree is built on the accelerator by algorithms::Tree.
+ *
+ * @file barnesHut.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// TreeMomentsKernel
+#include <simulation/kernels/treeKernels.hpp>
+// TreeWalkKernel
+#include <simulation/kernels/treeWalkKernel.hpp>
+// Tree
+#include <simulation/algorithms/tree.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Barnes-Hut solver
+ *
+ * Needs O(N) memory and O(N log N) operations. After a call
+ * the acceleration/G of body i is stored in element i of a
+ * N-sized buffer. The accuracy is controlled by the opening
+ * angle theta, theta = 0 gives the direct summation.
+ *
+ * @tparam TQuadrupole use the quadrupole moments of the
+ *         cells in addition to their monopole moments
+ */
+template<
+    bool TQuadrupole = false>
+class BarnesHut
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator, used for
+     *         the bounding box
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        using Tree = algorithms::Tree<
+            TAccForce,
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize>;
+        using Node = typename Tree::Node;
+        using Quadrupole = types::Vector<NDim*NDim,TElem>;
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        Tree tree;
+
+        // number of nodes accQuadrupoles can hold
+        TSize capacityQuadrupoles;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+        decltype( alpaka::mem::buf::alloc
+                <Quadrupole , TSize>(
+                    devAcc, capacityQuadrupoles) ) accQuadrupoles;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+    public:
+        // opening angle
+        float theta = 0.5f;
+        // maximum number of bodies of a leaf
+        TSize leafSize = 8;
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            tree( devAcc, numBodies ),
+            // without quadrupoles the kernels never touch this buffer
+            capacityQuadrupoles( TQuadrupole ?
+                    tree.getCapacity() : static_cast<TSize>(1) ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+            accQuadrupoles( alpaka::mem::buf::alloc
+                <Quadrupole , TSize>( devAcc, capacityQuadrupoles ) ),
+            unpack( devAcc )
+        {}
+
+        /** Calculates the accelerations
+         *
+         * Builds the tree and walks it for every body.
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            tree(
+                stream,
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                leafSize,
+                elements );
+
+            if( TQuadrupole && capacityQuadrupoles < tree.getCapacity() )
+            {
+                capacityQuadrupoles = tree.getCapacity();
+                accQuadrupoles = alpaka::mem::buf::alloc<Quadrupole, TSize>(
+                        devAcc, capacityQuadrupoles );
+            }
+
+            /*** Moments from the leaves up to the root ***/
+            kernels::TreeMomentsKernel<TQuadrupole> treeMomentsKernel;
+            for( std::size_t level( tree.getNumLevels() ); level > 0; level-- )
+            {
+                TSize const levelSize(
+                        tree.getLevelBegin( level ) -
+                        tree.getLevelBegin( level - 1 ) );
+
+                auto const treeMomentsExec(
+                        alpaka::exec::create<TAccBodies>(
+                            tree.getWorkDiv( levelSize, elements ),
+                            treeMomentsKernel,
+                            tree.getNodes(),
+                            alpaka::mem::view::getPtrNative( accQuadrupoles ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                tree.getSortedPositions() ),
+                            static_cast<TElem const *>(
+                                tree.getSortedMasses() ),
+                            tree.getLevelBegin( level - 1 ),
+                            levelSize
+                        )
+                );
+                alpaka::stream::enqueue( stream, treeMomentsExec );
+            }
+
+            /*** Walk the tree ***/
+            kernels::TreeWalkKernel<TQuadrupole> treeWalkKernel;
+            auto const treeWalkExec(
+                    alpaka::exec::create<TAccBodies>(
+                        tree.getWorkDiv( numBodies, elements ),
+                        treeWalkKernel,
+                        static_cast<Node const *>( tree.getNodes() ),
+                        static_cast<Quadrupole const *>(
+                            alpaka::mem::view::getPtrNative( accQuadrupoles ) ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            tree.getSortedPositions() ),
+                        static_cast<TElem const *>( tree.getSortedMasses() ),
+                        static_cast<TSize const *>( tree.getPermutation() ),
+                        numBodies,
+                        static_cast<TElem>( theta ),
+                        smoothnessFactor,
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, treeWalkExec );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+
+        // Number of levels of the tree built by the last call
+        auto getNumLevels() const
+        -> std::size_t
+        {
+            return tree.getNumLevels();
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,391 @@
+/** Fast multipole solver
+ *
+ * This file implements the fast multipole method on the
+ * adaptive tree of algorithms::Tree. Distant pairs of nodes
+ * interact through their expansions, close pairs of leaves
+ * through the formula of the ForceMatrixKernel.
+ *
+ * @file fmm.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// TreeMomentsKernel
+#include <simulation/kernels/treeKernels.hpp>
+// FmmMultipoleKernel, FmmInteractionKernel, FmmLocalKernel,
+// FmmEvaluateKernel, fmm::Expansion
+#include <simulation/kernels/fmmKernels.hpp>
+// Tree
+#include <simulation/algorithms/tree.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Fast multipole solver
+ *
+ * Needs O(N) memory and O(N) expansion operations. After a
+ * call the acceleration/G of body i is stored in element i
+ * of a N-sized buffer. The accuracy is controlled by the
+ * order of the expansions and the opening angle theta.
+ *
+ * @tparam TOrder order of the expansions, atleast 1
+ */
+template<
+    std::size_t TOrder = 4>
+class Fmm
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator, used for
+     *         the bounding box
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        using Tree = algorithms::Tree<
+            TAccForce,
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize>;
+        using Node = typename Tree::Node;
+        using Expansion = kernels::fmm::Expansion<NDim,TOrder,TElem>;
+        using Coefficients = typename Expansion::Coefficients;
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentExpansion;
+
+        Tree tree;
+
+        // tables of the expansions, copied with the first call
+        Expansion hostExpansion;
+        bool expansionCopied;
+
+        // number of nodes the expansion buffers can hold
+        TSize capacity;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accNearAcceleration;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+        decltype( alpaka::mem::buf::alloc
+                <Expansion , TSize>(
+                    devAcc, extentExpansion) ) accExpansion;
+        decltype( alpaka::mem::buf::alloc
+                <TElem , TSize>(
+                    devAcc, capacity) ) accRadii;
+        decltype( alpaka::mem::buf::alloc
+                <Coefficients , TSize>(
+                    devAcc, capacity) ) accMultipoles;
+        decltype( alpaka::mem::buf::alloc
+                <Coefficients , TSize>(
+                    devAcc, capacity) ) accLocals;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+    public:
+        // opening angle
+        float theta = 0.5f;
+        // maximum number of bodies of a leaf
+        TSize leafSize = 16;
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            extentExpansion(static_cast<TSize>(1)),
+            tree( devAcc, numBodies ),
+            hostExpansion( Expansion::create() ),
+            expansionCopied( false ),
+            capacity( tree.getCapacity() ),
+            accNearAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+            accExpansion( alpaka::mem::buf::alloc
+                <Expansion , TSize>( devAcc, extentExpansion ) ),
+            accRadii( alpaka::mem::buf::alloc
+                <TElem , TSize>( devAcc, capacity ) ),
+            accMultipoles( alpaka::mem::buf::alloc
+                <Coefficients , TSize>( devAcc, capacity ) ),
+            accLocals( alpaka::mem::buf::alloc
+                <Coefficients , TSize>( devAcc, capacity ) ),
+            unpack( devAcc )
+        {}
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            if( !expansionCopied )
+            {
+                alpaka::mem::view::ViewPlainPtr<
+                    alpaka::dev::DevCpu, Expansion,
+                    alpaka::dim::DimInt<1u>, TSize>
+                hostBufExpansion(
+                        &hostExpansion,
+                        alpaka::dev::DevManCpu::getDevByIdx( 0 ),
+                        extentExpansion );
+                alpaka::mem::view::copy(
+                        stream, accExpansion, hostBufExpansion, extentExpansion );
+                expansionCopied = true;
+            }
+            Expansion const * const expansion(
+                    alpaka::mem::view::getPtrNative( accExpansion ) );
+
+            tree(
+                stream,
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                leafSize,
+                elements );
+
+            if( capacity < tree.getCapacity() )
+            {
+                capacity = tree.getCapacity();
+                accRadii = alpaka::mem::buf::alloc<TElem, TSize>(
+                        devAcc, capacity );
+                accMultipoles = alpaka::mem::buf::alloc<Coefficients, TSize>(
+                        devAcc, capacity );
+                accLocals = alpaka::mem::buf::alloc<Coefficients, TSize>(
+                        devAcc, capacity );
+            }
+
+            TSize const numNodes( tree.getNumNodes() );
+            std::size_t const numLevels( tree.getNumLevels() );
+
+            /*** Upward pass: centers of mass, P2M and M2M ***/
+            kernels::TreeMomentsKernel<false> treeMomentsKernel;
+            kernels::FmmMultipoleKernel<TOrder> multipoleKernel;
+            for( std::size_t level( numLevels ); level > 0; level-- )
+            {
+                TSize const levelSize(
+                        tree.getLevelBegin( level ) -
+                        tree.getLevelBegin( level - 1 ) );
+                auto const workDivLevel(
+                        tree.getWorkDiv( levelSize, elements ) );
+
+                auto const treeMomentsExec(
+                        alpaka::exec::create<TAccBodies>(
+                            workDivLevel,
+                            treeMomentsKernel,
+                            tree.getNodes(),
+                            static_cast<types::Vector<NDim*NDim,TElem> *>(
+                                nullptr ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                tree.getSortedPositions() ),
+                            static_cast<TElem const *>(
+                                tree.getSortedMasses() ),
+                            tree.getLevelBegin( level - 1 ),
+                            levelSize
+                        )
+                );
+                alpaka::stream::enqueue( stream, treeMomentsExec );
+
+                auto const multipoleExec(
+                        alpaka::exec::create<TAccBodies>(
+                            workDivLevel,
+                            multipoleKernel,
+                            expansion,
+                            static_cast<Node const *>( tree.getNodes() ),
+                            alpaka::mem::view::getPtrNative( accRadii ),
+                            alpaka::mem::view::getPtrNative( accMultipoles ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                tree.getSortedPositions() ),
+                            static_cast<TElem const *>(
+                                tree.getSortedMasses() ),
+                            tree.getLevelBegin( level - 1 ),
+                            levelSize
+                        )
+                );
+                alpaka::stream::enqueue( stream, multipoleExec );
+            }
+
+            /*** M2L and P2P ***/
+            kernels::FmmInteractionKernel<TOrder> interactionKernel;
+            auto const interactionExec(
+                    alpaka::exec::create<TAccBodies>(
+                        tree.getWorkDiv( numNodes, elements ),
+                        interactionKernel,
+                        expansion,
+                        static_cast<Node const *>( tree.getNodes() ),
+                        static_cast<TElem const *>(
+                            alpaka::mem::view::getPtrNative( accRadii ) ),
+                        static_cast<Coefficients const *>(
+                            alpaka::mem::view::getPtrNative( accMultipoles ) ),
+                        alpaka::mem::view::getPtrNative( accLocals ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            tree.getSortedPositions() ),
+                        static_cast<TElem const *>( tree.getSortedMasses() ),
+                        numNodes,
+                        static_cast<TElem>( theta ),
+                        smoothnessFactor,
+                        alpaka::mem::view::getPtrNative( accNearAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, interactionExec );
+
+            /*** Downward pass: L2L ***/
+            kernels::FmmLocalKernel<TOrder> localKernel;
+            for( std::size_t level( 0 ); level + 1 < numLevels; level++ )
+            {
+                TSize const levelSize(
+                        tree.getLevelBegin( level + 1 ) -
+                        tree.getLevelBegin( level ) );
+
+                auto const localExec(
+                        alpaka::exec::create<TAccBodies>(
+                            tree.getWorkDiv( levelSize, elements ),
+                            localKernel,
+                            expansion,
+                            static_cast<Node const *>( tree.getNodes() ),
+                            alpaka::mem::view::getPtrNative( accLocals ),
+                            tree.getLevelBegin( level ),
+                            levelSize
+                        )
+                );
+                alpaka::stream::enqueue( stream, localExec );
+            }
+
+            /*** L2P ***/
+            kernels::FmmEvaluateKernel<TOrder> evaluateKernel;
+            auto const evaluateExec(
+                    alpaka::exec::create<TAccBodies>(
+                        tree.getWorkDiv( numNodes, elements ),
+                        evaluateKernel,
+                        expansion,
+                        static_cast<Node const *>( tree.getNodes() ),
+                        static_cast<Coefficients const *>(
+                            alpaka::mem::view::getPtrNative( accLocals ) ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            tree.getSortedPositions() ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accNearAcceleration ) ),
+                        static_cast<TSize const *>( tree.getPermutation() ),
+                        numNodes,
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, evaluateExec );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+
+        // Number of levels of the tree built by the last call
+        auto getNumLevels() const
+        -> std::size_t
+        {
+            return tree.getNumLevels();
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
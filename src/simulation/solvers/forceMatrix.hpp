@@ -0,0 +1,277 @@
+/** Force matrix solver
+ *
+ * This file implements the original way of the simulation
+ * to calculate the accelerations. The ForceMatrixKernel
+ * stores every interaction in a N x N matrix which is then
+ * reduced row by row by the ReduceKernel.
+ *
+ * @file forceMatrix.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// ForceMatrixKernel
+#include <simulation/kernels/forceMatrixKernel.hpp>
+// ReduceKernel
+#include <simulation/kernels/reduceKernel.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Force matrix solver
+ *
+ * Needs O(N^2) memory. After a call the acceleration/G
+ * of body i is stored in the first element of row i.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicForceMatrix
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        static constexpr std::size_t reduceBlockSize = 256;
+
+        alpaka::dev::Dev<TAccForce> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<2u>,TSize>
+            const extentForceMatrix;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentForceMatrix) ) accForceMatrix;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+
+        /*** Plan ***/
+        // elements the work division of the ForceMatrixKernel was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<2u>,
+            TSize> workDivForceM;
+        // one block per row, does not depend on elements
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<2u>,
+            TSize> const workDivReduce;
+
+        auto getWorkDivForceM(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<2u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccForce >(
+                    devAcc,
+                    extentForceMatrix,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<2u>,
+                        TSize
+                    >(elements,elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    EqualExtent );
+        }
+    public:
+        Solver(
+                alpaka::dev::Dev<TAccForce> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentForceMatrix(numBodies,numBodies),
+            accForceMatrix( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentForceMatrix ) ),
+            unpack( devAcc ),
+            planElements(1),
+            workDivForceM( getWorkDivForceM( planElements ) ),
+            workDivReduce( kernels::ReduceKernel<reduceBlockSize>::
+                template getWorkDiv<TAccForce>(
+                    devAcc,
+                    numBodies,
+                    numBodies) )
+        {}
+
+        /** Chooses the work division of the ForceMatrixKernel
+         *
+         * Only does something if elements changed since the
+         * last call, so it is cheap to call before every launch.
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivForceM = getWorkDivForceM( elements );
+        }
+
+        // Writes the work divisions of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "forceMatrix: " << workDivForceM << "\n";
+            os << "reduce: " << workDivReduce << "\n";
+        }
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            //Executing the ForceMatrixKernel
+            kernels::BasicForceMatrixKernel<TForceLaw> forceMatrixKernel;
+
+            auto const forceKernelExec(
+                    alpaka::exec::create<TAccForce>(
+                        workDivForceM,
+                        forceMatrixKernel,
+                        bodiesPosition,
+                        bodiesMass,
+                        alpaka::mem::view::getPtrNative( accForceMatrix ),
+                        getPitchBytesAccelerations(),
+                        numBodies,
+                        smoothnessFactor
+                    )
+            );
+
+            alpaka::stream::enqueue( stream, forceKernelExec);
+
+            /*** Execute reduceKernel ***/
+            // Sums up every row in one launch and stores the
+            // result in the first element of the row
+            kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+
+            auto const reduceKernelExec(
+                    alpaka::exec::create<TAccForce>(
+                        workDivReduce,
+                        reduceKernel,
+                        alpaka::mem::view::getPtrNative( accForceMatrix ),
+                        getPitchBytesAccelerations(),
+                        numBodies,
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accForceMatrix ),
+                        getPitchBytesAccelerations(),
+                        kernels::reduce::Add()
+                    )
+            );
+
+            alpaka::stream::enqueue( stream, reduceKernelExec);
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accForceMatrix );
+        }
+
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>(
+                alpaka::mem::view::getPitchBytes<1u>( accForceMatrix ) );
+        }
+    };
+};
+
+// The original force matrix solver with Plummer softening
+using ForceMatrix = BasicForceMatrix<kernels::forceLaws::Plummer>;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,310 @@
+/** Mixed precision solvers
+ *
+ * This file implements solvers which calculate the
+ * accelerations with the MixedAccelerationKernel.
+ *
+ * @file mixed.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// MixedCentresKernel, MixedAccelerationKernel, accumulate
+#include <simulation/kernels/mixedAccelerationKernel.hpp>
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Mixed precision solver
+ *
+ * Needs O(N) memory. Every call first stores the centres
+ * of the groups of NGroupSize consecutive bodies in TElem
+ * and the offsets of the bodies to them in TPairElem, then
+ * evaluates the interactions in TPairElem on the offsets.
+ * After a call the acceleration/G of body i is stored in
+ * element i of a N-sized buffer.
+ *
+ * The default is meant for bodies stored in double: the
+ * interactions are evaluated in float and summed up in
+ * double.
+ *
+ * @tparam TPairElem datatype of the interactions
+ * @tparam TAccumulate accumulator, see kernels::accumulate
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ * @tparam NGroupSize bodies per group
+ */
+template<
+    typename TPairElem = float,
+    typename TAccumulate = kernels::accumulate::Wide<double>,
+    typename TForceLaw = kernels::forceLaws::Plummer,
+    std::size_t NGroupSize = 32>
+class Mixed
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator (unused)
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentGroups;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentGroups) ) accCentres;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TPairElem> , TSize>(
+                    devAcc, extentBodies) ) accOffsets;
+
+        decltype( alpaka::mem::buf::alloc
+                <TPairElem, TSize>(
+                    devAcc, extentBodies) ) accMasses;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivCentres;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivAcceleration;
+
+        auto getWorkDiv(
+                alpaka::Vec<alpaka::dim::DimInt<1u>,TSize> const & extent,
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                    devAcc,
+                    extent,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+    public:
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            extentGroups(
+                ( numBodies + static_cast<TSize>( NGroupSize ) - 1 ) /
+                static_cast<TSize>( NGroupSize ) ),
+            accCentres( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentGroups ) ),
+            accOffsets( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TPairElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            accMasses( alpaka::mem::buf::alloc
+                <TPairElem, TSize>
+                ( devAcc, extentBodies ) ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            planElements(1),
+            workDivCentres( getWorkDiv( extentGroups, 1 ) ),
+            workDivAcceleration( getWorkDiv( extentBodies, planElements ) )
+        {}
+
+        /** Chooses the work division for elements
+         *
+         * Only does something if elements changed since the
+         * last call, so it is cheap to call before every launch.
+         * The centres are always computed with one group per
+         * thread.
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivAcceleration = getWorkDiv( extentBodies, elements );
+        }
+
+        // Writes the work divisions of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "centres: " << workDivCentres << "\n"
+               << "acceleration: " << workDivAcceleration << "\n";
+        }
+
+        /** Calculates the accelerations
+         *
+         * The centres kernel reads the bodies in their layout,
+         * the acceleration kernel only its offsets.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            TSize const groupSize( static_cast<TSize>( NGroupSize ) );
+
+            kernels::MixedCentresKernel<TPairElem> centresKernel;
+
+            auto const centresKernelExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivCentres,
+                        centresKernel,
+                        bodies,
+                        numBodies,
+                        groupSize,
+                        alpaka::mem::view::getPtrNative( accCentres ),
+                        alpaka::mem::view::getPtrNative( accOffsets ),
+                        alpaka::mem::view::getPtrNative( accMasses )
+                    )
+            );
+
+            kernels::MixedAccelerationKernel<
+                TPairElem,
+                TAccumulate,
+                TForceLaw> accelerationKernel;
+
+            auto const accelerationKernelExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivAcceleration,
+                        accelerationKernel,
+                        alpaka::mem::view::getPtrNative( accCentres ),
+                        alpaka::mem::view::getPtrNative( accOffsets ),
+                        alpaka::mem::view::getPtrNative( accMasses ),
+                        groupSize,
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesAcceleration ),
+                        numBodies,
+                        smoothnessFactor
+                    )
+            );
+
+            alpaka::stream::enqueue( stream, centresKernelExec);
+            alpaka::stream::enqueue( stream, accelerationKernelExec);
+        }
+
+        /** Calculates the accelerations of separate arrays
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            // the kernels only read the bodies
+            (*this)(
+                stream,
+                types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                    const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                    const_cast<TElem *>( bodiesMass ) ),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+    };
+};
+
+/** Compensated solver
+ *
+ * For bodies stored in float: the interactions are
+ * evaluated in float and summed up with compensation.
+ */
+using Compensated = Mixed<
+    float,
+    kernels::accumulate::Compensated>;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,273 @@
+/** Particle-particle particle-mesh solver
+ *
+ * This file implements P3M: the long range part of the
+ * forces is calculated on a mesh, the short range part
+ * directly for the pairs of neighbouring cells.
+ *
+ * @file p3m.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// ParticleMesh
+#include <simulation/solvers/particleMesh.hpp>
+// P3mShortRangeKernel
+#include <simulation/kernels/p3mKernels.hpp>
+// pm::Cic, pm::Grid
+#include <simulation/kernels/pmKernels.hpp>
+// CellList
+#include <simulation/algorithms/cellList.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Particle-particle particle-mesh solver
+ *
+ * The forces are split with a Gaussian of the split radius
+ * r_s. The mesh of a ParticleMesh solver takes the long
+ * range part, the formula of the ForceMatrixKernel the short
+ * range part up to the cutoff. Needs O(N + M) memory and
+ * O(N + M log M) operations for a grid with M points, plus
+ * the neighbours within the cutoff of every body.
+ *
+ * @tparam TAssignment mass assignment, kernels::pm::Ngp,
+ *         kernels::pm::Cic or kernels::pm::Tsc
+ * @tparam TPeriodic periodic boundaries
+ */
+template<
+    typename TAssignment = kernels::pm::Cic,
+    bool TPeriodic = false>
+class P3m
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator, used for
+     *         the bounding box
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        using Mesh = typename ParticleMesh<
+            TAssignment,
+            TPeriodic
+        >::template Solver<
+            TAccForce,
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize>;
+        using CellList = algorithms::CellList<
+            TAccForce,
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize,
+            TPeriodic>;
+        using Grid = kernels::pm::Grid<NDim,TElem>;
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+        alpaka::dev::DevCpu devHost;
+
+        Mesh mesh;
+        CellList cellList;
+
+        decltype( alpaka::mem::buf::alloc
+                <Grid , TSize>(
+                    devHost, 1) ) hostGrid;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+    public:
+        // grid points per dimension, a power of two, atleast 8
+        TSize gridSize = 64;
+        // split radius r_s in cells of the mesh
+        TElem splitRadius = static_cast<TElem>( 1.25 );
+        // largest distance of the short range pairs in units of r_s
+        TElem cutoff = static_cast<TElem>( 4.5 );
+        // box of periodic grids
+        types::Vector<NDim,TElem> boxOrigin =
+            types::Vector<NDim,TElem>( static_cast<TElem>( 0 ) );
+        TElem boxSize = static_cast<TElem>( 1 );
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+            mesh( devAcc, numBodies ),
+            cellList( devAcc, numBodies ),
+            hostGrid( alpaka::mem::buf::alloc
+                <Grid , TSize>( devHost, 1 ) ),
+            unpack( devAcc )
+        {}
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            /*** Long range forces ***/
+            mesh.gridSize = gridSize;
+            mesh.splitRadius = splitRadius;
+            mesh.boxOrigin = boxOrigin;
+            mesh.boxSize = boxSize;
+            mesh(
+                stream,
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                smoothnessFactor,
+                elements );
+
+            // the cell size of an isolated mesh follows the bodies
+            alpaka::Vec<
+                alpaka::dim::DimInt<1u>,
+                TSize
+            > const extentOne( static_cast<TSize>(1) );
+            alpaka::mem::view::ViewPlainPtr<
+                alpaka::dev::Dev<TAccBodies>, Grid,
+                alpaka::dim::DimInt<1u>, TSize>
+            accGrid( mesh.getGrid(), devAcc, extentOne );
+            alpaka::mem::view::copy( stream, hostGrid, accGrid, extentOne );
+            alpaka::wait::wait( stream );
+
+            TElem const split( splitRadius *
+                    alpaka::mem::view::getPtrNative( hostGrid )->cellSize );
+            TElem const cutoffDistance( cutoff * split );
+
+            /*** Short range forces ***/
+            cellList(
+                stream,
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                cutoffDistance,
+                boxOrigin,
+                boxSize,
+                elements );
+
+            kernels::P3mShortRangeKernel<TPeriodic> shortRangeKernel;
+            auto const shortRangeExec(
+                    alpaka::exec::create<TAccBodies>(
+                        cellList.getWorkDiv( numBodies, elements ),
+                        shortRangeKernel,
+                        cellList.getGeometry(),
+                        static_cast<TSize const *>( cellList.getKeys() ),
+                        static_cast<TSize const *>( cellList.getCellBegin() ),
+                        static_cast<TSize const *>( cellList.getCellEnd() ),
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            cellList.getSortedPositions() ),
+                        static_cast<TElem const *>(
+                            cellList.getSortedMasses() ),
+                        static_cast<TSize const *>(
+                            cellList.getPermutation() ),
+                        numBodies,
+                        split,
+                        cutoffDistance,
+                        smoothnessFactor,
+                        mesh.getAccelerations()
+                    )
+            );
+            alpaka::stream::enqueue( stream, shortRangeExec );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return mesh.getAccelerations();
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return mesh.getPitchBytesAccelerations();
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
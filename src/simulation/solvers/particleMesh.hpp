@@ -0,0 +1,513 @@
+/** Particle mesh solver
+ *
+ * This file implements the particle mesh method. The masses
+ * are assigned to a grid, the potential is the convolution
+ * of the grid with the Green's function, calculated with
+ * FFTs, and its gradient is interpolated back to the bodies.
+ *
+ * @file particleMesh.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// ReduceKernel, reduce::MinElementwise, reduce::MaxElementwise
+#include <simulation/kernels/reduceKernel.hpp>
+// PmGridKernel, PmClearKernel, PmAssignKernel, PmFftKernel,
+// PmGreenKernel, PmConvolveKernel, PmInterpolateKernel, pm::Cic
+#include <simulation/kernels/pmKernels.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <stdexcept> // std::invalid_argument
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Particle mesh solver
+ *
+ * Needs O(N + M) memory and O(N + M log M) operations for a
+ * grid with M points. After a call the acceleration/G of
+ * body i is stored in element i of a N-sized buffer. Forces
+ * below a few cells are smoothed by the grid.
+ *
+ * Isolated grids are placed around the bounding box of the
+ * bodies in every call and are padded to twice their size,
+ * so the FFTs do not add periodic images. Periodic grids
+ * cover the fixed box [boxOrigin, boxOrigin + boxSize)^NDim
+ * and ignore the smoothness factor.
+ *
+ * @tparam TAssignment mass assignment, kernels::pm::Ngp,
+ *         kernels::pm::Cic or kernels::pm::Tsc
+ * @tparam TPeriodic periodic boundaries
+ */
+template<
+    typename TAssignment = kernels::pm::Cic,
+    bool TPeriodic = false>
+class ParticleMesh
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator, used for
+     *         the bounding box
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+        static_assert( !TPeriodic || NDim == 2 || NDim == 3,
+                "Periodic grids are only available in 2 and 3 dimensions." );
+    private:
+        static constexpr std::size_t reduceBlockSize = 256;
+
+        using Grid = kernels::pm::Grid<NDim,TElem>;
+        using Complex = kernels::pm::Complex<TElem>;
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+        alpaka::dev::DevCpu devHost;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        // grid size the grid buffers were created for
+        TSize gridSizeAllocated;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, 1) ) accBoxMin;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, 1) ) accBoxMax;
+        decltype( alpaka::mem::buf::alloc
+                <Grid , TSize>(
+                    devAcc, 1) ) accGrid;
+        decltype( alpaka::mem::buf::alloc
+                <Grid , TSize>(
+                    devHost, 1) ) hostGrid;
+        decltype( alpaka::mem::buf::alloc
+                <Complex , TSize>(
+                    devAcc, 1) ) accDensity;
+        decltype( alpaka::mem::buf::alloc
+                <Complex , TSize>(
+                    devAcc, 1) ) accGreen;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+
+        // points per dimension of the grid buffers
+        auto getLength() const
+        -> TSize
+        {
+            return TPeriodic ? gridSize : 2 * gridSize;
+        }
+
+        auto getNumGridPoints() const
+        -> TSize
+        {
+            TSize numGridPoints( 1 );
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                numGridPoints *= getLength();
+            return numGridPoints;
+        }
+
+        auto getWorkDiv(
+                TSize const numElements,
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                    devAcc,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(numElements),
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(static_cast<TSize>(elements)),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted
+            );
+        }
+
+        // FFT of all axes of a grid buffer
+        template<
+            typename TStream>
+        auto transform(
+                TStream & stream,
+                Complex * const data,
+                TElem const sign,
+                std::size_t const elements)
+        -> void
+        {
+            TSize const length( getLength() );
+            TSize const numLines( getNumGridPoints() / length );
+            auto const workDivLines( getWorkDiv( numLines, elements ) );
+
+            kernels::PmFftKernel fftKernel;
+            TSize stride( 1 );
+            for( std::size_t axis( 0 ); axis < NDim; axis++ )
+            {
+                auto const fftExec(
+                        alpaka::exec::create<TAccBodies>(
+                            workDivLines,
+                            fftKernel,
+                            data,
+                            length,
+                            stride,
+                            numLines,
+                            sign
+                        )
+                );
+                alpaka::stream::enqueue( stream, fftExec );
+                stride *= length;
+            }
+        }
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+    public:
+        // grid points per dimension, a power of two, atleast 8,
+        // the next call throws std::invalid_argument otherwise
+        TSize gridSize = 64;
+        // box of periodic grids
+        types::Vector<NDim,TElem> boxOrigin =
+            types::Vector<NDim,TElem>( static_cast<TElem>( 0 ) );
+        TElem boxSize = static_cast<TElem>( 1 );
+        // in cells, > 0 keeps only the long range part of the forces
+        TElem splitRadius = static_cast<TElem>( 0 );
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+            extentBodies(numBodies),
+            gridSizeAllocated(0),
+            accBoxMin( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+            accBoxMax( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, 1 ) ),
+            accGrid( alpaka::mem::buf::alloc
+                <Grid , TSize>( devAcc, 1 ) ),
+            hostGrid( alpaka::mem::buf::alloc
+                <Grid , TSize>( devHost, 1 ) ),
+            accDensity( alpaka::mem::buf::alloc
+                <Complex , TSize>( devAcc, 1 ) ),
+            accGreen( alpaka::mem::buf::alloc
+                <Complex , TSize>( devAcc, 1 ) ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+            unpack( devAcc )
+        {
+            // no grid was placed yet, so the first call copies it
+            alpaka::mem::view::getPtrNative( hostGrid )->cellSize =
+                static_cast<TElem>( 0 );
+        }
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            TSize const length( getLength() );
+            TSize const numGridPoints( getNumGridPoints() );
+
+            // the radix-2 FFT needs a power of two, the isolated
+            // grid the margins and at least one cell between them
+            if( gridSize < 8 || ( gridSize & ( gridSize - 1 ) ) != 0 )
+                throw std::invalid_argument(
+                    "ParticleMesh: gridSize has to be a power of two, atleast 8" );
+
+            if( gridSizeAllocated != gridSize )
+            {
+                // the last call may still use the old grids
+                alpaka::wait::wait( stream );
+                gridSizeAllocated = gridSize;
+                accDensity = alpaka::mem::buf::alloc<Complex, TSize>(
+                        devAcc, numGridPoints );
+                accGreen = alpaka::mem::buf::alloc<Complex, TSize>(
+                        devAcc, numGridPoints );
+            }
+
+            Grid const * const grid(
+                    alpaka::mem::view::getPtrNative( accGrid ) );
+            Complex * const density(
+                    alpaka::mem::view::getPtrNative( accDensity ) );
+            Complex * const green(
+                    alpaka::mem::view::getPtrNative( accGreen ) );
+
+            auto const workDivBodies( getWorkDiv( numBodies, elements ) );
+            auto const workDivGrid( getWorkDiv( numGridPoints, elements ) );
+
+            /*** Placement of the grid ***/
+            if( TPeriodic )
+            {
+                Grid & periodicGrid(
+                        *alpaka::mem::view::getPtrNative( hostGrid ) );
+                TElem const cellSize( boxSize /
+                    static_cast<TElem>( gridSize ) );
+                bool changed( periodicGrid.cellSize != cellSize );
+                for( std::size_t d( 0 ); d < NDim; d++ )
+                    changed = changed ||
+                        periodicGrid.origin[ d ] != boxOrigin[ d ];
+                // the box rarely changes, and the copy of the last
+                // change may still read hostGrid
+                if( changed )
+                {
+                    alpaka::wait::wait( stream );
+                    periodicGrid.origin = boxOrigin;
+                    periodicGrid.cellSize = cellSize;
+                    alpaka::mem::view::copy(
+                            stream,
+                            accGrid,
+                            hostGrid,
+                            alpaka::Vec<
+                                alpaka::dim::DimInt<1u>,
+                                TSize
+                            >(static_cast<TSize>(1)) );
+                }
+            }
+            else
+            {
+                kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+                auto const workDivReduce(
+                        kernels::ReduceKernel<reduceBlockSize>::
+                            template getWorkDiv<TAccForce>(
+                                devAcc,
+                                static_cast<TSize>(1),
+                                numBodies ) );
+
+                auto const boxMinExec(
+                        alpaka::exec::create<TAccForce>(
+                            workDivReduce,
+                            reduceKernel,
+                            bodiesPosition,
+                            static_cast<TSize>(0),
+                            static_cast<TSize>(1),
+                            numBodies,
+                            alpaka::mem::view::getPtrNative( accBoxMin ),
+                            static_cast<TSize>(0),
+                            kernels::reduce::MinElementwise()
+                        )
+                );
+                alpaka::stream::enqueue( stream, boxMinExec );
+
+                auto const boxMaxExec(
+                        alpaka::exec::create<TAccForce>(
+                            workDivReduce,
+                            reduceKernel,
+                            bodiesPosition,
+                            static_cast<TSize>(0),
+                            static_cast<TSize>(1),
+                            numBodies,
+                            alpaka::mem::view::getPtrNative( accBoxMax ),
+                            static_cast<TSize>(0),
+                            kernels::reduce::MaxElementwise()
+                        )
+                );
+                alpaka::stream::enqueue( stream, boxMaxExec );
+
+                kernels::PmGridKernel gridKernel;
+                auto const gridExec(
+                        alpaka::exec::create<TAccBodies>(
+                            getWorkDiv( static_cast<TSize>(1), 1 ),
+                            gridKernel,
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                alpaka::mem::view::getPtrNative( accBoxMin ) ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                alpaka::mem::view::getPtrNative( accBoxMax ) ),
+                            gridSize,
+                            alpaka::mem::view::getPtrNative( accGrid )
+                        )
+                );
+                alpaka::stream::enqueue( stream, gridExec );
+            }
+
+            /*** Mass assignment ***/
+            kernels::PmClearKernel clearKernel;
+            auto const clearExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivGrid,
+                        clearKernel,
+                        numGridPoints,
+                        density
+                    )
+            );
+            alpaka::stream::enqueue( stream, clearExec );
+
+            kernels::PmAssignKernel<TAssignment, TPeriodic> assignKernel;
+            auto const assignExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivBodies,
+                        assignKernel,
+                        grid,
+                        bodiesPosition,
+                        bodiesMass,
+                        numBodies,
+                        gridSize,
+                        length,
+                        density
+                    )
+            );
+            alpaka::stream::enqueue( stream, assignExec );
+
+            /*** Poisson equation in Fourier space ***/
+            kernels::PmGreenKernel<TPeriodic> greenKernel;
+            auto const greenExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivGrid,
+                        greenKernel,
+                        grid,
+                        gridSize,
+                        length,
+                        smoothnessFactor,
+                        splitRadius,
+                        green
+                    )
+            );
+            alpaka::stream::enqueue( stream, greenExec );
+            // the cell size changes with the bounding box
+            if( !TPeriodic )
+                transform( stream, green, static_cast<TElem>( -1 ), elements );
+
+            transform( stream, density, static_cast<TElem>( -1 ), elements );
+
+            kernels::PmConvolveKernel convolveKernel;
+            auto const convolveExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivGrid,
+                        convolveKernel,
+                        static_cast<Complex const *>( green ),
+                        numGridPoints,
+                        density
+                    )
+            );
+            alpaka::stream::enqueue( stream, convolveExec );
+
+            transform( stream, density, static_cast<TElem>( 1 ), elements );
+
+            /*** Interpolation of the accelerations ***/
+            kernels::PmInterpolateKernel<TAssignment, TPeriodic>
+                interpolateKernel;
+            auto const interpolateExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivBodies,
+                        interpolateKernel,
+                        grid,
+                        bodiesPosition,
+                        numBodies,
+                        gridSize,
+                        length,
+                        static_cast<Complex const *>( density ),
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, interpolateExec );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+
+        // Placement of the grid of the last call on the accelerator
+        auto getGrid()
+        -> Grid *
+        {
+            return alpaka::mem::view::getPtrNative( accGrid );
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
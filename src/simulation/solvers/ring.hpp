@@ -0,0 +1,527 @@
+/** Ring solver
+ *
+ * This file implements a direct summation solver which
+ * uses several devices. Every device calculates the
+ * accelerations of its own block of sinks, while the
+ * blocks of sources are passed on from device to device
+ * in a ring.
+ *
+ * @file ring.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// BasicRingAccelerationKernel
+#include <simulation/kernels/ringKernels.hpp>
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <algorithm> // std::min, std::max
+#include <memory> // std::unique_ptr
+#include <vector> // std::vector
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Asynchronous stream of a device
+ *
+ * The copies and kernels of the devices of the ring run
+ * concurrently, so they need asynchronous streams.
+ *
+ * @tparam TDev device type
+ */
+template<
+    typename TDev>
+struct AsyncStream
+{
+    using type = alpaka::stream::StreamCpuAsync;
+};
+
+#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED)
+template<>
+struct AsyncStream<alpaka::dev::DevCudaRt>
+{
+    using type = alpaka::stream::StreamCudaRtAsync;
+};
+#endif
+
+/** Ring solver
+ *
+ * Sums up TForceLaw for all pairs like the Fused solver,
+ * but splits the bodies into numDevices blocks of sinks.
+ * Block d is calculated on device d, which gets the
+ * positions of its sinks and one block of sources at the
+ * beginning. In every round it sums up the interactions
+ * with its current sources and meanwhile copies the next
+ * block of sources from the following device into a second
+ * buffer. After numDevices rounds every sink has seen every
+ * source, and the blocks of accelerations are copied back
+ * to the device of the solver.
+ *
+ * The devices are those of TAccBodies, more devices than
+ * there are start again with the first one. So several
+ * blocks can share a device, e.g. to test the ring on a
+ * single CPU.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    typename TForceLaw = kernels::forceLaws::Plummer>
+class Ring
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator (unused)
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        using Dev = alpaka::dev::Dev<TAccBodies>;
+        using Stream = typename AsyncStream<Dev>::type;
+        using Event = alpaka::event::Event<Stream>;
+        using Extent = alpaka::Vec<alpaka::dim::DimInt<1u>,TSize>;
+
+        /** A block of sinks on one device
+         *
+         * sourcesPosition[ r % 2 ] holds the sources of round r.
+         * They were copied in round r - 1, so received[ ( r + 1 ) % 2 ]
+         * is recorded when they have arrived, for round 0 by the
+         * setup. computed[ r % 2 ] is recorded when the kernel of
+         * round r is done.
+         */
+        struct Part
+        {
+            Dev dev;
+            Stream computeStream;
+            Stream copyStream;
+            TSize begin;
+            TSize numSinks;
+            Extent const extentBlock;
+
+            decltype( alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem> , TSize>(
+                        dev, extentBlock) ) sinksPosition;
+            decltype( alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem> , TSize>(
+                        dev, extentBlock) ) accelerations;
+            std::vector< decltype( alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem> , TSize>(
+                        dev, extentBlock) ) > sourcesPosition;
+            std::vector< decltype( alpaka::mem::buf::alloc
+                    <TElem , TSize>(
+                        dev, extentBlock) ) > sourcesMass;
+
+            std::vector<Event> received;
+            std::vector<Event> computed;
+            Event finished;
+
+            alpaka::workdiv::WorkDivMembers<
+                alpaka::dim::DimInt<1u>,
+                TSize> workDivBlock;
+
+            Part(
+                    Dev const & dev,
+                    TSize begin,
+                    TSize numSinks,
+                    TSize maxBlock) :
+                dev(dev),
+                computeStream(dev),
+                copyStream(dev),
+                begin(begin),
+                numSinks(numSinks),
+                extentBlock(maxBlock),
+                sinksPosition( alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem> , TSize>( dev, extentBlock ) ),
+                accelerations( alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem> , TSize>( dev, extentBlock ) ),
+                finished(dev),
+                workDivBlock( getWorkDivBlock( dev, numSinks, 1 ) )
+            {
+                for( std::size_t i( 0 ); i < 2; i++ )
+                {
+                    sourcesPosition.push_back( alpaka::mem::buf::alloc
+                        <types::Vector<NDim,TElem> , TSize>( dev, extentBlock ) );
+                    sourcesMass.push_back( alpaka::mem::buf::alloc
+                        <TElem , TSize>( dev, extentBlock ) );
+                    received.emplace_back( dev );
+                    computed.emplace_back( dev );
+                }
+            }
+        };
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+
+        std::vector< std::unique_ptr<Part> > parts;
+
+        /*** Plan ***/
+        // elements, devices and bodies the parts were made for
+        std::size_t planElements;
+        std::size_t planDevices;
+        TSize planBodies;
+
+        static auto getWorkDivBlock(
+                Dev const & dev,
+                TSize const numSinks,
+                std::size_t const elements)
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                    dev,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(numSinks),
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(static_cast<TSize>(elements)),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+
+        // Splits the bodies into blocks of nearly the same size
+        auto createParts(
+                std::size_t numDevices,
+                TSize numBodies)
+        -> void
+        {
+            TSize const numParts( static_cast<TSize>( std::max(
+                    std::size_t( 1 ),
+                    std::min( numDevices, std::size_t( numBodies ) ) ) ) );
+            TSize const maxBlock( ( numBodies + numParts - 1 ) / numParts );
+            std::size_t const numDevs(
+                    alpaka::dev::DevMan<TAccBodies>::getDevCount() );
+
+            parts.clear();
+            for( TSize d( 0 ); d < numParts; d++ )
+            {
+                TSize const begin( numBodies * d / numParts );
+                TSize const end( numBodies * ( d + 1 ) / numParts );
+                parts.emplace_back( new Part(
+                        alpaka::dev::DevMan<TAccBodies>::getDevByIdx(
+                            d % numDevs ),
+                        begin,
+                        end - begin,
+                        maxBlock ) );
+            }
+        }
+
+        // Splits numBodies bodies again if they, elements or
+        // numDevices changed
+        auto updateParts(
+                std::size_t const elements,
+                TSize const numBodies)
+        -> void
+        {
+            if( elements == planElements &&
+                numDevices == planDevices &&
+                numBodies == planBodies )
+                return;
+            if( numDevices != planDevices || numBodies != planBodies )
+                createParts( numDevices, numBodies );
+            planElements = elements;
+            planDevices = numDevices;
+            planBodies = numBodies;
+            for( auto & part : parts )
+                part->workDivBlock = getWorkDivBlock(
+                        part->dev, part->numSinks, elements );
+        }
+
+        // Copies numElements elements from src + offset on
+        // devSrc to dst on the device of stream
+        template<
+            typename TValue,
+            typename TDst>
+        static auto copyBlock(
+                Stream & stream,
+                TDst & dst,
+                Dev const & devSrc,
+                TValue const * src,
+                TSize offset,
+                TSize numElements)
+        -> void
+        {
+            Extent const extent( numElements );
+            alpaka::mem::view::ViewPlainPtr<
+                Dev,
+                TValue,
+                alpaka::dim::DimInt<1u>,
+                TSize> view( const_cast<TValue *>( src ) + offset, devSrc, extent );
+            alpaka::mem::view::copy( stream, dst, view, extent );
+        }
+    public:
+        // number of blocks, by default one per device
+        std::size_t numDevices =
+            alpaka::dev::DevMan<TAccBodies>::getDevCount();
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            unpack( devAcc ),
+            planElements(1),
+            planDevices(0),
+            planBodies(numBodies)
+        {
+            updatePlan( planElements );
+        }
+
+        /** Chooses the blocks and work divisions
+         *
+         * Only does something if elements or numDevices changed
+         * since the last call. A new number of devices allocates
+         * the blocks again.
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            updateParts( elements, planBodies );
+        }
+
+        // Writes the blocks and their work divisions to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "ring: " << parts.size() << " blocks\n";
+            for( auto const & part : parts )
+                os << "block " << part->begin << " - "
+                    << part->begin + part->numSinks << ": "
+                    << part->workDivBlock << "\n";
+        }
+
+        /** Calculates the accelerations
+         *
+         * All copies and kernels of the ring are enqueued in the
+         * streams of the blocks, stream waits for their results.
+         * The blocks are split again if numBodies changed, it
+         * must not exceed the number of the constructor.
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * bodiesPosition,
+                TElem const * bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            updateParts( elements, numBodies );
+            TSize const numParts( static_cast<TSize>( parts.size() ) );
+
+            // the bodies are ready once stream got here
+            alpaka::event::Event<TStream> bodiesReady( devAcc );
+            alpaka::stream::enqueue( stream, bodiesReady );
+
+            // every block starts with its own sinks as sources,
+            // the last round stands before the first one
+            for( auto & part : parts )
+            {
+                alpaka::wait::wait( part->copyStream, bodiesReady );
+                copyBlock( part->copyStream, part->sinksPosition, devAcc,
+                        bodiesPosition, part->begin, part->numSinks );
+                copyBlock( part->copyStream, part->sourcesPosition[0], devAcc,
+                        bodiesPosition, part->begin, part->numSinks );
+                copyBlock( part->copyStream, part->sourcesMass[0], devAcc,
+                        bodiesMass, part->begin, part->numSinks );
+                alpaka::stream::enqueue( part->copyStream, part->received[1] );
+            }
+
+            kernels::BasicRingAccelerationKernel<TForceLaw> blockKernel;
+
+            for( TSize r( 0 ); r < numParts; r++ )
+            {
+                std::size_t const current( r % 2 );
+                std::size_t const last( 1 - current );
+                for( TSize d( 0 ); d < numParts; d++ )
+                {
+                    Part & part( *parts[ d ] );
+                    Part & next( *parts[ ( d + 1 ) % numParts ] );
+                    Part & previous( *parts[ ( d + numParts - 1 ) % numParts ] );
+                    Part const & sources( *parts[ ( d + r ) % numParts ] );
+
+                    alpaka::wait::wait( part.computeStream, part.received[ last ] );
+                    auto const blockExec(
+                            alpaka::exec::create<TAccBodies>(
+                                part.workDivBlock,
+                                blockKernel,
+                                static_cast<types::Vector<NDim,TElem> const *>(
+                                    alpaka::mem::view::getPtrNative(
+                                        part.sinksPosition ) ),
+                                part.begin,
+                                part.numSinks,
+                                static_cast<types::Vector<NDim,TElem> const *>(
+                                    alpaka::mem::view::getPtrNative(
+                                        part.sourcesPosition[ current ] ) ),
+                                static_cast<TElem const *>(
+                                    alpaka::mem::view::getPtrNative(
+                                        part.sourcesMass[ current ] ) ),
+                                sources.begin,
+                                sources.numSinks,
+                                smoothnessFactor,
+                                alpaka::mem::view::getPtrNative(
+                                    part.accelerations ),
+                                r > 0
+                            )
+                    );
+                    alpaka::stream::enqueue( part.computeStream, blockExec );
+                    alpaka::stream::enqueue( part.computeStream, part.computed[ current ] );
+
+                    if( r + 1 == numParts )
+                        continue;
+
+                    // the next sources overwrite those of the last round,
+                    // which the own kernel and the previous block must
+                    // have read, and come from the current ones of the
+                    // next block, which must have arrived there
+                    Part const & nextSources( *parts[ ( d + r + 1 ) % numParts ] );
+                    if( r > 0 )
+                        alpaka::wait::wait( part.copyStream, part.computed[ last ] );
+                    alpaka::wait::wait( part.copyStream, previous.received[ last ] );
+                    alpaka::wait::wait( part.copyStream, next.received[ last ] );
+                    copyBlock( part.copyStream, part.sourcesPosition[ last ], next.dev,
+                            alpaka::mem::view::getPtrNative( next.sourcesPosition[ current ] ),
+                            0, nextSources.numSinks );
+                    copyBlock( part.copyStream, part.sourcesMass[ last ], next.dev,
+                            alpaka::mem::view::getPtrNative( next.sourcesMass[ current ] ),
+                            0, nextSources.numSinks );
+                    alpaka::stream::enqueue( part.copyStream, part.received[ current ] );
+                }
+            }
+
+            // gathers the blocks of accelerations
+            for( auto & part : parts )
+            {
+                Extent const extent( part->numSinks );
+                alpaka::mem::view::ViewPlainPtr<
+                    alpaka::dev::Dev<TAccBodies>,
+                    types::Vector<NDim,TElem>,
+                    alpaka::dim::DimInt<1u>,
+                    TSize> view(
+                        alpaka::mem::view::getPtrNative( accBodiesAcceleration )
+                            + part->begin,
+                        devAcc,
+                        extent );
+                alpaka::mem::view::copy(
+                        part->computeStream, view, part->accelerations, extent );
+                alpaka::stream::enqueue( part->computeStream, part->finished );
+            }
+            for( auto & part : parts )
+                alpaka::wait::wait( stream, part->finished );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
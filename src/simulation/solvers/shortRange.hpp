@@ -0,0 +1,522 @@
+/** Short range solver
+ *
+ * This file implements a solver for interactions with a
+ * cutoff. The bodies are sorted into a cell list, so only
+ * the neighbouring cells are visited. With a skin the
+ * neighbours are kept in Verlet lists, which are only
+ * built again when a body has moved more than half the skin.
+ *
+ * @file shortRange.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// CellCutoffKernel, VerletListKernel, VerletForceKernel, DisplacementKernel
+#include <simulation/kernels/shortRangeKernels.hpp>
+// ReduceKernel, reduce::Max
+#include <simulation/kernels/reduceKernel.hpp>
+// Plummer
+#include <simulation/kernels/forceLaws.hpp>
+// CellList
+#include <simulation/algorithms/cellList.hpp>
+// Unpack
+#include <simulation/algorithms/unpack.hpp>
+// Bodies
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Short range solver
+ *
+ * Sums up TForceLaw for all pairs closer than cutoff. Needs
+ * O(N) memory and O(N) operations for a bounded number of
+ * neighbours per body.
+ *
+ * Without a skin the cell list is built in every call. With
+ * a skin every body gets a list of its neighbours within
+ * cutoff + skin. The lists stay valid until a body has moved
+ * more than skin / 2, which costs one value on the host per
+ * call. The lists grow if a body has more neighbours.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ * @tparam TPeriodic periodic boundaries
+ */
+template<
+    typename TForceLaw = kernels::forceLaws::Plummer,
+    bool TPeriodic = false>
+class ShortRange
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator, used for
+     *         the bounding box and the reductions
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        static constexpr std::size_t reduceBlockSize = 256;
+
+        using CellList = algorithms::CellList<
+            TAccForce,
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize,
+            TPeriodic>;
+
+        alpaka::dev::Dev<TAccBodies> devAcc;
+        alpaka::dev::DevCpu devHost;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        CellList cellList;
+
+        algorithms::Unpack<
+            TAccBodies,
+            NDim,
+            TElem,
+            TSize> unpack;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+
+        /*** Verlet lists ***/
+        // length of every list
+        TSize listLength;
+        decltype( alpaka::mem::buf::alloc
+                <TSize , TSize>(
+                    devAcc, 1) ) accNeighbours;
+        decltype( alpaka::mem::buf::alloc
+                <TSize , TSize>(
+                    devAcc, extentBodies) ) accNumNeighbours;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accReferencePosition;
+        decltype( alpaka::mem::buf::alloc
+                <TElem , TSize>(
+                    devAcc, extentBodies) ) accDisplacementSq;
+        decltype( alpaka::mem::buf::alloc
+                <TElem , TSize>(
+                    devAcc, 1) ) accMaxDisplacementSq;
+        decltype( alpaka::mem::buf::alloc
+                <TElem , TSize>(
+                    devHost, 1) ) hostMaxDisplacementSq;
+        decltype( alpaka::mem::buf::alloc
+                <TSize , TSize>(
+                    devAcc, 1) ) accMaxNeighbours;
+        decltype( alpaka::mem::buf::alloc
+                <TSize , TSize>(
+                    devHost, 1) ) hostMaxNeighbours;
+
+        // the lists belong to these parameters
+        bool listsValid;
+        TElem listCutoff;
+        TElem listSkin;
+        typename CellList::Geometry listGeometry;
+        std::size_t numBuilds;
+
+        // one block per row, the bodies are one row
+        auto getWorkDivReduce(
+                TSize const numBodies) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<2u>,
+            TSize>
+        {
+            return kernels::ReduceKernel<reduceBlockSize>::
+                template getWorkDiv<TAccForce>(
+                    devAcc,
+                    static_cast<TSize>(1),
+                    numBodies );
+        }
+
+        // largest displacement since the lists were built
+        template<
+            typename TStream>
+        auto getMaxDisplacementSq(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TSize const numBodies,
+                std::size_t const elements)
+        -> TElem
+        {
+            kernels::DisplacementKernel displacementKernel;
+            auto const displacementExec(
+                    alpaka::exec::create<TAccBodies>(
+                        cellList.getWorkDiv( numBodies, elements ),
+                        displacementKernel,
+                        bodiesPosition,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accReferencePosition ) ),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accDisplacementSq )
+                    )
+            );
+            alpaka::stream::enqueue( stream, displacementExec );
+
+            kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+            auto const maxExec(
+                    alpaka::exec::create<TAccForce>(
+                        getWorkDivReduce( numBodies ),
+                        reduceKernel,
+                        static_cast<TElem const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accDisplacementSq ) ),
+                        static_cast<TSize>(0),
+                        static_cast<TSize>(1),
+                        numBodies,
+                        alpaka::mem::view::getPtrNative( accMaxDisplacementSq ),
+                        static_cast<TSize>(0),
+                        kernels::reduce::Max()
+                    )
+            );
+            alpaka::stream::enqueue( stream, maxExec );
+
+            alpaka::Vec<
+                alpaka::dim::DimInt<1u>,
+                TSize
+            > const extentOne( static_cast<TSize>(1) );
+            alpaka::mem::view::copy(
+                    stream,
+                    hostMaxDisplacementSq,
+                    accMaxDisplacementSq,
+                    extentOne );
+            alpaka::wait::wait( stream );
+
+            return *alpaka::mem::view::getPtrNative( hostMaxDisplacementSq );
+        }
+
+        // builds the Verlet lists, longer ones if they overflow
+        template<
+            typename TStream>
+        auto buildLists(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                std::size_t const elements)
+        -> void
+        {
+            cellList(
+                stream,
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                cutoff + skin,
+                boxOrigin,
+                boxSize,
+                elements );
+
+            alpaka::Vec<
+                alpaka::dim::DimInt<1u>,
+                TSize
+            > const extentOne( static_cast<TSize>(1) );
+
+            while( true )
+            {
+                kernels::VerletListKernel<TPeriodic> listKernel;
+                auto const listExec(
+                        alpaka::exec::create<TAccBodies>(
+                            cellList.getWorkDiv( numBodies, elements ),
+                            listKernel,
+                            cellList.getGeometry(),
+                            static_cast<TSize const *>( cellList.getKeys() ),
+                            static_cast<TSize const *>( cellList.getCellBegin() ),
+                            static_cast<TSize const *>( cellList.getCellEnd() ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                cellList.getSortedPositions() ),
+                            static_cast<TSize const *>(
+                                cellList.getPermutation() ),
+                            numBodies,
+                            static_cast<TElem>( cutoff + skin ),
+                            listLength,
+                            alpaka::mem::view::getPtrNative( accNeighbours ),
+                            alpaka::mem::view::getPtrNative( accNumNeighbours ),
+                            alpaka::mem::view::getPtrNative(
+                                accReferencePosition )
+                        )
+                );
+                alpaka::stream::enqueue( stream, listExec );
+
+                kernels::ReduceKernel<reduceBlockSize> reduceKernel;
+                auto const maxExec(
+                        alpaka::exec::create<TAccForce>(
+                            getWorkDivReduce( numBodies ),
+                            reduceKernel,
+                            static_cast<TSize const *>(
+                                alpaka::mem::view::getPtrNative(
+                                    accNumNeighbours ) ),
+                            static_cast<TSize>(0),
+                            static_cast<TSize>(1),
+                            numBodies,
+                            alpaka::mem::view::getPtrNative( accMaxNeighbours ),
+                            static_cast<TSize>(0),
+                            kernels::reduce::Max()
+                        )
+                );
+                alpaka::stream::enqueue( stream, maxExec );
+
+                alpaka::mem::view::copy(
+                        stream,
+                        hostMaxNeighbours,
+                        accMaxNeighbours,
+                        extentOne );
+                alpaka::wait::wait( stream );
+
+                TSize const maxNeighbours(
+                        *alpaka::mem::view::getPtrNative( hostMaxNeighbours ) );
+                if( maxNeighbours <= listLength )
+                    break;
+
+                listLength = maxNeighbours;
+                accNeighbours = alpaka::mem::buf::alloc<TSize, TSize>(
+                        devAcc, listLength * extentBodies[0] );
+            }
+
+            listsValid = true;
+            listCutoff = cutoff;
+            listSkin = skin;
+            listGeometry = cellList.getGeometry();
+            numBuilds++;
+        }
+    public:
+        // largest distance of a pair
+        TElem cutoff = static_cast<TElem>( 1 );
+        // extra radius of the Verlet lists, 0 disables them
+        TElem skin = static_cast<TElem>( 0 );
+        // box of periodic boundaries
+        types::Vector<NDim,TElem> boxOrigin =
+            types::Vector<NDim,TElem>( static_cast<TElem>( 0 ) );
+        TElem boxSize = static_cast<TElem>( 1 );
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            devHost(alpaka::dev::DevManCpu::getDevByIdx(0)),
+            extentBodies(numBodies),
+            cellList( devAcc, numBodies ),
+            unpack( devAcc ),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            listLength(32),
+            accNeighbours( alpaka::mem::buf::alloc
+                <TSize , TSize>( devAcc, listLength * numBodies ) ),
+            accNumNeighbours( alpaka::mem::buf::alloc
+                <TSize , TSize>( devAcc, extentBodies ) ),
+            accReferencePosition( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>( devAcc, extentBodies ) ),
+            accDisplacementSq( alpaka::mem::buf::alloc
+                <TElem , TSize>( devAcc, extentBodies ) ),
+            accMaxDisplacementSq( alpaka::mem::buf::alloc
+                <TElem , TSize>( devAcc, 1 ) ),
+            hostMaxDisplacementSq( alpaka::mem::buf::alloc
+                <TElem , TSize>( devHost, 1 ) ),
+            accMaxNeighbours( alpaka::mem::buf::alloc
+                <TSize , TSize>( devAcc, 1 ) ),
+            hostMaxNeighbours( alpaka::mem::buf::alloc
+                <TSize , TSize>( devHost, 1 ) ),
+            listsValid(false),
+            listCutoff(0),
+            listSkin(0),
+            numBuilds(0)
+        {}
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            if( !( skin > static_cast<TElem>( 0 ) ) )
+            {
+                /*** Cell list in every call ***/
+                listsValid = false;
+                cellList(
+                    stream,
+                    bodiesPosition,
+                    bodiesMass,
+                    numBodies,
+                    cutoff,
+                    boxOrigin,
+                    boxSize,
+                    elements );
+
+                kernels::CellCutoffKernel<TPeriodic,TForceLaw> cutoffKernel;
+                auto const cutoffExec(
+                        alpaka::exec::create<TAccBodies>(
+                            cellList.getWorkDiv( numBodies, elements ),
+                            cutoffKernel,
+                            cellList.getGeometry(),
+                            static_cast<TSize const *>( cellList.getKeys() ),
+                            static_cast<TSize const *>( cellList.getCellBegin() ),
+                            static_cast<TSize const *>( cellList.getCellEnd() ),
+                            static_cast<types::Vector<NDim,TElem> const *>(
+                                cellList.getSortedPositions() ),
+                            static_cast<TElem const *>(
+                                cellList.getSortedMasses() ),
+                            static_cast<TSize const *>(
+                                cellList.getPermutation() ),
+                            numBodies,
+                            cutoff,
+                            smoothnessFactor,
+                            alpaka::mem::view::getPtrNative(
+                                accBodiesAcceleration )
+                        )
+                );
+                alpaka::stream::enqueue( stream, cutoffExec );
+                return;
+            }
+
+            /*** Verlet lists ***/
+            bool build( !listsValid || cutoff != listCutoff || skin != listSkin );
+            if( !build )
+            {
+                TElem const halfSkin( skin / static_cast<TElem>( 2 ) );
+                build = getMaxDisplacementSq(
+                        stream, bodiesPosition, numBodies, elements ) >
+                    halfSkin * halfSkin;
+            }
+            if( build )
+                buildLists(
+                    stream,
+                    bodiesPosition,
+                    bodiesMass,
+                    numBodies,
+                    elements );
+
+            kernels::VerletForceKernel<TPeriodic,TForceLaw> forceKernel;
+            auto const forceExec(
+                    alpaka::exec::create<TAccBodies>(
+                        cellList.getWorkDiv( numBodies, elements ),
+                        forceKernel,
+                        listGeometry,
+                        bodiesPosition,
+                        bodiesMass,
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accNeighbours ) ),
+                        static_cast<TSize const *>(
+                            alpaka::mem::view::getPtrNative( accNumNeighbours ) ),
+                        listLength,
+                        numBodies,
+                        cutoff,
+                        smoothnessFactor,
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, forceExec );
+        }
+
+        /** Calculates the accelerations of bodies in any layout
+         *
+         * Bodies which are not stored in the AoS layout are
+         * copied into separate arrays first.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            unpack( stream, bodies, numBodies, elements );
+            (*this)(
+                stream,
+                unpack.getPositions(),
+                unpack.getMasses(),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        // Builds the lists again in the next call, e.g. after
+        // the bodies were reordered
+        auto invalidate()
+        -> void
+        {
+            listsValid = false;
+        }
+
+        // Number of times the Verlet lists were built
+        auto getNumBuilds() const
+        -> std::size_t
+        {
+            return numBuilds;
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+    };
+};
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,43 @@
+/** SIMD solver
+ *
+ * This file implements a solver which calculates
+ * the accelerations with the SimdAccelerationKernel.
+ * It is meant for the CPU backends, where every
+ * thread interacts a pack of bodies at once.
+ *
+ * @file simd.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+// SimdAccelerationKernel, simd::defaultWidth
+#include <simulation/kernels/simdAccelerationKernel.hpp>
+// DirectSum
+#include <simulation/solvers/fused.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** SIMD solver
+ *
+ * The default width is 16 with AVX-512 and 8 otherwise.
+ *
+ * @tparam TWidth influencing bodies per iteration
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    std::size_t TWidth = kernels::simd::defaultWidth,
+    typename TForceLaw = kernels::forceLaws::Plummer>
+using Simd = DirectSum<
+    kernels::SimdAccelerationKernel<TWidth, TForceLaw> >;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,25 @@
+/** A combined include for all solvers
+ *
+ * Combines all solvers in one include.
+ * Less hassle for those who use the solvers
+ *
+ * @file solvers.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include "forceMatrix.hpp"
+#include "fused.hpp"
+#include "tiled.hpp"
+#include "simd.hpp"
+#include "mixed.hpp"
+#include "symmetric.hpp"
+#include "sourcesSinks.hpp"
+#include "barnesHut.hpp"
+#include "fmm.hpp"
+#include "particleMesh.hpp"
+#include "p3m.hpp"
+#include "shortRange.hpp"
+#include "ring.hpp"
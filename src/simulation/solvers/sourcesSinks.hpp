@@ -0,0 +1,242 @@
+/** Sources sinks solver
+ *
+ * This file implements a solver for tracer runs, which
+ * calculates the accelerations with the SourcesSinksKernel.
+ * Only the massive bodies act as sources, the massless
+ * tracers are only accelerated.
+ *
+ * @file sourcesSinks.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// SourcesSinksKernel
+#include <simulation/kernels/sourcesSinksKernel.hpp>
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <ostream> // std::ostream
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Sources sinks solver
+ *
+ * Needs O(N) memory and O(M N) interactions for M massive
+ * bodies. The massive bodies have to come first, all bodies
+ * after the first numSources are tracers. After a call the
+ * acceleration/G of body i is stored in element i of a
+ * N-sized buffer.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicSourcesSinks
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator (unused)
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+
+        /*** Plan ***/
+        // elements the work division was chosen for
+        std::size_t planElements;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivAcceleration;
+
+        auto getWorkDivAcceleration(
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                    devAcc,
+                    extentBodies,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+    public:
+        // number of the first bodies which are sources,
+        // the Simulation sets it to its massive bodies
+        TSize numSources;
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            planElements(1),
+            workDivAcceleration( getWorkDivAcceleration( planElements ) ),
+            numSources(numBodies)
+        {}
+
+        /** Chooses the work division for elements
+         *
+         * Only does something if elements changed since the
+         * last call, so it is cheap to call before every launch.
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            if( elements == planElements )
+                return;
+            planElements = elements;
+            workDivAcceleration = getWorkDivAcceleration( elements );
+        }
+
+        // Writes the work division of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "sources sinks: " << workDivAcceleration << "\n";
+        }
+
+        /** Calculates the accelerations
+         *
+         * The kernel reads the bodies in their layout.
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+
+            TSize const sources( ( numSources < numBodies ) ?
+                    numSources : numBodies );
+
+            kernels::BasicSourcesSinksKernel<TForceLaw> sourcesSinksKernel;
+
+            auto const sourcesSinksKernelExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivAcceleration,
+                        sourcesSinksKernel,
+                        bodies,
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesAcceleration ),
+                        numBodies,
+                        sources,
+                        smoothnessFactor
+                    )
+            );
+
+            alpaka::stream::enqueue( stream, sourcesSinksKernelExec );
+        }
+
+        /** Calculates the accelerations of separate arrays
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            // the kernel only reads the bodies
+            (*this)(
+                stream,
+                types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                    const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                    const_cast<TElem *>( bodiesMass ) ),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+    };
+};
+
+using SourcesSinks = BasicSourcesSinks<kernels::forceLaws::Plummer>;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
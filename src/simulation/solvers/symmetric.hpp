@@ -0,0 +1,301 @@
+/** Symmetric solver
+ *
+ * This file implements a solver which evaluates every
+ * pair of bodies only once with the SymmetricPairKernel
+ * and merges the partial accelerations of the threads
+ * with the SymmetricMergeKernel.
+ *
+ * @file symmetric.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+// SymmetricPairKernel, SymmetricMergeKernel
+#include <simulation/kernels/symmetricKernels.hpp>
+// Bodies, layouts
+#include <simulation/types/bodies.hpp>
+// Vector
+#include <simulation/types/vector.hpp>
+#include <algorithm> // std::max
+#include <ostream> // std::ostream
+#include <thread> // std::thread::hardware_concurrency
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Symmetric solver
+ *
+ * Needs O(P N) memory for P partitions and half the
+ * interactions of the direct summation. After a call the
+ * acceleration/G of body i is stored in element i of a
+ * N-sized buffer. Every partition is one thread, so it is
+ * meant for the CPU backends, where a few partitions per
+ * core keep all cores busy.
+ *
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    typename TForceLaw>
+class BasicSymmetric
+{
+public:
+    /** Solver for a pair of accelerators
+     *
+     * @tparam TAccForce 2-dimensional accelerator (unused)
+     * @tparam TAccBodies 1-dimensional accelerator
+     * @tparam NDim Dimension of the vectors
+     * @tparam TElem datatype of mass and position
+     * @tparam TSize size type
+     */
+    template<
+        typename TAccForce,
+        typename TAccBodies,
+        std::size_t NDim,
+        typename TElem,
+        typename TSize>
+    class Solver
+    {
+    private:
+        alpaka::dev::Dev<TAccBodies> devAcc;
+
+        alpaka::Vec<
+            alpaka::dim::DimInt<1u>,TSize>
+            const extentBodies;
+
+        // number of partial accelerations accPartialAcceleration can hold
+        TSize capacityPartial;
+
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, extentBodies) ) accBodiesAcceleration;
+        decltype( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>(
+                    devAcc, capacityPartial) ) accPartialAcceleration;
+
+        /*** Plan ***/
+        // elements and partitions the work divisions were chosen for,
+        // planElements is 0 until the first updatePlan
+        std::size_t planElements;
+        TSize planPartitions;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivPairs;
+        alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize> workDivMerge;
+
+        auto getWorkDiv(
+                alpaka::Vec<alpaka::dim::DimInt<1u>,TSize> const & extent,
+                std::size_t const elements) const
+        -> alpaka::workdiv::WorkDivMembers<
+            alpaka::dim::DimInt<1u>,
+            TSize>
+        {
+            return alpaka::workdiv::getValidWorkDiv< TAccBodies >(
+                    devAcc,
+                    extent,
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >(elements),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted );
+        }
+    public:
+        /** Threads which share the pairs
+         *
+         * Every partition owns a row of N partial accelerations,
+         * which the merge reads again, so the memory and the
+         * merge grow with the partitions. The partitions do the
+         * same work, so one per hardware thread of the host
+         * already keeps every core busy.
+         */
+        TSize partitions = static_cast<TSize>(
+                std::max( std::thread::hardware_concurrency(), 1u ) );
+
+        Solver(
+                alpaka::dev::Dev<TAccBodies> const & devAcc,
+                TSize numBodies) :
+            devAcc(devAcc),
+            extentBodies(numBodies),
+            capacityPartial(1),
+            accBodiesAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, extentBodies ) ),
+            accPartialAcceleration( alpaka::mem::buf::alloc
+                <types::Vector<NDim,TElem> , TSize>
+                ( devAcc, capacityPartial ) ),
+            planElements(0),
+            planPartitions(1),
+            workDivPairs( getWorkDiv( extentBodies, 1 ) ),
+            workDivMerge( getWorkDiv( extentBodies, 1 ) )
+        {}
+
+        /** Chooses the work divisions for elements and partitions
+         *
+         * Only does something if one of them changed since the
+         * last call, so it is cheap to call before every launch.
+         *
+         * @param elements Alpaka elements per thread
+         */
+        auto updatePlan(
+                std::size_t const elements)
+        -> void
+        {
+            TSize const numPartitions( ( partitions > 0 ) ?
+                    partitions : static_cast<TSize>( 1 ) );
+            if( elements == planElements && numPartitions == planPartitions )
+                return;
+            planElements = elements;
+            planPartitions = numPartitions;
+            // one partition per thread
+            workDivPairs = getWorkDiv(
+                    alpaka::Vec<
+                        alpaka::dim::DimInt<1u>,
+                        TSize
+                    >( numPartitions ),
+                    1 );
+            workDivMerge = getWorkDiv( extentBodies, elements );
+        }
+
+        // Writes the work divisions of the plan to os
+        auto printPlan(
+                std::ostream & os) const
+        -> void
+        {
+            os << "pairs: " << workDivPairs << "\n";
+            os << "merge: " << workDivMerge << "\n";
+        }
+
+        /** Calculates the accelerations
+         *
+         * @param stream stream of the accelerator
+         * @param bodies positions and masses of the bodies
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TLayout,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Bodies<TLayout,NDim,TElem,TSize> const & bodies,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            updatePlan( elements );
+            TSize const numPartitions( planPartitions );
+            if( capacityPartial < numPartitions * numBodies )
+            {
+                // the last call may still use the old rows
+                alpaka::wait::wait( stream );
+                capacityPartial = numPartitions * numBodies;
+                accPartialAcceleration = alpaka::mem::buf::alloc
+                    <types::Vector<NDim,TElem>, TSize>(
+                        devAcc, capacityPartial );
+            }
+
+            /*** Pairs ***/
+            kernels::BasicSymmetricPairKernel<TForceLaw> pairKernel;
+            auto const pairExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivPairs,
+                        pairKernel,
+                        bodies,
+                        numBodies,
+                        numPartitions,
+                        smoothnessFactor,
+                        alpaka::mem::view::getPtrNative(
+                            accPartialAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, pairExec );
+
+            /*** Merge ***/
+            kernels::SymmetricMergeKernel mergeKernel;
+            auto const mergeExec(
+                    alpaka::exec::create<TAccBodies>(
+                        workDivMerge,
+                        mergeKernel,
+                        static_cast<types::Vector<NDim,TElem> const *>(
+                            alpaka::mem::view::getPtrNative(
+                                accPartialAcceleration ) ),
+                        numBodies,
+                        numPartitions,
+                        alpaka::mem::view::getPtrNative(
+                            accBodiesAcceleration )
+                    )
+            );
+            alpaka::stream::enqueue( stream, mergeExec );
+        }
+
+        /** Calculates the accelerations of separate arrays
+         *
+         * @param stream stream of the accelerator
+         * @param bodiesPosition array of the bodies' position
+         * @param bodiesMass array of the bodies' mass
+         * @param numBodies number of bodies
+         * @param smoothnessFactor Smoothness Factor
+         * @param elements Alpaka elements per thread
+         */
+        template<
+            typename TStream,
+            typename TFactor>
+        auto operator()(
+                TStream & stream,
+                types::Vector<NDim,TElem> const * const bodiesPosition,
+                TElem const * const bodiesMass,
+                TSize const numBodies,
+                TFactor const smoothnessFactor,
+                std::size_t const elements)
+        -> void
+        {
+            // the kernels only read the bodies
+            (*this)(
+                stream,
+                types::Bodies<types::layouts::AoS,NDim,TElem,TSize>(
+                    const_cast<types::Vector<NDim,TElem> *>( bodiesPosition ),
+                    const_cast<TElem *>( bodiesMass ) ),
+                numBodies,
+                smoothnessFactor,
+                elements );
+        }
+
+        /** Accelerations of the last call
+         *
+         * The acceleration/G of body i is stored at
+         * (char*)getAccelerations() + i * getPitchBytesAccelerations()
+         */
+        auto getAccelerations()
+        -> types::Vector<NDim,TElem> *
+        {
+            return alpaka::mem::view::getPtrNative( accBodiesAcceleration );
+        }
+
+        // The buffer is contiguous, so every "row" is one vector
+        auto getPitchBytesAccelerations() const
+        -> TSize
+        {
+            return static_cast<TSize>( sizeof( types::Vector<NDim,TElem> ) );
+        }
+    };
+};
+
+using Symmetric = BasicSymmetric<kernels::forceLaws::Plummer>;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,47 @@
+/** Tiled solver
+ *
+ * This file implements a solver which calculates
+ * the accelerations with the TiledAccelerationKernel.
+ * Like the fused solver it only needs O(N) memory,
+ * but the influencing bodies are shared between the
+ * threads of a block.
+ *
+ * @file tiled.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+// TiledAccelerationKernel
+#include <simulation/kernels/tiledAccelerationKernel.hpp>
+// DirectSum
+#include <simulation/solvers/fused.hpp>
+
+namespace nbody {
+
+namespace simulation {
+
+namespace solvers {
+
+/** Tiled solver
+ *
+ * @tparam TTileSize number of influencing bodies per tile
+ * @tparam TSinksPerPass influenced bodies per thread and pass
+ * @tparam TForceLaw interaction of two bodies, see kernels::forceLaws
+ */
+template<
+    std::size_t TTileSize,
+    std::size_t TSinksPerPass = 4,
+    typename TForceLaw = kernels::forceLaws::Plummer>
+using Tiled = DirectSum<
+    kernels::TiledAccelerationKernel<
+        TTileSize,
+        TSinksPerPass,
+        TForceLaw> >;
+
+} // namespace solvers
+
+} // namespace simulation
+
+} // namespace nbody
@@ -0,0 +1,361 @@
+/** Storage layouts of the bodies
+ *
+ * This file defines the layouts in which the positions and
+ * masses of the bodies can be stored and the Bodies view,
+ * which hides the layout from the kernels.
+ *
+ * @file bodies.hpp
+ * @version 0.1
+ * @date Saturday, 17. October 2026
+ */
+
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <alpaka/alpaka.hpp> // ALPAKA_FN_HOST_ACC
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace types {
+
+namespace layouts {
+
+/** Array of structures
+ *
+ * An array of the positions followed by an array of the masses.
+ * This is the layout of the host arrays of the Simulation.
+ */
+struct AoS {};
+
+/** Padded array of structures
+ *
+ * Every body is padded to a power of two lanes, the position
+ * followed by the mass. In three dimensions this is one
+ * 4-wide vector per body, so a body is loaded at once.
+ */
+struct AoS4 {};
+
+// smallest power of two which is atleast lanes
+constexpr auto padded(
+    std::size_t const lanes,
+    std::size_t const power = 1)
+-> std::size_t
+{
+    return ( power >= lanes ) ? power : padded( lanes, 2 * power );
+}
+
+/** Structure of arrays
+ *
+ * One array per coordinate and one for the masses.
+ */
+struct SoA {};
+
+/** Array of structures of arrays
+ *
+ * Blocks of TBlockSize bodies, every block is stored like SoA.
+ * The last block is padded.
+ *
+ * @tparam TBlockSize bodies per block
+ */
+template<
+    std::size_t TBlockSize = 8>
+struct AoSoA {};
+
+} // namespace layouts
+
+/** View of the bodies in a layout
+ *
+ * A Bodies view is a pair of pointers and sizes, it can be
+ * passed by value to the kernels. All layouts have the same
+ * interface: size() for the number of TElem needed for the
+ * storage, a constructor from the storage and getPosition,
+ * getMass, setPosition and setMass.
+ *
+ * @tparam TLayout layout of the storage, see namespace layouts
+ * @tparam NDim Dimension of the vectors
+ * @tparam TElem datatype of mass and position
+ * @tparam TSize size type
+ */
+template<
+    typename TLayout,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Bodies;
+
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Bodies<
+    layouts::AoS,
+    NDim,
+    TElem,
+    TSize>
+{
+public:
+    Vector<NDim,TElem> * position;
+    TElem * mass;
+
+    ALPAKA_FN_HOST_ACC static auto size(
+        TSize const numBodies)
+    -> TSize
+    {
+        return numBodies * static_cast<TSize>( NDim + 1 );
+    }
+
+    ALPAKA_FN_HOST_ACC Bodies(
+        TElem * const data,
+        TSize const numBodies) :
+        position( reinterpret_cast<Vector<NDim,TElem> *>( data ) ),
+        mass( data + numBodies * static_cast<TSize>( NDim ) )
+    {}
+
+    // View of separate arrays
+    ALPAKA_FN_HOST_ACC Bodies(
+        Vector<NDim,TElem> * const position,
+        TElem * const mass) :
+        position( position ),
+        mass( mass )
+    {}
+
+    ALPAKA_FN_HOST_ACC auto getPosition(
+        TSize const i) const
+    -> Vector<NDim,TElem>
+    {
+        return position[ i ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto getMass(
+        TSize const i) const
+    -> TElem
+    {
+        return mass[ i ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setPosition(
+        TSize const i,
+        Vector<NDim,TElem> const & value) const
+    -> void
+    {
+        position[ i ] = value;
+    }
+
+    ALPAKA_FN_HOST_ACC auto setMass(
+        TSize const i,
+        TElem const value) const
+    -> void
+    {
+        mass[ i ] = value;
+    }
+};
+
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Bodies<
+    layouts::AoS4,
+    NDim,
+    TElem,
+    TSize>
+{
+public:
+    // lanes per body, the mass is in the last one
+    static constexpr std::size_t lanes = layouts::padded( NDim + 1 );
+
+    TElem * data;
+
+    ALPAKA_FN_HOST_ACC static auto size(
+        TSize const numBodies)
+    -> TSize
+    {
+        return numBodies * static_cast<TSize>( lanes );
+    }
+
+    ALPAKA_FN_HOST_ACC Bodies(
+        TElem * const data,
+        TSize const) :
+        data( data )
+    {}
+
+    ALPAKA_FN_HOST_ACC auto getPosition(
+        TSize const i) const
+    -> Vector<NDim,TElem>
+    {
+        Vector<NDim,TElem> result;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            result[ d ] = data[ i * lanes + d ];
+        return result;
+    }
+
+    ALPAKA_FN_HOST_ACC auto getMass(
+        TSize const i) const
+    -> TElem
+    {
+        return data[ i * lanes + lanes - 1 ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setPosition(
+        TSize const i,
+        Vector<NDim,TElem> const & value) const
+    -> void
+    {
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            data[ i * lanes + d ] = value[ d ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setMass(
+        TSize const i,
+        TElem const value) const
+    -> void
+    {
+        data[ i * lanes + lanes - 1 ] = value;
+    }
+};
+
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Bodies<
+    layouts::SoA,
+    NDim,
+    TElem,
+    TSize>
+{
+public:
+    TElem * data;
+    TSize numBodies;
+
+    ALPAKA_FN_HOST_ACC static auto size(
+        TSize const numBodies)
+    -> TSize
+    {
+        return numBodies * static_cast<TSize>( NDim + 1 );
+    }
+
+    ALPAKA_FN_HOST_ACC Bodies(
+        TElem * const data,
+        TSize const numBodies) :
+        data( data ),
+        numBodies( numBodies )
+    {}
+
+    ALPAKA_FN_HOST_ACC auto getPosition(
+        TSize const i) const
+    -> Vector<NDim,TElem>
+    {
+        Vector<NDim,TElem> result;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            result[ d ] = data[ d * numBodies + i ];
+        return result;
+    }
+
+    ALPAKA_FN_HOST_ACC auto getMass(
+        TSize const i) const
+    -> TElem
+    {
+        return data[ NDim * numBodies + i ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setPosition(
+        TSize const i,
+        Vector<NDim,TElem> const & value) const
+    -> void
+    {
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            data[ d * numBodies + i ] = value[ d ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setMass(
+        TSize const i,
+        TElem const value) const
+    -> void
+    {
+        data[ NDim * numBodies + i ] = value;
+    }
+};
+
+template<
+    std::size_t TBlockSize,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+class Bodies<
+    layouts::AoSoA<TBlockSize>,
+    NDim,
+    TElem,
+    TSize>
+{
+    static_assert( TBlockSize > 0, "A block needs atleast one body." );
+private:
+    // index of the first coordinate of body i
+    ALPAKA_FN_HOST_ACC static auto block(
+        TSize const i)
+    -> TSize
+    {
+        return ( i / TBlockSize ) * TBlockSize * ( NDim + 1 ) + i % TBlockSize;
+    }
+public:
+    TElem * data;
+
+    ALPAKA_FN_HOST_ACC static auto size(
+        TSize const numBodies)
+    -> TSize
+    {
+        return ( numBodies + TBlockSize - 1 ) / TBlockSize *
+            static_cast<TSize>( TBlockSize * ( NDim + 1 ) );
+    }
+
+    ALPAKA_FN_HOST_ACC Bodies(
+        TElem * const data,
+        TSize const) :
+        data( data )
+    {}
+
+    ALPAKA_FN_HOST_ACC auto getPosition(
+        TSize const i) const
+    -> Vector<NDim,TElem>
+    {
+        TElem const * const first( data + block( i ) );
+        Vector<NDim,TElem> result;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            result[ d ] = first[ d * TBlockSize ];
+        return result;
+    }
+
+    ALPAKA_FN_HOST_ACC auto getMass(
+        TSize const i) const
+    -> TElem
+    {
+        return data[ block( i ) + NDim * TBlockSize ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setPosition(
+        TSize const i,
+        Vector<NDim,TElem> const & value) const
+    -> void
+    {
+        TElem * const first( data + block( i ) );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            first[ d * TBlockSize ] = value[ d ];
+    }
+
+    ALPAKA_FN_HOST_ACC auto setMass(
+        TSize const i,
+        TElem const value) const
+    -> void
+    {
+        data[ block( i ) + NDim * TBlockSize ] = value;
+    }
+};
+
+} // namespace types
+
+} // namespace simulation
+
+} // namespace nbody
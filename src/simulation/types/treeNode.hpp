@@ -0,0 +1,58 @@
+/** Tree node type
+ *
+ * This file defines the node of the 2^NDim-ary
+ * tree which is used by the tree code. The bodies
+ * are sorted along a Morton curve, so every node
+ * covers a contiguous range of bodies.
+ *
+ * @file treeNode.hpp
+ * @version 0.1
+ * @date Friday, 16. October 2026
+ */
+
+#pragma once
+
+#include <simulation/types/vector.hpp> // Vector
+
+namespace nbody {
+
+namespace simulation {
+
+namespace types {
+
+/** Node of a quadtree (NDim = 2) or octree (NDim = 3)
+ *
+ * The children of a node are stored one after another,
+ * so only the index of the first one is needed. The root
+ * never is a child, therefore firstChild == 0 marks a leaf.
+ *
+ * @tparam NDim dimension of the tree
+ * @tparam TElem type of the coordinates
+ * @tparam TSize type of the indices
+ */
+template<
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+struct TreeNode
+{
+    std::size_t const static numChildren = std::size_t(1) << NDim;
+
+    // first body
+    TSize begin;
+    // one behind the last body
+    TSize end;
+    // index of the first child, 0 for leaves
+    TSize firstChild;
+    // edge length of the cell
+    TElem size;
+    // monopole moment
+    TElem mass;
+    Vector<NDim,TElem> centerOfMass;
+};
+
+} // namespace types
+
+} // namespace simulation
+
+} // namespace nbody
@@ -219,6 +219,28 @@ public:
         return *this;
     }
 
+    /** -= operator for Vector
+     *
+     * This operator subtracts another vector from the current
+     * vector without creating a new vector
+     *
+     * @param other The vector to be subtracted
+     * @return The current vector after the subtraction
+     */
+    template<
+        typename TElemOther
+    >
+    ALPAKA_FN_ACC
+    auto
+    operator-= ( Vector< NDim, TElemOther > const other )
+    -> Vector<NDim, TElem>&
+    {
+        for( std::size_t i = 0; i < NDim; i++ ) {
+            this->coord[ i ] = ( TElem )( this->coord[ i ] - other[ i ] );
+        }
+        return *this;
+    }
+
     /** - operator for Vector
      *
      * This operator subtract another vector from the
@@ -0,0 +1,883 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AccelerationTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // pow
+#include <algorithm> // std::max
+#include <ratio> // std::ratio
+#include <alpaka/alpaka.hpp>
+#include <simulation/kernels/accelerationKernel.hpp> // AccelerationKernel
+// TiledAccelerationKernel
+#include <simulation/kernels/tiledAccelerationKernel.hpp>
+// SimdAccelerationKernel
+#include <simulation/kernels/simdAccelerationKernel.hpp>
+#include <simulation/solvers/mixed.hpp> // Mixed, Compensated
+#include <simulation/solvers/symmetric.hpp> // Symmetric
+#include <simulation/solvers/tiled.hpp> // Tiled
+#include <simulation/solvers/simd.hpp> // Simd
+// SourcesSinks
+#include <simulation/solvers/sourcesSinks.hpp>
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+template<
+    std::size_t NDim,
+    typename TElem
+>
+using Vector = nbody::simulation::types::Vector<NDim,TElem>;
+
+template<
+    std::size_t NDim,
+    typename TElem
+>
+std::ostream& operator<<(std::ostream & s, Vector<NDim, TElem> vec) {
+    s << "(" << vec[0];
+    for(unsigned int i = 1; i < NDim; i++) {
+        s << ", " << vec[i];
+    }
+    s << ")";
+    return s;
+}
+
+// Run kernel easily in tests
+template<
+    typename TAcc,
+    typename TStream,
+    typename TVector,
+    typename TKernel = nbody::simulation::kernels::AccelerationKernel
+>
+auto
+createAccelerations(
+        TVector * bodiesPosition,
+        typename TVector::type * bodiesMass,
+        std::size_t numBodies,
+        float const smoothnessFactor,
+        std::size_t const elements = 1)
+-> TVector*
+{
+    using Kernel = TKernel;
+    using Size = std::size_t;
+
+    /*** Kernel ***/
+    Kernel kernel;
+
+    /*** Devices ***/
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+
+    alpaka::dev::Dev<TAcc> devAcc( alpaka::dev::DevMan<TAcc>::getDevByIdx( 0 ) );
+
+    TStream stream(devAcc);
+
+    /*** Work extent ***/
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,
+        Size
+    > const extentBodies( numBodies );
+
+    alpaka::workdiv::WorkDivMembers<
+        alpaka::dim::DimInt<1u>,
+        Size
+    > const workDiv(
+        alpaka::workdiv::getValidWorkDiv< TAcc >(
+            devAcc,
+            extentBodies,
+            alpaka::Vec<
+                alpaka::dim::DimInt<1u>,
+                Size
+            >(elements),
+            false,
+            alpaka::workdiv::GridBlockExtentSubDivRestrictions::Unrestricted
+        )
+    );
+
+    std::cout << workDiv << std::endl;
+
+    /*** Memory Host ***/
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type,
+        TVector,
+        alpaka::dim::DimInt<1u>,
+        Size>
+    hostBufBodiesPosition(
+            bodiesPosition,
+            devHost,
+            extentBodies);
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type,
+        typename TVector::type,
+        alpaka::dim::DimInt<1u>,
+        Size>
+    hostBufBodiesMass(
+            bodiesMass,
+            devHost,
+            extentBodies);
+
+    TVector* accelerations = new TVector[ numBodies ];
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type,
+        TVector,
+        alpaka::dim::DimInt<1u>,
+        Size>
+    hostBufAccelerations(
+            accelerations,
+            devHost,
+            extentBodies);
+
+    /*** Memory Acc ***/
+    auto accBufBodiesPosition(
+            alpaka::mem::buf::alloc<TVector, Size>(devAcc, extentBodies));
+
+    auto accBufBodiesMass(
+            alpaka::mem::buf::alloc<typename TVector::type, Size>(devAcc, extentBodies));
+
+    auto accBufAccelerations(
+            alpaka::mem::buf::alloc<TVector, Size>(devAcc, extentBodies));
+
+    /*** Memory Copy ***/
+    alpaka::mem::view::copy(
+            stream,
+            accBufBodiesPosition,
+            hostBufBodiesPosition,
+            extentBodies);
+
+    alpaka::mem::view::copy(
+            stream,
+            accBufBodiesMass,
+            hostBufBodiesMass,
+            extentBodies);
+
+    /*** Execution ***/
+    auto const kernelExec(
+            alpaka::exec::create<TAcc>(
+                workDiv,
+                kernel,
+                alpaka::mem::view::getPtrNative( accBufBodiesPosition ),
+                alpaka::mem::view::getPtrNative( accBufBodiesMass ),
+                alpaka::mem::view::getPtrNative( accBufAccelerations ),
+                numBodies,
+                smoothnessFactor
+            )
+        );
+
+    // Wait for data
+    alpaka::wait::wait( stream );
+
+    alpaka::stream::enqueue( stream, kernelExec );
+
+    // Wait for execution
+    alpaka::wait::wait( stream );
+
+    /*** Memory Copy back ***/
+    alpaka::mem::view::copy(
+            stream,
+            hostBufAccelerations,
+            accBufAccelerations,
+            extentBodies);
+
+    // Wait for copy operation
+    alpaka::wait::wait( stream );
+
+    return accelerations;
+}
+
+BOOST_AUTO_TEST_CASE( acceleration3D )
+{
+    using Vector3F = Vector<3,float>;
+    Vector3F bodiesPosition[3];
+    bodiesPosition[0] = Vector3F{1.0f,0.0f,0.0f};
+    bodiesPosition[1] = Vector3F{-1.0f,0.0f,0.0f};
+    bodiesPosition[2] = Vector3F{0.0f,2.0f,0.0f};
+
+    float bodiesMass[3] = {
+        2.0f,
+        1.0f,
+        3.0f
+    };
+
+    // Same result as the row sums of the force matrix
+    Vector3F accelerationsResult[3];
+    for( std::size_t i(0); i < 3; i++ )
+    {
+        accelerationsResult[i] = Vector3F(0.0f);
+        for( std::size_t j(0); j < 3; j++ )
+        {
+            if( i == j )
+                continue;
+            Vector3F distance( bodiesPosition[j] - bodiesPosition[i] );
+            accelerationsResult[i] += bodiesMass[j] /
+                pow( distance.absSq(), 1.5f ) * distance;
+        }
+    }
+
+    printf("Test with CPU\n");
+    Vector3F* accelerations = createAccelerations<
+        alpaka::acc::AccCpuSerial<
+            alpaka::dim::DimInt<1u>,
+            std::size_t >,
+        alpaka::stream::StreamCpuSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            3,
+            0.0f);
+
+    for( std::size_t i(0); i < 3; i++ )
+    {
+        std::cout << accelerations[i] << accelerationsResult[i] << std::endl;
+        for( std::size_t d(0); d < 3; d++ )
+        {
+            BOOST_CHECK_CLOSE( accelerations[i][d] + 1.0f,
+                    accelerationsResult[i][d] + 1.0f, 1e-4 );
+        }
+    }
+    delete[] accelerations;
+
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+    printf("Test with CUDA\n");
+    accelerations = createAccelerations<
+        alpaka::acc::AccGpuCudaRt<
+            alpaka::dim::DimInt<1u>,
+            std::size_t>,
+        alpaka::stream::StreamCudaRtSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            3,
+            0.0f);
+
+    for( std::size_t i(0); i < 3; i++ )
+    {
+        for( std::size_t d(0); d < 3; d++ )
+        {
+            BOOST_CHECK_CLOSE( accelerations[i][d] + 1.0f,
+                    accelerationsResult[i][d] + 1.0f, 1e-4 );
+        }
+    }
+    delete[] accelerations;
+#endif
+
+}
+
+BOOST_AUTO_TEST_CASE( tiledAcceleration2D )
+{
+    using Vector2F = Vector<2,float>;
+    using TiledKernel =
+        nbody::simulation::kernels::TiledAccelerationKernel<8,4>;
+    std::size_t const numBodies = 37;
+    Vector2F bodiesPosition[numBodies];
+    float bodiesMass[numBodies];
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        bodiesPosition[i] = Vector2F{
+            static_cast<float>( (i * 7) % 11 ),
+            static_cast<float>( (i * 5) % 13 ) - 6.0f};
+        bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+    }
+
+    Vector2F* reference = createAccelerations<
+        alpaka::acc::AccCpuSerial<
+            alpaka::dim::DimInt<1u>,
+            std::size_t >,
+        alpaka::stream::StreamCpuSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+
+    // Tiles which are only partly filled and elements which
+    // are no multiple of the sinks per pass
+    for( std::size_t elements : {1u, 3u, 8u} )
+    {
+        printf("Test with CPU and %zu elements\n", elements);
+        Vector2F* accelerations = createAccelerations<
+            alpaka::acc::AccCpuOmp2Threads<
+                alpaka::dim::DimInt<1u>,
+                std::size_t >,
+            alpaka::stream::StreamCpuSync,
+            Vector2F,
+            TiledKernel
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                elements);
+
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            for( std::size_t d(0); d < 2; d++ )
+            {
+                BOOST_CHECK_CLOSE( accelerations[i][d] + 1.0f,
+                        reference[i][d] + 1.0f, 1e-3 );
+            }
+        }
+        delete[] accelerations;
+    }
+    delete[] reference;
+}
+
+BOOST_AUTO_TEST_CASE( simdAcceleration3D )
+{
+    using Vector3F = Vector<3,float>;
+    std::size_t const numBodies = 37;
+    Vector3F bodiesPosition[numBodies];
+    float bodiesMass[numBodies];
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        bodiesPosition[i] = Vector3F{
+            static_cast<float>( (i * 7) % 11 ),
+            static_cast<float>( (i * 5) % 13 ) - 6.0f,
+            static_cast<float>( (i * 3) % 5 )};
+        bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+    }
+
+    Vector3F* reference = createAccelerations<
+        alpaka::acc::AccCpuSerial<
+            alpaka::dim::DimInt<1u>,
+            std::size_t >,
+        alpaka::stream::StreamCpuSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+
+    // Packs which are only partly filled, with the intrinsics
+    // of the target and the portable pack
+    for( std::size_t elements : {1u, 3u} )
+    {
+        printf("Test with CPU and %zu elements\n", elements);
+        Vector3F* accelerations8 = createAccelerations<
+            alpaka::acc::AccCpuOmp2Threads<
+                alpaka::dim::DimInt<1u>,
+                std::size_t >,
+            alpaka::stream::StreamCpuSync,
+            Vector3F,
+            nbody::simulation::kernels::SimdAccelerationKernel<8>
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                elements);
+        Vector3F* accelerations16 = createAccelerations<
+            alpaka::acc::AccCpuOmp2Threads<
+                alpaka::dim::DimInt<1u>,
+                std::size_t >,
+            alpaka::stream::StreamCpuSync,
+            Vector3F,
+            nbody::simulation::kernels::SimdAccelerationKernel<16>
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                elements);
+        Vector3F* accelerations5 = createAccelerations<
+            alpaka::acc::AccCpuOmp2Threads<
+                alpaka::dim::DimInt<1u>,
+                std::size_t >,
+            alpaka::stream::StreamCpuSync,
+            Vector3F,
+            nbody::simulation::kernels::SimdAccelerationKernel<5>
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                elements);
+
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            for( std::size_t d(0); d < 3; d++ )
+            {
+                BOOST_CHECK_CLOSE( accelerations8[i][d] + 1.0f,
+                        reference[i][d] + 1.0f, 1e-2 );
+                BOOST_CHECK_CLOSE( accelerations16[i][d] + 1.0f,
+                        reference[i][d] + 1.0f, 1e-2 );
+                BOOST_CHECK_CLOSE( accelerations5[i][d] + 1.0f,
+                        reference[i][d] + 1.0f, 1e-2 );
+            }
+        }
+        delete[] accelerations8;
+        delete[] accelerations16;
+        delete[] accelerations5;
+    }
+    delete[] reference;
+}
+
+BOOST_AUTO_TEST_CASE( symmetricAcceleration3D )
+{
+    using Vector3F = Vector<3,float>;
+    using Acc = alpaka::acc::AccCpuOmp2Threads<
+        alpaka::dim::DimInt<1u>,
+        std::size_t >;
+    std::size_t const numBodies = 37;
+    Vector3F bodiesPosition[numBodies];
+    float bodiesMass[numBodies];
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        bodiesPosition[i] = Vector3F{
+            static_cast<float>( (i * 7) % 11 ),
+            static_cast<float>( (i * 5) % 13 ) - 6.0f,
+            static_cast<float>( (i * 3) % 5 )};
+        bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+    }
+
+    Vector3F* reference = createAccelerations<
+        alpaka::acc::AccCpuSerial<
+            alpaka::dim::DimInt<1u>,
+            std::size_t >,
+        alpaka::stream::StreamCpuSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<Acc> devAcc( alpaka::dev::DevMan<Acc>::getDevByIdx( 0 ) );
+    alpaka::stream::StreamCpuSync stream( devAcc );
+    alpaka::Vec<alpaka::dim::DimInt<1u>,std::size_t> const extent( numBodies );
+
+    auto accPosition( alpaka::mem::buf::alloc<Vector3F, std::size_t>( devAcc, extent ) );
+    auto accMass( alpaka::mem::buf::alloc<float, std::size_t>( devAcc, extent ) );
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, Vector3F,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        hostPosition( bodiesPosition, devHost, extent );
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, float,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        hostMass( bodiesMass, devHost, extent );
+    alpaka::mem::view::copy( stream, accPosition, hostPosition, extent );
+    alpaka::mem::view::copy( stream, accMass, hostMass, extent );
+
+    nbody::simulation::solvers::Symmetric::Solver<
+        Acc, Acc, 3, float, std::size_t> solver( devAcc, numBodies );
+
+    // One partition, partitions which split rows and more
+    // partitions than pairs
+    for( std::size_t partitions : {1u, 5u, 64u, 1000u} )
+    {
+        printf("Test with CPU and %zu partitions\n", partitions);
+        solver.partitions = partitions;
+        solver(
+            stream,
+            alpaka::mem::view::getPtrNative( accPosition ),
+            alpaka::mem::view::getPtrNative( accMass ),
+            numBodies,
+            0.01f,
+            2 );
+
+        Vector3F accelerations[numBodies];
+        alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, Vector3F,
+            alpaka::dim::DimInt<1u>, std::size_t>
+            hostAcceleration( accelerations, devHost, extent );
+        alpaka::mem::view::ViewPlainPtr<alpaka::dev::Dev<Acc>, Vector3F,
+            alpaka::dim::DimInt<1u>, std::size_t>
+            accAcceleration( solver.getAccelerations(), devAcc, extent );
+        alpaka::mem::view::copy( stream, hostAcceleration, accAcceleration, extent );
+        alpaka::wait::wait( stream );
+
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            for( std::size_t d(0); d < 3; d++ )
+            {
+                BOOST_CHECK_CLOSE( accelerations[i][d] + 1.0f,
+                        reference[i][d] + 1.0f, 1e-2 );
+            }
+        }
+    }
+    delete[] reference;
+}
+
+// Accelerations of the bodies in double on the host
+template<
+    typename TVector>
+auto
+referenceAccelerations(
+        TVector const * bodiesPosition,
+        typename TVector::type const * bodiesMass,
+        std::size_t numBodies,
+        double const smoothnessFactor,
+        std::size_t const i)
+-> Vector<3,double>
+{
+    Vector<3,double> acceleration( 0.0 );
+    for( std::size_t j(0); j < numBodies; j++ )
+    {
+        if( i == j )
+            continue;
+        Vector<3,double> distance;
+        for( std::size_t d(0); d < 3; d++ )
+            distance[d] = static_cast<double>( bodiesPosition[j][d] ) -
+                static_cast<double>( bodiesPosition[i][d] );
+        acceleration += static_cast<double>( bodiesMass[j] ) /
+            pow( distance.absSq() + smoothnessFactor, 1.5 ) * distance;
+    }
+    return acceleration;
+}
+
+// Run a solver easily in tests
+template<
+    typename TAcc,
+    typename TSolver,
+    typename TVector>
+auto
+solveAccelerations(
+        TVector const * bodiesPosition,
+        typename TVector::type const * bodiesMass,
+        std::size_t numBodies,
+        float const smoothnessFactor,
+        std::size_t const elements = 1)
+-> TVector*
+{
+    using Elem = typename TVector::type;
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<TAcc> devAcc( alpaka::dev::DevMan<TAcc>::getDevByIdx( 0 ) );
+    alpaka::stream::StreamCpuSync stream( devAcc );
+    alpaka::Vec<alpaka::dim::DimInt<1u>,std::size_t> const extent( numBodies );
+
+    auto accPosition( alpaka::mem::buf::alloc<TVector, std::size_t>( devAcc, extent ) );
+    auto accMass( alpaka::mem::buf::alloc<Elem, std::size_t>( devAcc, extent ) );
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, TVector,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        hostPosition( const_cast<TVector*>( bodiesPosition ), devHost, extent );
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, Elem,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        hostMass( const_cast<Elem*>( bodiesMass ), devHost, extent );
+    alpaka::mem::view::copy( stream, accPosition, hostPosition, extent );
+    alpaka::mem::view::copy( stream, accMass, hostMass, extent );
+
+    typename TSolver::template Solver<
+        TAcc, TAcc, 3, Elem, std::size_t> solver( devAcc, numBodies );
+    solver(
+        stream,
+        alpaka::mem::view::getPtrNative( accPosition ),
+        alpaka::mem::view::getPtrNative( accMass ),
+        numBodies,
+        smoothnessFactor,
+        elements );
+
+    TVector* accelerations = new TVector[numBodies];
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::DevCpu, TVector,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        hostAcceleration( accelerations, devHost, extent );
+    alpaka::mem::view::ViewPlainPtr<alpaka::dev::Dev<TAcc>, TVector,
+        alpaka::dim::DimInt<1u>, std::size_t>
+        accAcceleration( solver.getAccelerations(), devAcc, extent );
+    alpaka::mem::view::copy( stream, hostAcceleration, accAcceleration, extent );
+    alpaka::wait::wait( stream );
+    return accelerations;
+}
+
+BOOST_AUTO_TEST_CASE( mixedAcceleration3D )
+{
+    namespace solvers = nbody::simulation::solvers;
+    using Acc = alpaka::acc::AccCpuOmp2Threads<
+        alpaka::dim::DimInt<1u>,
+        std::size_t >;
+
+    // Bodies in float: the compensated sum is closer to the
+    // sum in double than the plain one
+    {
+        using Vector3F = Vector<3,float>;
+        std::size_t const numBodies = 2000;
+        Vector3F* bodiesPosition = new Vector3F[numBodies];
+        float* bodiesMass = new float[numBodies];
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            bodiesPosition[i] = Vector3F{
+                static_cast<float>( (i * 7) % 101 ) * 0.1f,
+                static_cast<float>( (i * 5) % 113 ) * 0.1f - 6.0f,
+                static_cast<float>( (i * 3) % 97 ) * 0.1f};
+            bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+        }
+
+        Vector3F* plain = createAccelerations<
+            Acc,
+            alpaka::stream::StreamCpuSync
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                4);
+        Vector3F* compensated = solveAccelerations<
+            Acc,
+            solvers::Compensated
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                4);
+
+        double errorPlain( 0.0 );
+        double errorCompensated( 0.0 );
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            Vector<3,double> const reference( referenceAccelerations(
+                    bodiesPosition, bodiesMass, numBodies, 0.01, i ) );
+            for( std::size_t d(0); d < 3; d++ )
+            {
+                errorPlain = std::max( errorPlain,
+                        std::abs( plain[i][d] - reference[d] ) );
+                errorCompensated = std::max( errorCompensated,
+                        std::abs( compensated[i][d] - reference[d] ) );
+            }
+        }
+        std::cout << "plain: " << errorPlain
+            << ", compensated: " << errorCompensated << std::endl;
+        BOOST_CHECK_LT( errorCompensated, errorPlain );
+
+        delete[] plain;
+        delete[] compensated;
+        delete[] bodiesPosition;
+        delete[] bodiesMass;
+    }
+
+    // Bodies in double far from the origin, in two groups: the
+    // interactions in float only see the offsets to the centres
+    {
+        using Vector3D = Vector<3,double>;
+        std::size_t const numBodies = 37;
+        Vector3D bodiesPosition[numBodies];
+        double bodiesMass[numBodies];
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            bodiesPosition[i] = Vector3D{
+                1e8 + static_cast<double>( (i * 7) % 11 ),
+                static_cast<double>( (i * 5) % 13 ) - 6.0,
+                -1e8 + static_cast<double>( (i * 3) % 5 )};
+            bodiesMass[i] = 1.0 + static_cast<double>( i % 3 );
+        }
+
+        Vector3D* accelerations = solveAccelerations<
+            Acc,
+            solvers::Mixed<>
+        >(
+                bodiesPosition,
+                bodiesMass,
+                numBodies,
+                0.01f,
+                3);
+
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            Vector3D const reference( referenceAccelerations(
+                    bodiesPosition, bodiesMass, numBodies, 0.01, i ) );
+            for( std::size_t d(0); d < 3; d++ )
+            {
+                BOOST_CHECK_CLOSE( accelerations[i][d] + 1.0,
+                        reference[d] + 1.0, 1e-3 );
+            }
+        }
+        delete[] accelerations;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( forceLaws3D )
+{
+    namespace kernels = nbody::simulation::kernels;
+    using Vector3F = Vector<3,float>;
+    using Acc = alpaka::acc::AccCpuSerial<
+        alpaka::dim::DimInt<1u>,
+        std::size_t >;
+    std::size_t const numBodies = 37;
+    Vector3F bodiesPosition[numBodies];
+    float bodiesMass[numBodies];
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        bodiesPosition[i] = Vector3F{
+            static_cast<float>( (i * 7) % 11 ),
+            static_cast<float>( (i * 5) % 13 ) - 6.0f,
+            static_cast<float>( (i * 3) % 5 )};
+        bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+    }
+
+    Vector3F* plummer = createAccelerations<
+        Acc,
+        alpaka::stream::StreamCpuSync
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+    Vector3F* newton = createAccelerations<
+        Acc,
+        alpaka::stream::StreamCpuSync,
+        Vector3F,
+        kernels::BasicAccelerationKernel<kernels::forceLaws::Newton>
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+    Vector3F* coulomb = createAccelerations<
+        Acc,
+        alpaka::stream::StreamCpuSync,
+        Vector3F,
+        kernels::BasicAccelerationKernel<kernels::forceLaws::Coulomb>
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+    Vector3F* cutoff = createAccelerations<
+        Acc,
+        alpaka::stream::StreamCpuSync,
+        Vector3F,
+        kernels::BasicAccelerationKernel<
+            kernels::forceLaws::Cutoff<
+                kernels::forceLaws::Plummer,
+                std::ratio<5> > >
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        Vector<3,double> const reference( referenceAccelerations(
+                bodiesPosition, bodiesMass, numBodies, 0.0, i ) );
+        Vector<3,double> referenceCutoff( 0.0 );
+        for( std::size_t j(0); j < numBodies; j++ )
+        {
+            Vector<3,double> distance;
+            distance = bodiesPosition[j] - bodiesPosition[i];
+            if( i == j || distance.absSq() >= 25.0 )
+                continue;
+            referenceCutoff += static_cast<double>( bodiesMass[j] ) /
+                pow( distance.absSq() + 0.01, 1.5 ) * distance;
+        }
+        for( std::size_t d(0); d < 3; d++ )
+        {
+            BOOST_CHECK_CLOSE( newton[i][d] + 1.0f,
+                    reference[d] + 1.0, 1e-3 );
+            BOOST_CHECK_EQUAL( coulomb[i][d], -plummer[i][d] );
+            BOOST_CHECK_CLOSE( cutoff[i][d] + 1.0f,
+                    referenceCutoff[d] + 1.0, 1e-3 );
+        }
+    }
+    delete[] plummer;
+    delete[] newton;
+    delete[] coulomb;
+    delete[] cutoff;
+
+    // Spline: h = 2.8 * 0.1, Newtonian beyond h, the smeared
+    // mass of the spline kernel within h
+    float const h( 0.28f );
+    for( float const distance : {1.0f, 0.5f * h, 0.75f * h} )
+    {
+        Vector3F pair[2] = {
+            Vector3F{0.0f, 0.0f, 0.0f}, Vector3F{distance, 0.0f, 0.0f}
+        };
+        float pairMass[2] = { 1.0f, 1.0f };
+        Vector3F* spline = createAccelerations<
+            Acc,
+            alpaka::stream::StreamCpuSync,
+            Vector3F,
+            kernels::BasicAccelerationKernel<kernels::forceLaws::Spline>
+        >(
+                pair,
+                pairMass,
+                2,
+                0.01f);
+
+        float const u( distance / h );
+        float const enclosed( ( u >= 1.0f ) ? 1.0f :
+            ( u < 0.5f ) ?
+            u * u * u * ( 32.0f / 3.0f - 38.4f * u * u + 32.0f * u * u * u ) :
+            64.0f / 3.0f * u * u * u - 48.0f * u * u * u * u +
+                38.4f * u * u * u * u * u -
+                32.0f / 3.0f * u * u * u * u * u * u - 1.0f / 15.0f );
+        BOOST_CHECK_CLOSE( spline[0][0],
+                enclosed / ( distance * distance ), 1e-3 );
+        BOOST_CHECK_CLOSE( spline[1][0], -spline[0][0], 1e-4 );
+        delete[] spline;
+    }
+}
+
+// The optimised solvers with TForceLaw against the AccelerationKernel
+template<
+    typename TForceLaw>
+auto
+checkForceLaw()
+-> void
+{
+    namespace kernels = nbody::simulation::kernels;
+    namespace solvers = nbody::simulation::solvers;
+    using Vector3F = Vector<3,float>;
+    using Acc = alpaka::acc::AccCpuSerial<
+        alpaka::dim::DimInt<1u>,
+        std::size_t >;
+    std::size_t const numBodies = 37;
+    Vector3F bodiesPosition[numBodies];
+    float bodiesMass[numBodies];
+    for( std::size_t i(0); i < numBodies; i++ )
+    {
+        bodiesPosition[i] = Vector3F{
+            static_cast<float>( (i * 7) % 11 ),
+            static_cast<float>( (i * 5) % 13 ) - 6.0f,
+            static_cast<float>( (i * 3) % 5 )};
+        bodiesMass[i] = 1.0f + static_cast<float>( i % 3 );
+    }
+
+    Vector3F* reference = createAccelerations<
+        Acc,
+        alpaka::stream::StreamCpuSync,
+        Vector3F,
+        kernels::BasicAccelerationKernel<TForceLaw>
+    >(
+            bodiesPosition,
+            bodiesMass,
+            numBodies,
+            0.01f);
+    Vector3F* solved[] = {
+        solveAccelerations<Acc, solvers::Tiled<8, 4, TForceLaw> >(
+            bodiesPosition, bodiesMass, numBodies, 0.01f, 6 ),
+        solveAccelerations<Acc, solvers::Simd<8, TForceLaw> >(
+            bodiesPosition, bodiesMass, numBodies, 0.01f, 2 ),
+        solveAccelerations<Acc, solvers::BasicSymmetric<TForceLaw> >(
+            bodiesPosition, bodiesMass, numBodies, 0.01f ),
+        solveAccelerations<Acc, solvers::BasicSourcesSinks<TForceLaw> >(
+            bodiesPosition, bodiesMass, numBodies, 0.01f ),
+        solveAccelerations<Acc, solvers::Mixed<
+            float,
+            kernels::accumulate::Wide<double>,
+            TForceLaw> >(
+            bodiesPosition, bodiesMass, numBodies, 0.01f, 3 )
+    };
+
+    for( Vector3F* accelerations : solved )
+    {
+        for( std::size_t i(0); i < numBodies; i++ )
+        {
+            for( std::size_t d(0); d < 3; d++ )
+            {
+                BOOST_CHECK_SMALL(
+                        accelerations[i][d] - reference[i][d], 1e-4f );
+            }
+        }
+        delete[] accelerations;
+    }
+    delete[] reference;
+}
+
+BOOST_AUTO_TEST_CASE( forceLawsSolvers3D )
+{
+    namespace forceLaws = nbody::simulation::kernels::forceLaws;
+    checkForceLaw<forceLaws::Newton>();
+    checkForceLaw<forceLaws::Coulomb>();
+    checkForceLaw<forceLaws::Spline>();
+    // the bodies are on integer points, so no pair sits on
+    // the radius, where rounding decides if it interacts
+    checkForceLaw<
+        forceLaws::Cutoff<
+            forceLaws::Plummer,
+            std::ratio<11,2> > >();
+}
@@ -0,0 +1,378 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE BarnesHutTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // std::sqrt
+#include <cstdint> // std::uint64_t
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <algorithm> // std::stable_sort
+#include <alpaka/alpaka.hpp>
+#include <simulation/solvers/barnesHut.hpp> // BarnesHut
+#include <simulation/algorithms/radixSort.hpp> // RadixSort
+#include <simulation/kernels/hilbertKeyKernel.hpp> // HilbertKeyKernel
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using namespace nbody::simulation;
+
+using Size = std::size_t;
+using Stream = alpaka::stream::StreamCpuSync;
+using AccForce = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<2u>,Size>;
+using AccBodies = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<1u>,Size>;
+
+// Random bodies in a unit cube with a dense clump
+template<
+    std::size_t NDim>
+auto
+createBodies(
+    std::size_t numBodies,
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses)
+-> void
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+
+    positions.resize( numBodies );
+    masses.resize( numBodies );
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        float const scale( ( i % 4 == 0 ) ? 0.05f : 1.0f );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            positions[ i ][ d ] = scale * distribution( generator );
+        masses[ i ] = 0.5f + distribution( generator );
+    }
+}
+
+// Direct summation on the host in double precision
+template<
+    std::size_t NDim>
+auto
+directAccelerations(
+    std::vector<types::Vector<NDim,float>> const & positions,
+    std::vector<float> const & masses,
+    float smoothnessFactor)
+-> std::vector<types::Vector<NDim,double>>
+{
+    std::vector<types::Vector<NDim,double>> accelerations(
+            positions.size(), types::Vector<NDim,double>( 0.0 ) );
+    for( std::size_t i( 0 ); i < positions.size(); i++ )
+    {
+        for( std::size_t j( 0 ); j < positions.size(); j++ )
+        {
+            if( i == j )
+                continue;
+            types::Vector<NDim,double> relative;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                relative[ d ] = double( positions[ j ][ d ] ) - positions[ i ][ d ];
+            double const dist( relative.absSq() + smoothnessFactor );
+            accelerations[ i ] += ( masses[ j ] / ( dist * std::sqrt( dist ) ) ) *
+                relative;
+        }
+    }
+    return accelerations;
+}
+
+// Runs the solver and copies the accelerations to the host
+template<
+    typename TSolver,
+    std::size_t NDim>
+auto
+treeAccelerations(
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses,
+    float smoothnessFactor,
+    float theta,
+    Size leafSize)
+-> std::vector<types::Vector<NDim,float>>
+{
+    using Vector = types::Vector<NDim,float>;
+    Size const numBodies( positions.size() );
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<AccBodies> devAcc(
+            alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extentBodies( numBodies );
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufPosition( positions.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, float,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufMass( masses.data(), devHost, extentBodies );
+
+    auto accBufPosition(
+            alpaka::mem::buf::alloc<Vector, Size>( devAcc, extentBodies ) );
+    auto accBufMass(
+            alpaka::mem::buf::alloc<float, Size>( devAcc, extentBodies ) );
+
+    alpaka::mem::view::copy( stream, accBufPosition, hostBufPosition, extentBodies );
+    alpaka::mem::view::copy( stream, accBufMass, hostBufMass, extentBodies );
+
+    typename TSolver::template Solver<
+        AccForce,
+        AccBodies,
+        NDim,
+        float,
+        Size> solver( devAcc, numBodies );
+    solver.theta = theta;
+    solver.leafSize = leafSize;
+
+    solver(
+        stream,
+        alpaka::mem::view::getPtrNative( accBufPosition ),
+        alpaka::mem::view::getPtrNative( accBufMass ),
+        numBodies,
+        smoothnessFactor,
+        2 );
+
+    std::cout << "levels: " << solver.getNumLevels() << std::endl;
+
+    std::vector<Vector> accelerations( numBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufAccelerations( accelerations.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        alpaka::dev::Dev<AccBodies>, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    accBufAccelerations( solver.getAccelerations(), devAcc, extentBodies );
+
+    alpaka::mem::view::copy(
+            stream, hostBufAccelerations, accBufAccelerations, extentBodies );
+    alpaka::wait::wait( stream );
+
+    return accelerations;
+}
+
+// Root mean square of the relative errors
+template<
+    std::size_t NDim>
+auto
+relativeError(
+    std::vector<types::Vector<NDim,float>> const & accelerations,
+    std::vector<types::Vector<NDim,double>> const & reference)
+-> double
+{
+    double sum( 0.0 );
+    for( std::size_t i( 0 ); i < reference.size(); i++ )
+    {
+        types::Vector<NDim,double> difference;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            difference[ d ] = accelerations[ i ][ d ] - reference[ i ][ d ];
+        sum += difference.absSq() / reference[ i ].absSq();
+    }
+    return std::sqrt( sum / reference.size() );
+}
+
+BOOST_AUTO_TEST_CASE( radixSort )
+{
+    using Key = std::uint64_t;
+    Size const numElements( 1000 );
+
+    std::mt19937_64 generator( 7 );
+    std::vector<Key> keys( numElements );
+    std::vector<Size> values( numElements );
+    for( Size i( 0 ); i < numElements; i++ )
+    {
+        // few different keys to check the stability
+        keys[ i ] = generator() % 97 + ( Key(1) << 40 ) * ( i % 3 );
+        values[ i ] = i;
+    }
+
+    std::vector<Size> expected( values );
+    std::stable_sort( expected.begin(), expected.end(),
+            [&keys]( Size a, Size b ) { return keys[ a ] < keys[ b ]; } );
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<AccBodies> devAcc(
+            alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extent( numElements );
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Key,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufKeys( keys.data(), devHost, extent );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Size,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufValues( values.data(), devHost, extent );
+
+    auto accBufKeys( alpaka::mem::buf::alloc<Key, Size>( devAcc, extent ) );
+    auto accBufValues( alpaka::mem::buf::alloc<Size, Size>( devAcc, extent ) );
+
+    alpaka::mem::view::copy( stream, accBufKeys, hostBufKeys, extent );
+    alpaka::mem::view::copy( stream, accBufValues, hostBufValues, extent );
+
+    algorithms::RadixSort<AccBodies, Key, Size, Size> sort( devAcc, numElements );
+    sort(
+        stream,
+        alpaka::mem::view::getPtrNative( accBufKeys ),
+        alpaka::mem::view::getPtrNative( accBufValues ),
+        numElements,
+        48 );
+
+    alpaka::mem::view::copy( stream, hostBufValues, accBufValues, extent );
+    alpaka::wait::wait( stream );
+
+    for( Size i( 0 ); i < numElements; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( values[ i ], expected[ i ] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( hilbertKeys )
+{
+    using Key = kernels::morton::Key;
+    using Vector = types::Vector<3,float>;
+    Size const side( 4 );
+    Size const numElements( side * side * side );
+
+    // a lattice which is aligned with the cells of the second level
+    std::vector<Vector> positions( numElements );
+    for( Size i( 0 ); i < numElements; i++ )
+    {
+        positions[ i ][ 0 ] = static_cast<float>( i % side );
+        positions[ i ][ 1 ] = static_cast<float>( i / side % side );
+        positions[ i ][ 2 ] = static_cast<float>( i / side / side );
+    }
+    Vector box[2] = { Vector( 0.0f ), Vector( 4.0f ) };
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<AccBodies> devAcc(
+            alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extent( numElements );
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extentBox( 2 );
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufPositions( positions.data(), devHost, extent );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufBox( box, devHost, extentBox );
+    std::vector<Key> keys( numElements );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Key,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufKeys( keys.data(), devHost, extent );
+
+    auto accBufPositions( alpaka::mem::buf::alloc<Vector, Size>( devAcc, extent ) );
+    auto accBufBox( alpaka::mem::buf::alloc<Vector, Size>( devAcc, extentBox ) );
+    auto accBufKeys( alpaka::mem::buf::alloc<Key, Size>( devAcc, extent ) );
+    auto accBufIndices( alpaka::mem::buf::alloc<Size, Size>( devAcc, extent ) );
+
+    alpaka::mem::view::copy( stream, accBufPositions, hostBufPositions, extent );
+    alpaka::mem::view::copy( stream, accBufBox, hostBufBox, extentBox );
+
+    Vector const * const accBox( alpaka::mem::view::getPtrNative( accBufBox ) );
+    kernels::HilbertKeyKernel hilbertKeyKernel;
+    auto const hilbertKeyExec(
+            alpaka::exec::create<AccBodies>(
+                alpaka::workdiv::getValidWorkDiv< AccBodies >(
+                    devAcc,
+                    extent,
+                    alpaka::Vec<alpaka::dim::DimInt<1u>,Size>::ones(),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::
+                    Unrestricted ),
+                hilbertKeyKernel,
+                static_cast<Vector const *>(
+                    alpaka::mem::view::getPtrNative( accBufPositions ) ),
+                accBox,
+                accBox + 1,
+                numElements,
+                alpaka::mem::view::getPtrNative( accBufKeys ),
+                alpaka::mem::view::getPtrNative( accBufIndices )
+            )
+    );
+    alpaka::stream::enqueue( stream, hilbertKeyExec );
+
+    alpaka::mem::view::copy( stream, hostBufKeys, accBufKeys, extent );
+    alpaka::wait::wait( stream );
+
+    std::vector<Size> sorted( numElements );
+    for( Size i( 0 ); i < numElements; i++ )
+        sorted[ i ] = i;
+    std::stable_sort( sorted.begin(), sorted.end(),
+            [&keys]( Size a, Size b ) { return keys[ a ] < keys[ b ]; } );
+
+    // the curve never jumps: consecutive keys are neighbouring cells
+    for( Size i( 1 ); i < numElements; i++ )
+    {
+        BOOST_REQUIRE( keys[ sorted[ i - 1 ] ] < keys[ sorted[ i ] ] );
+        float distance( 0.0f );
+        for( std::size_t d( 0 ); d < 3; d++ )
+            distance += std::abs(
+                    positions[ sorted[ i ] ][ d ] -
+                    positions[ sorted[ i - 1 ] ][ d ] );
+        BOOST_REQUIRE_EQUAL( distance, 1.0f );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( barnesHutExact3D )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 500, positions, masses );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    // theta = 0 never accepts a node, only the leaves are summed up
+    auto const accelerations( treeAccelerations< solvers::BarnesHut<> >(
+                positions, masses, smoothnessFactor, 0.0f, 4 ) );
+
+    double const error( relativeError( accelerations, reference ) );
+    std::cout << "theta 0: " << error << std::endl;
+    BOOST_REQUIRE_SMALL( error, 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE( barnesHutQuadrupole3D )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 2000, positions, masses );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const monopole( treeAccelerations< solvers::BarnesHut<false> >(
+                positions, masses, smoothnessFactor, 0.7f, 8 ) );
+    auto const quadrupole( treeAccelerations< solvers::BarnesHut<true> >(
+                positions, masses, smoothnessFactor, 0.7f, 8 ) );
+
+    double const errorMonopole( relativeError( monopole, reference ) );
+    double const errorQuadrupole( relativeError( quadrupole, reference ) );
+    std::cout << "monopole: " << errorMonopole
+        << " quadrupole: " << errorQuadrupole << std::endl;
+
+    BOOST_REQUIRE_SMALL( errorMonopole, 1e-1 );
+    BOOST_REQUIRE_LT( errorQuadrupole, errorMonopole );
+}
+
+BOOST_AUTO_TEST_CASE( barnesHut2D )
+{
+    std::vector<types::Vector<2,float>> positions;
+    std::vector<float> masses;
+    createBodies<2>( 1000, positions, masses );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const accelerations( treeAccelerations< solvers::BarnesHut<true> >(
+                positions, masses, smoothnessFactor, 0.5f, 1 ) );
+
+    double const error( relativeError( accelerations, reference ) );
+    std::cout << "2D: " << error << std::endl;
+    BOOST_REQUIRE_SMALL( error, 1e-2 );
+}
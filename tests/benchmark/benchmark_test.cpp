@@ -7,20 +7,25 @@
 #include <boost/type_index.hpp>
 #include <boost/timer.hpp>
 #include <chrono>
+#include <random>
 
 using namespace nbody::simulation;
 
 //BOOST_AUTO_TEST_CASE_TEMPLATE( simulationBenchmark, T, test_cases )
 template<
     std::size_t NDim,
-    typename TElem>
+    typename TElem,
+    typename TSolver,
+    typename TLayout = types::layouts::AoS>
 void runTest(std::size_t const NSize, std::size_t const NSteps,
         std::size_t elements)
 {
     std::cout << NSize << " bodies with "<< NDim << "-dimensional " <<  
         boost::typeindex::type_id<TElem>().pretty_name() << 
-        " vectors for " << NSteps << " steps. Elements per Thread: "
-        << elements << std::endl;
+        " vectors for " << NSteps << " steps with " <<
+        boost::typeindex::type_id<TSolver>().pretty_name() <<
+        " in " << boost::typeindex::type_id<TLayout>().pretty_name() <<
+        ". Elements per Thread: " << elements << std::endl;
 
     types::Vector<NDim, TElem> * bodiesPosition =
         new types::Vector<NDim, TElem>[NSize];
@@ -28,10 +33,15 @@ void runTest(std::size_t const NSize, std::size_t const NSteps,
         new types::Vector<NDim, TElem>[NSize];
     TElem * bodiesMass = new TElem[NSize];
 
+    // The tree code depends on the distribution of the bodies
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<TElem> distribution(0,1);
     for(std::size_t i = 0; i < NSize; i++) {
-        bodiesPosition[i] = types::Vector<NDim,TElem>( static_cast<TElem>(0) );
+        for(std::size_t d = 0; d < NDim; d++) {
+            bodiesPosition[i][d] = distribution(generator);
+        }
         bodiesVelocity[i] = types::Vector<NDim,TElem>( static_cast<TElem>(0) );
-        bodiesMass[i] = static_cast<TElem>(0);
+        bodiesMass[i] = static_cast<TElem>(1);
     }
 
     float const smoothnessFactor = 1e-8;
@@ -41,7 +51,9 @@ void runTest(std::size_t const NSize, std::size_t const NSteps,
         NDim,
         TElem,
         float,
-        std::size_t> sim(
+        std::size_t,
+        TSolver,
+        TLayout> sim(
                 bodiesPosition,
                 bodiesVelocity,
                 bodiesMass,
@@ -53,14 +65,17 @@ void runTest(std::size_t const NSize, std::size_t const NSteps,
 
     std::chrono::high_resolution_clock::time_point start =
         std::chrono::high_resolution_clock::now();
-    for(std::size_t i = 0; i < NSteps; i++) {
-        sim.step(0.1f);
-    }
+    sim.steps(0.1f, NSteps);
     std::chrono::high_resolution_clock::time_point end =
         std::chrono::high_resolution_clock::now();
     std::cout << "Time: " << 
         std::chrono::duration_cast<std::chrono::milliseconds>
             (end - start).count() / 1000.0f << " secs" << std::endl;
+    // pairs of the direct summation, the approximating
+    // solvers need less
+    std::cout << "Interactions/s: " <<
+        static_cast<double>(NSize) * NSize * NSteps /
+        std::chrono::duration<double>(end - start).count() << std::endl;
 
     delete[] bodiesPosition;
     delete[] bodiesVelocity;
@@ -69,6 +84,41 @@ void runTest(std::size_t const NSize, std::size_t const NSteps,
 
 int main(void) {
     for(std::size_t i = 1; i <=32; i*=2) {
-        runTest<2,float>(1<<15,1,i);
+        runTest<2,float,solvers::ForceMatrix>(1<<15,1,i);
+    }
+    for(std::size_t i = 1; i <=32; i*=2) {
+        runTest<2,float,solvers::Fused>(1<<15,1,i);
+    }
+    for(std::size_t i = 1; i <=32; i*=2) {
+        runTest<2,float,solvers::Tiled<256> >(1<<15,1,i);
+    }
+    for(std::size_t i = 1; i <=32; i*=2) {
+        runTest<2,float,solvers::BarnesHut<> >(1<<15,1,i);
+    }
+    for(std::size_t i = 1; i <=32; i*=2) {
+        runTest<2,float,solvers::BarnesHut<true> >(1<<15,1,i);
+    }
+    // crossover of the direct summation and the fast multipole method
+    for(std::size_t n = 1<<10; n <= 1<<17; n*=2) {
+        runTest<3,float,solvers::Fused>(n,1,8);
+        runTest<3,float,solvers::Fmm<4> >(n,1,8);
+        runTest<3,float,solvers::ParticleMesh<> >(n,1,8);
+        runTest<3,float,solvers::P3m<> >(n,1,8);
     }
+    // vectorised direct summation on the CPU
+    runTest<3,float,solvers::Fused>(1<<15,1,8);
+    runTest<3,float,solvers::Simd<8> >(1<<15,1,8);
+    runTest<3,float,solvers::Simd<16> >(1<<15,1,8);
+    runTest<3,float,solvers::Simd<16>,types::layouts::SoA>(1<<15,1,8);
+    // every pair once
+    runTest<3,float,solvers::Symmetric>(1<<15,1,8);
+    // storage layouts of the direct summation
+    runTest<3,float,solvers::Fused,types::layouts::AoS>(1<<15,1,8);
+    runTest<3,float,solvers::Fused,types::layouts::AoS4>(1<<15,1,8);
+    runTest<3,float,solvers::Fused,types::layouts::SoA>(1<<15,1,8);
+    runTest<3,float,solvers::Fused,types::layouts::AoSoA<8> >(1<<15,1,8);
+    runTest<3,float,solvers::Tiled<256>,types::layouts::AoS>(1<<15,1,8);
+    runTest<3,float,solvers::Tiled<256>,types::layouts::AoS4>(1<<15,1,8);
+    runTest<3,float,solvers::Tiled<256>,types::layouts::SoA>(1<<15,1,8);
+    runTest<3,float,solvers::Tiled<256>,types::layouts::AoSoA<8> >(1<<15,1,8);
 }
@@ -0,0 +1,295 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE FmmTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // std::sqrt
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <alpaka/alpaka.hpp>
+#include <simulation/solvers/fmm.hpp> // Fmm
+#include <simulation/kernels/fmmKernels.hpp> // fmm::Expansion
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using namespace nbody::simulation;
+
+using Size = std::size_t;
+using Stream = alpaka::stream::StreamCpuSync;
+using AccForce = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<2u>,Size>;
+using AccBodies = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<1u>,Size>;
+
+// Random bodies in a unit cube with a dense clump
+template<
+    std::size_t NDim>
+auto
+createBodies(
+    std::size_t numBodies,
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses)
+-> void
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+
+    positions.resize( numBodies );
+    masses.resize( numBodies );
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        float const scale( ( i % 4 == 0 ) ? 0.05f : 1.0f );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            positions[ i ][ d ] = scale * distribution( generator );
+        masses[ i ] = 0.5f + distribution( generator );
+    }
+}
+
+// Direct summation on the host in double precision
+template<
+    std::size_t NDim>
+auto
+directAccelerations(
+    std::vector<types::Vector<NDim,float>> const & positions,
+    std::vector<float> const & masses,
+    float smoothnessFactor)
+-> std::vector<types::Vector<NDim,double>>
+{
+    std::vector<types::Vector<NDim,double>> accelerations(
+            positions.size(), types::Vector<NDim,double>( 0.0 ) );
+    for( std::size_t i( 0 ); i < positions.size(); i++ )
+    {
+        for( std::size_t j( 0 ); j < positions.size(); j++ )
+        {
+            if( i == j )
+                continue;
+            types::Vector<NDim,double> relative;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                relative[ d ] = double( positions[ j ][ d ] ) - positions[ i ][ d ];
+            double const dist( relative.absSq() + smoothnessFactor );
+            accelerations[ i ] += ( masses[ j ] / ( dist * std::sqrt( dist ) ) ) *
+                relative;
+        }
+    }
+    return accelerations;
+}
+
+// Runs the solver and copies the accelerations to the host
+template<
+    typename TSolver,
+    std::size_t NDim>
+auto
+fmmAccelerations(
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses,
+    float smoothnessFactor,
+    float theta,
+    Size leafSize)
+-> std::vector<types::Vector<NDim,float>>
+{
+    using Vector = types::Vector<NDim,float>;
+    Size const numBodies( positions.size() );
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<AccBodies> devAcc(
+            alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extentBodies( numBodies );
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufPosition( positions.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, float,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufMass( masses.data(), devHost, extentBodies );
+
+    auto accBufPosition(
+            alpaka::mem::buf::alloc<Vector, Size>( devAcc, extentBodies ) );
+    auto accBufMass(
+            alpaka::mem::buf::alloc<float, Size>( devAcc, extentBodies ) );
+
+    alpaka::mem::view::copy( stream, accBufPosition, hostBufPosition, extentBodies );
+    alpaka::mem::view::copy( stream, accBufMass, hostBufMass, extentBodies );
+
+    typename TSolver::template Solver<
+        AccForce,
+        AccBodies,
+        NDim,
+        float,
+        Size> solver( devAcc, numBodies );
+    solver.theta = theta;
+    solver.leafSize = leafSize;
+
+    solver(
+        stream,
+        alpaka::mem::view::getPtrNative( accBufPosition ),
+        alpaka::mem::view::getPtrNative( accBufMass ),
+        numBodies,
+        smoothnessFactor,
+        2 );
+
+    std::cout << "levels: " << solver.getNumLevels() << std::endl;
+
+    std::vector<Vector> accelerations( numBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufAccelerations( accelerations.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        alpaka::dev::Dev<AccBodies>, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    accBufAccelerations( solver.getAccelerations(), devAcc, extentBodies );
+
+    alpaka::mem::view::copy(
+            stream, hostBufAccelerations, accBufAccelerations, extentBodies );
+    alpaka::wait::wait( stream );
+
+    return accelerations;
+}
+
+// Root mean square of the relative errors
+template<
+    std::size_t NDim>
+auto
+relativeError(
+    std::vector<types::Vector<NDim,float>> const & accelerations,
+    std::vector<types::Vector<NDim,double>> const & reference)
+-> double
+{
+    double sum( 0.0 );
+    for( std::size_t i( 0 ); i < reference.size(); i++ )
+    {
+        types::Vector<NDim,double> difference;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            difference[ d ] = accelerations[ i ][ d ] - reference[ i ][ d ];
+        sum += difference.absSq() / reference[ i ].absSq();
+    }
+    return std::sqrt( sum / reference.size() );
+}
+
+// Compares the Taylor coefficients against central differences
+// d/dr_d a_k = ( k_d + 1 ) a_(k+e_d) and stores the largest
+// relative deviation
+struct DerivativesTestKernel
+{
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        double * const maxError) const
+    -> void
+    {
+        using Expansion = kernels::fmm::Expansion<3,3,double>;
+        using Coefficients = Expansion::Coefficients;
+        Expansion const expansion( Expansion::create() );
+
+        types::Vector<3,double> const r( { 0.7, -0.4, 1.1 } );
+        double const eps( 0.01 );
+        double const h( 1e-4 );
+
+        Coefficients a;
+        expansion.derivatives( acc, r, eps, a );
+
+        *maxError = 0.0;
+        for( std::size_t k( 0 ); k < Expansion::numTerms; k++ )
+        {
+            if( expansion.degree[ k ] >= 3 )
+                continue;
+            for( std::size_t d( 0 ); d < 3; d++ )
+            {
+                // index of k + e_d
+                std::size_t upper( 0 );
+                while( expansion.lower[ upper ][ d ] != k )
+                    upper++;
+
+                types::Vector<3,double> rPlus( r );
+                types::Vector<3,double> rMinus( r );
+                rPlus[ d ] += h;
+                rMinus[ d ] -= h;
+                Coefficients aPlus;
+                Coefficients aMinus;
+                expansion.derivatives( acc, rPlus, eps, aPlus );
+                expansion.derivatives( acc, rMinus, eps, aMinus );
+
+                double const numeric(
+                        ( aPlus[ k ] - aMinus[ k ] ) / ( 2 * h ) );
+                double const analytic(
+                        ( expansion.component[ k ][ d ] + 1 ) *
+                        a[ upper ] );
+                double const error( std::abs( numeric - analytic ) /
+                        ( std::abs( analytic ) + 1e-12 ) );
+                if( *maxError < error )
+                    *maxError = error;
+            }
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE( fmmDerivatives )
+{
+    using Acc = alpaka::acc::AccCpuSerial<alpaka::dim::DimInt<1u>,Size>;
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<Acc> devAcc( alpaka::dev::DevMan<Acc>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extent( 1 );
+    auto accBufError( alpaka::mem::buf::alloc<double, Size>( devAcc, extent ) );
+    double maxError( 1.0 );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, double,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufError( &maxError, devHost, extent );
+
+    auto const exec(
+            alpaka::exec::create<Acc>(
+                alpaka::workdiv::WorkDivMembers<
+                    alpaka::dim::DimInt<1u>, Size>( extent, extent, extent ),
+                DerivativesTestKernel(),
+                alpaka::mem::view::getPtrNative( accBufError ) ) );
+    alpaka::stream::enqueue( stream, exec );
+    alpaka::mem::view::copy( stream, hostBufError, accBufError, extent );
+    alpaka::wait::wait( stream );
+
+    std::cout << "derivatives: " << maxError << std::endl;
+    BOOST_REQUIRE_SMALL( maxError, 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE( fmmOrder3D )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 2000, positions, masses );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const order2( fmmAccelerations< solvers::Fmm<2> >(
+                positions, masses, smoothnessFactor, 0.5f, 8 ) );
+    auto const order4( fmmAccelerations< solvers::Fmm<4> >(
+                positions, masses, smoothnessFactor, 0.5f, 8 ) );
+
+    double const error2( relativeError( order2, reference ) );
+    double const error4( relativeError( order4, reference ) );
+    std::cout << "order 2: " << error2
+        << " order 4: " << error4 << std::endl;
+
+    BOOST_REQUIRE_SMALL( error4, 5e-3 );
+    BOOST_REQUIRE_LT( error4, error2 );
+}
+
+BOOST_AUTO_TEST_CASE( fmm2D )
+{
+    std::vector<types::Vector<2,float>> positions;
+    std::vector<float> masses;
+    createBodies<2>( 1000, positions, masses );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const accelerations( fmmAccelerations< solvers::Fmm<4> >(
+                positions, masses, smoothnessFactor, 0.3f, 4 ) );
+
+    double const error( relativeError( accelerations, reference ) );
+    std::cout << "2D: " << error << std::endl;
+    BOOST_REQUIRE_SMALL( error, 2e-3 );
+}
@@ -0,0 +1,346 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE IntegratorsTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // std::sqrt, std::cos, std::sin
+#include <simulation/simulation.hpp> // Simulation
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using namespace nbody::simulation;
+
+/** Distance to the exact circular orbit after one period
+ *
+ * Two bodies of mass 1 at distance 1 circle around their
+ * center of mass with G = 1 and the period 2 pi / sqrt(2).
+ */
+template<
+    typename TIntegrator>
+auto
+circularOrbitError(
+    std::size_t numSteps)
+-> float
+{
+    float const pi( 3.14159265358979f );
+    float const period( 2.0f * pi / std::sqrt( 2.0f ) );
+    float const speed( std::sqrt( 0.5f ) );
+
+    types::Vector<3,float> bodiesPosition[2] = {
+        {0.5f,0.0f,0.0f}, {-0.5f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[2] = {
+        {0.0f,speed,0.0f}, {0.0f,-speed,0.0f}
+    };
+    float bodiesMass[2] = {
+        1.0f, 1.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        TIntegrator> sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    sim.steps( period / static_cast<float>( numSteps ), numSteps );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> const error( result[0] -
+        types::Vector<3,float>( {0.5f,0.0f,0.0f} ) );
+    return std::sqrt( error.absSq() );
+}
+
+BOOST_AUTO_TEST_CASE( leapfrogOrder )
+{
+    float const errorCoarse(
+        circularOrbitError<integrators::Leapfrog>( 50 ) );
+    float const errorFine(
+        circularOrbitError<integrators::Leapfrog>( 100 ) );
+    std::cout << "Leapfrog: " << errorCoarse << " " << errorFine << std::endl;
+
+    // second order: half the step, a quarter of the error
+    BOOST_CHECK_CLOSE( errorCoarse / errorFine, 4.0f, 10.0f );
+}
+
+BOOST_AUTO_TEST_CASE( forestRuthOrder )
+{
+    float const errorCoarse(
+        circularOrbitError<integrators::ForestRuth>( 20 ) );
+    float const errorFine(
+        circularOrbitError<integrators::ForestRuth>( 40 ) );
+    std::cout << "ForestRuth: " << errorCoarse << " " << errorFine << std::endl;
+
+    // fourth order: half the step, a sixteenth of the error
+    BOOST_CHECK_CLOSE( errorCoarse / errorFine, 16.0f, 15.0f );
+}
+
+BOOST_AUTO_TEST_CASE( symplecticAgainstEuler )
+{
+    // the same number of force evaluations
+    float const errorEuler(
+        circularOrbitError<integrators::Euler>( 300 ) );
+    float const errorLeapfrog(
+        circularOrbitError<integrators::Leapfrog>( 300 ) );
+    float const errorForestRuth(
+        circularOrbitError<integrators::ForestRuth>( 100 ) );
+    std::cout << "Euler: " << errorEuler
+        << " Leapfrog: " << errorLeapfrog
+        << " ForestRuth: " << errorForestRuth << std::endl;
+
+    BOOST_CHECK_LT( errorLeapfrog * 10.0f, errorEuler );
+    BOOST_CHECK_LT( errorForestRuth * 10.0f, errorLeapfrog );
+}
+
+BOOST_AUTO_TEST_CASE( hermiteOrder )
+{
+    float const errorCoarse(
+        circularOrbitError<integrators::Hermite>( 40 ) );
+    float const errorFine(
+        circularOrbitError<integrators::Hermite>( 80 ) );
+    std::cout << "Hermite: " << errorCoarse << " " << errorFine << std::endl;
+
+    // fourth order: half the step, a sixteenth of the error
+    BOOST_CHECK_CLOSE( errorCoarse / errorFine, 16.0f, 15.0f );
+
+    // one force evaluation per step, like Euler
+    BOOST_CHECK_LT( errorFine * 100.0f,
+        circularOrbitError<integrators::Euler>( 80 ) );
+}
+
+// only the block steps have levels
+template<
+    typename TIntegrator>
+auto
+setMaxLevel(
+    TIntegrator &,
+    std::size_t)
+-> void
+{}
+
+template<
+    typename TAcc,
+    std::size_t NDim,
+    typename TElem,
+    typename TSize>
+auto
+setMaxLevel(
+    typename integrators::BlockSteps::template Integrator<
+        TAcc,NDim,TElem,TSize> & integrator,
+    std::size_t maxLevel)
+-> void
+{
+    integrator.maxLevel = maxLevel;
+}
+
+/** Positions of a tight binary and a distant body after time
+ *
+ * The binary needs steps which are much smaller than the
+ * steps of the distant body.
+ */
+template<
+    typename TIntegrator>
+auto
+hierarchicalSystem(
+    float dt,
+    std::size_t numSteps,
+    std::size_t maxLevel,
+    types::Vector<3,float> * positions)
+-> void
+{
+    float const speedBinary( std::sqrt( 5.0f ) );
+    float const speedDistant( std::sqrt( 2.0f / 10.0f ) );
+
+    types::Vector<3,float> bodiesPosition[3] = {
+        {0.05f,0.0f,0.0f}, {-0.05f,0.0f,0.0f}, {10.0f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[3] = {
+        {0.0f,speedBinary,0.0f}, {0.0f,-speedBinary,0.0f},
+        {0.0f,speedDistant,0.0f}
+    };
+    float bodiesMass[3] = {
+        1.0f, 1.0f, 0.001f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        TIntegrator> sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                3,
+                0.0f,
+                1.0f);
+    setMaxLevel( sim.integrator, maxLevel );
+    sim.steps( dt, numSteps );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    for(unsigned int i(0); i < 3; i++)
+        positions[i] = result[i];
+}
+
+BOOST_AUTO_TEST_CASE( blockSteps )
+{
+    // leapfrog with the smallest step for every body
+    types::Vector<3,float> reference[3];
+    hierarchicalSystem<integrators::Leapfrog>(
+        0.5f / 256.0f, 4 * 256, 0, reference );
+
+    types::Vector<3,float> block[3];
+    hierarchicalSystem<integrators::BlockSteps>(
+        0.5f, 4, 8, block );
+
+    // leapfrog with the step the distant body gets
+    types::Vector<3,float> coarse[3];
+    hierarchicalSystem<integrators::Leapfrog>(
+        0.5f / 4.0f, 4 * 4, 0, coarse );
+
+    for(unsigned int i(0); i < 3; i++) {
+        float const errorBlock(
+            std::sqrt( ( block[i] - reference[i] ).absSq() ) );
+        float const errorCoarse(
+            std::sqrt( ( coarse[i] - reference[i] ).absSq() ) );
+        std::cout << "Body " << i << ": block " << errorBlock
+            << " coarse " << errorCoarse << std::endl;
+        BOOST_CHECK_LT( errorBlock, 1e-3f );
+        BOOST_CHECK_LT( errorBlock * 100.0f, errorCoarse );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( blockStepsTicks )
+{
+    // a wide binary, every body stays on level 0
+    types::Vector<3,float> bodiesPosition[2] = {
+        {5.0f,0.0f,0.0f}, {-5.0f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[2] = {
+        {0.0f,0.1f,0.0f}, {0.0f,-0.1f,0.0f}
+    };
+    types::Vector<3,float> bodiesPositionLeapfrog[2] = {
+        bodiesPosition[0], bodiesPosition[1]
+    };
+    types::Vector<3,float> bodiesVelocityLeapfrog[2] = {
+        bodiesVelocity[0], bodiesVelocity[1]
+    };
+    float bodiesMass[2] = {
+        1.0f, 1.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::BlockSteps> sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::Leapfrog> simLeapfrog(
+                bodiesPositionLeapfrog,
+                bodiesVelocityLeapfrog,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    sim.integrator.maxLevel = 6;
+    sim.steps( 0.1f, 10 );
+    simLeapfrog.steps( 0.1f, 10 );
+
+    // only the last of the 64 ticks has active bodies
+    BOOST_CHECK_EQUAL( sim.integrator.getNumTicks(), 1u );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> * resultLeapfrog = simLeapfrog.getPositions();
+    for(unsigned int i(0); i < 2; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 10.0f,
+                    resultLeapfrog[i][d] + 10.0f, 1e-4 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( blockStepsForceLaw )
+{
+    using Coulomb = kernels::forceLaws::Coulomb;
+
+    // a wide pair of like charges, every body stays on level 0
+    types::Vector<3,float> bodiesPosition[2] = {
+        {5.0f,0.0f,0.0f}, {-5.0f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[2] = {
+        {0.0f,0.1f,0.0f}, {0.0f,-0.1f,0.0f}
+    };
+    types::Vector<3,float> bodiesPositionLeapfrog[2] = {
+        bodiesPosition[0], bodiesPosition[1]
+    };
+    types::Vector<3,float> bodiesVelocityLeapfrog[2] = {
+        bodiesVelocity[0], bodiesVelocity[1]
+    };
+    float bodiesMass[2] = {
+        1.0f, 1.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::BasicBlockSteps<Coulomb> > sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::BasicFused<Coulomb>,
+        types::layouts::AoS,
+        integrators::Leapfrog> simLeapfrog(
+                bodiesPositionLeapfrog,
+                bodiesVelocityLeapfrog,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    sim.steps( 0.1f, 10 );
+    simLeapfrog.steps( 0.1f, 10 );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> * resultLeapfrog = simLeapfrog.getPositions();
+    // the charges repel each other
+    BOOST_CHECK_GT( result[0][0], 5.0f );
+    for(unsigned int i(0); i < 2; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 10.0f,
+                    resultLeapfrog[i][d] + 10.0f, 1e-4 );
+        }
+    }
+}
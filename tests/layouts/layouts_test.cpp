@@ -0,0 +1,140 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE LayoutsTest
+#include <iostream> // std::cout, std::endl;
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <simulation/simulation.hpp> // Simulation
+#include <simulation/types/bodies.hpp> // Bodies, layouts
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+using namespace nbody::simulation;
+
+using Layouts = boost::mpl::list<
+    types::layouts::AoS,
+    types::layouts::AoS4,
+    types::layouts::SoA,
+    types::layouts::AoSoA<4> >;
+
+// Random bodies in a unit cube
+template<
+    std::size_t NDim>
+auto
+createBodies(
+    std::size_t numBodies,
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses)
+-> void
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+
+    positions.resize( numBodies );
+    masses.resize( numBodies );
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            positions[ i ][ d ] = distribution( generator );
+        masses[ i ] = 0.5f + distribution( generator );
+    }
+}
+
+// Positions after some steps of a Simulation
+template<
+    typename TSolver,
+    typename TLayout>
+auto
+simulate(
+    std::vector<types::Vector<3,float>> positions,
+    std::vector<float> masses)
+-> std::vector<types::Vector<3,float>>
+{
+    std::vector<types::Vector<3,float>> velocities(
+            positions.size(), types::Vector<3,float>( 0.0f ) );
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        TSolver,
+        TLayout> sim(
+                positions.data(),
+                velocities.data(),
+                masses.data(),
+                positions.size(),
+                1e-4f,
+                1e-3f);
+
+    for( std::size_t i( 0 ); i < 3; i++ )
+        sim.step( 0.1f );
+
+    types::Vector<3,float> const * const result( sim.getPositions() );
+    return std::vector<types::Vector<3,float>>(
+            result, result + positions.size() );
+}
+
+// Every body has its own place in every layout
+BOOST_AUTO_TEST_CASE_TEMPLATE( layoutStorage, TLayout, Layouts )
+{
+    std::size_t const numBodies( 13 );
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies( numBodies, positions, masses );
+
+    using Bodies = types::Bodies<TLayout,3,float,std::size_t>;
+    std::vector<float> storage( Bodies::size( numBodies ), -1.0f );
+    Bodies const bodies( storage.data(), numBodies );
+
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        bodies.setPosition( i, positions[ i ] );
+        bodies.setMass( i, masses[ i ] );
+    }
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        for( std::size_t d( 0 ); d < 3; d++ )
+            BOOST_CHECK_EQUAL( bodies.getPosition( i )[ d ], positions[ i ][ d ] );
+        BOOST_CHECK_EQUAL( bodies.getMass( i ), masses[ i ] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( layoutPadding )
+{
+    BOOST_CHECK_EQUAL(
+        ( types::Bodies<types::layouts::AoS4,3,float,std::size_t>::size( 5 ) ), 20u );
+    BOOST_CHECK_EQUAL(
+        ( types::Bodies<types::layouts::AoS4,2,float,std::size_t>::size( 5 ) ), 20u );
+    BOOST_CHECK_EQUAL(
+        ( types::Bodies<types::layouts::AoSoA<4>,3,float,std::size_t>::size( 5 ) ), 32u );
+}
+
+// The layout must not change the result of the Simulation
+BOOST_AUTO_TEST_CASE_TEMPLATE( simulationLayouts, TLayout, Layouts )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies( 100, positions, masses );
+
+    auto const reference(
+        simulate<solvers::Fused, types::layouts::AoS>( positions, masses ) );
+    auto const fused(
+        simulate<solvers::Fused, TLayout>( positions, masses ) );
+    auto const tiled(
+        simulate<solvers::Tiled<32>, TLayout>( positions, masses ) );
+    auto const barnesHut(
+        simulate<solvers::BarnesHut<>, TLayout>( positions, masses ) );
+    auto const barnesHutReference(
+        simulate<solvers::BarnesHut<>, types::layouts::AoS>( positions, masses ) );
+
+    for( std::size_t i( 0 ); i < positions.size(); i++ )
+    {
+        for( std::size_t d( 0 ); d < 3; d++ )
+        {
+            BOOST_CHECK_EQUAL( fused[ i ][ d ], reference[ i ][ d ] );
+            BOOST_CHECK_CLOSE( tiled[ i ][ d ], reference[ i ][ d ], 1e-3f );
+            BOOST_CHECK_EQUAL( barnesHut[ i ][ d ], barnesHutReference[ i ][ d ] );
+        }
+    }
+}
@@ -0,0 +1,309 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ParticleMeshTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // std::sqrt
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <stdexcept> // std::invalid_argument
+#include <alpaka/alpaka.hpp>
+#include <simulation/solvers/particleMesh.hpp> // ParticleMesh
+#include <simulation/solvers/p3m.hpp> // P3m
+#include <simulation/kernels/pmKernels.hpp> // pm::Ngp, pm::Cic, pm::Tsc
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using namespace nbody::simulation;
+
+using Size = std::size_t;
+using Stream = alpaka::stream::StreamCpuSync;
+using AccForce = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<2u>,Size>;
+using AccBodies = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<1u>,Size>;
+
+// Random bodies in a unit cube, optionally with a dense clump
+template<
+    std::size_t NDim>
+auto
+createBodies(
+    std::size_t numBodies,
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses,
+    bool clump = false)
+-> void
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+
+    positions.resize( numBodies );
+    masses.resize( numBodies );
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        float const scale( ( clump && i % 4 == 0 ) ? 0.05f : 1.0f );
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            positions[ i ][ d ] = scale * distribution( generator );
+        masses[ i ] = 0.5f + distribution( generator );
+    }
+}
+
+// Direct summation on the host in double precision
+template<
+    std::size_t NDim>
+auto
+directAccelerations(
+    std::vector<types::Vector<NDim,float>> const & positions,
+    std::vector<float> const & masses,
+    float smoothnessFactor)
+-> std::vector<types::Vector<NDim,double>>
+{
+    std::vector<types::Vector<NDim,double>> accelerations(
+            positions.size(), types::Vector<NDim,double>( 0.0 ) );
+    for( std::size_t i( 0 ); i < positions.size(); i++ )
+    {
+        for( std::size_t j( 0 ); j < positions.size(); j++ )
+        {
+            if( i == j )
+                continue;
+            types::Vector<NDim,double> relative;
+            for( std::size_t d( 0 ); d < NDim; d++ )
+                relative[ d ] = double( positions[ j ][ d ] ) - positions[ i ][ d ];
+            double const dist( relative.absSq() + smoothnessFactor );
+            accelerations[ i ] += ( masses[ j ] / ( dist * std::sqrt( dist ) ) ) *
+                relative;
+        }
+    }
+    return accelerations;
+}
+
+// Runs the solver and copies the accelerations to the host
+template<
+    typename TSolver,
+    std::size_t NDim>
+auto
+meshAccelerations(
+    std::vector<types::Vector<NDim,float>> & positions,
+    std::vector<float> & masses,
+    float smoothnessFactor,
+    Size gridSize)
+-> std::vector<types::Vector<NDim,float>>
+{
+    using Vector = types::Vector<NDim,float>;
+    Size const numBodies( positions.size() );
+
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) );
+    alpaka::dev::Dev<AccBodies> devAcc(
+            alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) );
+    Stream stream( devAcc );
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extentBodies( numBodies );
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufPosition( positions.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, float,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufMass( masses.data(), devHost, extentBodies );
+
+    auto accBufPosition(
+            alpaka::mem::buf::alloc<Vector, Size>( devAcc, extentBodies ) );
+    auto accBufMass(
+            alpaka::mem::buf::alloc<float, Size>( devAcc, extentBodies ) );
+
+    alpaka::mem::view::copy( stream, accBufPosition, hostBufPosition, extentBodies );
+    alpaka::mem::view::copy( stream, accBufMass, hostBufMass, extentBodies );
+
+    typename TSolver::template Solver<
+        AccForce,
+        AccBodies,
+        NDim,
+        float,
+        Size> solver( devAcc, numBodies );
+    solver.gridSize = gridSize;
+
+    solver(
+        stream,
+        alpaka::mem::view::getPtrNative( accBufPosition ),
+        alpaka::mem::view::getPtrNative( accBufMass ),
+        numBodies,
+        smoothnessFactor,
+        2 );
+
+    std::vector<Vector> accelerations( numBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    hostBufAccelerations( accelerations.data(), devHost, extentBodies );
+    alpaka::mem::view::ViewPlainPtr<
+        alpaka::dev::Dev<AccBodies>, Vector,
+        alpaka::dim::DimInt<1u>, Size>
+    accBufAccelerations( solver.getAccelerations(), devAcc, extentBodies );
+
+    alpaka::mem::view::copy(
+            stream, hostBufAccelerations, accBufAccelerations, extentBodies );
+    alpaka::wait::wait( stream );
+
+    return accelerations;
+}
+
+// Root mean square of the relative errors
+template<
+    std::size_t NDim>
+auto
+relativeError(
+    std::vector<types::Vector<NDim,float>> const & accelerations,
+    std::vector<types::Vector<NDim,double>> const & reference)
+-> double
+{
+    double sum( 0.0 );
+    for( std::size_t i( 0 ); i < reference.size(); i++ )
+    {
+        types::Vector<NDim,double> difference;
+        for( std::size_t d( 0 ); d < NDim; d++ )
+            difference[ d ] = accelerations[ i ][ d ] - reference[ i ][ d ];
+        sum += difference.absSq() / reference[ i ].absSq();
+    }
+    return std::sqrt( sum / reference.size() );
+}
+
+BOOST_AUTO_TEST_CASE( particleMeshIsolated3D )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 2000, positions, masses );
+
+    // the grid smooths the forces over a few cells
+    float const smoothnessFactor( 1e-2f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const ngp( meshAccelerations< solvers::ParticleMesh<kernels::pm::Ngp> >(
+                positions, masses, smoothnessFactor, 32 ) );
+    auto const cic( meshAccelerations< solvers::ParticleMesh<kernels::pm::Cic> >(
+                positions, masses, smoothnessFactor, 32 ) );
+    auto const tsc( meshAccelerations< solvers::ParticleMesh<kernels::pm::Tsc> >(
+                positions, masses, smoothnessFactor, 32 ) );
+
+    double const errorNgp( relativeError( ngp, reference ) );
+    double const errorCic( relativeError( cic, reference ) );
+    double const errorTsc( relativeError( tsc, reference ) );
+    std::cout << "NGP: " << errorNgp << " CIC: " << errorCic
+        << " TSC: " << errorTsc << std::endl;
+
+    BOOST_REQUIRE_SMALL( errorTsc, 5e-2 );
+    BOOST_REQUIRE_LT( errorCic, errorNgp );
+}
+
+BOOST_AUTO_TEST_CASE( particleMesh2D )
+{
+    std::vector<types::Vector<2,float>> positions;
+    std::vector<float> masses;
+    createBodies<2>( 1000, positions, masses );
+
+    float const smoothnessFactor( 1e-2f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const accelerations( meshAccelerations< solvers::ParticleMesh<> >(
+                positions, masses, smoothnessFactor, 64 ) );
+
+    double const error( relativeError( accelerations, reference ) );
+    std::cout << "2D: " << error << std::endl;
+    BOOST_REQUIRE_SMALL( error, 5e-2 );
+}
+
+BOOST_AUTO_TEST_CASE( particleMeshGridSize )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 10, positions, masses );
+
+    // too small for the margins, or no power of two
+    for( Size gridSize : { 0, 4, 5, 12 } )
+        BOOST_CHECK_THROW(
+            ( meshAccelerations< solvers::ParticleMesh<> >(
+                positions, masses, 1e-2f, gridSize ) ),
+            std::invalid_argument );
+    BOOST_CHECK_THROW(
+        ( meshAccelerations< solvers::P3m<> >(
+            positions, masses, 1e-2f, 5 ) ),
+        std::invalid_argument );
+    BOOST_CHECK_NO_THROW(
+        ( meshAccelerations< solvers::ParticleMesh<> >(
+            positions, masses, 1e-2f, 8 ) ) );
+}
+
+BOOST_AUTO_TEST_CASE( particleMeshPeriodic3D )
+{
+    // a close pair in the unit box, the periodic images and
+    // the neutralizing background change the force only slightly
+    std::vector<types::Vector<3,float>> positions( {
+            types::Vector<3,float>( { 0.45f, 0.5f, 0.5f } ),
+            types::Vector<3,float>( { 0.55f, 0.5f, 0.5f } ) } );
+    std::vector<float> masses( { 1.0f, 2.0f } );
+
+    auto const accelerations(
+            meshAccelerations< solvers::ParticleMesh<kernels::pm::Tsc, true> >(
+                positions, masses, 0.0f, 64 ) );
+
+    std::cout << "periodic: " << accelerations[ 0 ][ 0 ] << " "
+        << accelerations[ 1 ][ 0 ] << std::endl;
+
+    // momentum conservation
+    BOOST_REQUIRE_SMALL(
+            masses[ 0 ] * accelerations[ 0 ][ 0 ] +
+            masses[ 1 ] * accelerations[ 1 ][ 0 ], 1e-2f );
+    // G m / r^2 = 200 for the first body
+    BOOST_REQUIRE_CLOSE( accelerations[ 0 ][ 0 ], 200.0f, 5.0f );
+    BOOST_REQUIRE_SMALL( accelerations[ 0 ][ 1 ], 1e-2f );
+
+    // a single body does not accelerate itself
+    std::vector<types::Vector<3,float>> single( {
+            types::Vector<3,float>( { 0.3f, 0.6f, 0.2f } ) } );
+    std::vector<float> singleMass( { 1.0f } );
+    auto const selfAcceleration(
+            meshAccelerations< solvers::ParticleMesh<kernels::pm::Tsc, true> >(
+                single, singleMass, 0.0f, 64 ) );
+    BOOST_REQUIRE_SMALL( static_cast<float>( selfAcceleration[ 0 ].absSq() ), 1e-4f );
+}
+
+BOOST_AUTO_TEST_CASE( p3mIsolated3D )
+{
+    std::vector<types::Vector<3,float>> positions;
+    std::vector<float> masses;
+    createBodies<3>( 2000, positions, masses, true );
+
+    float const smoothnessFactor( 1e-4f );
+    auto const reference( directAccelerations( positions, masses, smoothnessFactor ) );
+
+    auto const mesh( meshAccelerations< solvers::ParticleMesh<> >(
+                positions, masses, smoothnessFactor, 32 ) );
+    auto const p3m( meshAccelerations< solvers::P3m<> >(
+                positions, masses, smoothnessFactor, 32 ) );
+
+    double const errorMesh( relativeError( mesh, reference ) );
+    double const errorP3m( relativeError( p3m, reference ) );
+    std::cout << "PM: " << errorMesh << " P3M: " << errorP3m << std::endl;
+
+    // the clump is far below the resolution of the mesh
+    BOOST_REQUIRE_SMALL( errorP3m, 2e-2 );
+    BOOST_REQUIRE_LT( errorP3m, errorMesh );
+}
+
+BOOST_AUTO_TEST_CASE( p3mPeriodic3D )
+{
+    // a pair closer than a cell is resolved by the short range part
+    std::vector<types::Vector<3,float>> positions( {
+            types::Vector<3,float>( { 0.49f, 0.5f, 0.5f } ),
+            types::Vector<3,float>( { 0.51f, 0.5f, 0.5f } ),
+            types::Vector<3,float>( { 0.2f, 0.9f, 0.1f } ) } );
+    std::vector<float> masses( { 1.0f, 2.0f, 1.0f } );
+
+    auto const accelerations(
+            meshAccelerations< solvers::P3m<kernels::pm::Cic, true> >(
+                positions, masses, 0.0f, 32 ) );
+
+    std::cout << "periodic P3M: " << accelerations[ 0 ][ 0 ] << " "
+        << accelerations[ 1 ][ 0 ] << std::endl;
+
+    // G m / r^2 = 5000 for the first body
+    BOOST_REQUIRE_CLOSE( accelerations[ 0 ][ 0 ], 5000.0f, 1.0f );
+    BOOST_REQUIRE_CLOSE( accelerations[ 1 ][ 0 ], -2500.0f, 1.0f );
+}
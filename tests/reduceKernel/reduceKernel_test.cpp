@@ -0,0 +1,206 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ReduceTest
+#include <iostream> // std::cout, std::endl;
+#include <alpaka/alpaka.hpp>
+#include <simulation/kernels/reduceKernel.hpp> // ReduceKernel
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using Vector = nbody::simulation::types::Vector<2,float>;
+
+std::ostream& operator<<(std::ostream & s, Vector vec) {
+        s << "(" << vec[0] << "," << vec[1] << ")";
+            return s;
+}
+// equal operator for Vectors. Just for testing purposes.
+bool operator==(Vector const a, Vector const b) {
+    for(std::size_t i = 0; i < 2; i++) {
+        if(a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+//Run kernel easily in test
+template<
+    typename TAcc,
+    typename TElem,
+    typename TOp>
+auto
+runReduceKernel(
+    TElem * matrix,
+    std::size_t numRows,
+    std::size_t rowLength,
+    TElem * result,
+    TOp const & op
+    )
+->TElem *
+{
+    using Kernel = nbody::simulation::kernels::ReduceKernel<64>;
+    using Size = std::size_t;
+    using Stream = alpaka::stream::StreamCpuSync;
+
+    /*** Kernel ***/
+    Kernel kernel;
+
+    /*** Devices ***/
+    auto devHost( alpaka::dev::DevManCpu::getDevByIdx(0));
+
+    alpaka::dev::Dev<TAcc> devAcc(
+            alpaka::dev::DevMan<TAcc>::getDevByIdx(0));
+
+    Stream stream(devAcc);
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<2u>,Size
+    > const extentMatrix( numRows, rowLength );
+
+    alpaka::Vec<
+        alpaka::dim::DimInt<1u>,Size
+    > const extentResult( numRows );
+
+    /*** Memory Host **/
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type,
+        TElem,
+        alpaka::dim::DimInt<2u>,
+        Size>
+    hostBufMatrix(
+        matrix,
+        devHost,
+        extentMatrix);
+
+    alpaka::mem::view::ViewPlainPtr<
+        std::decay<decltype(devHost)>::type,
+        TElem,
+        alpaka::dim::DimInt<1u>,
+        Size>
+    hostBufResult(
+        result,
+        devHost,
+        extentResult);
+
+    /*** Memory Acc ***/
+    auto accBufMatrix(
+        alpaka::mem::buf::alloc<TElem,Size>(devAcc, extentMatrix));
+
+    auto accBufResult(
+        alpaka::mem::buf::alloc<TElem,Size>(devAcc, extentResult));
+
+    /*** Memory copy ***/
+    alpaka::mem::view::copy(
+        stream,
+        accBufMatrix,
+        hostBufMatrix,
+        extentMatrix);
+
+    // Wait for data
+    alpaka::wait::wait( stream);
+
+    /*** Execution ***/
+    auto const workDiv(
+        Kernel::template getWorkDiv<TAcc>(
+            devAcc,
+            numRows,
+            rowLength));
+
+    std::cout << workDiv <<std::endl;
+
+    auto const kernelExec(
+        alpaka::exec::create<TAcc>(
+            workDiv,
+            kernel,
+            alpaka::mem::view::getPtrNative(accBufMatrix),
+            static_cast<std::size_t>(
+                alpaka::mem::view::getPitchBytes<1u>(accBufMatrix)
+            ),
+            numRows,
+            rowLength,
+            alpaka::mem::view::getPtrNative(accBufResult),
+            static_cast<std::size_t>( sizeof(TElem) ),
+            op
+        )
+    );
+
+    alpaka::stream::enqueue( stream, kernelExec);
+
+    // Wait for excecution
+    alpaka::wait::wait(stream);
+
+    //Memory copy back
+    alpaka::mem::view::copy(
+            stream,
+            hostBufResult,
+            accBufResult,
+            extentResult);
+
+    alpaka::wait::wait( stream);
+
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(reduceKernelAdd)
+{
+    using Acc = alpaka::acc::AccCpuOmp2Threads<
+        alpaka::dim::DimInt<2u>,
+        std::size_t>;
+
+    // uneven lengths to hit the partial tree levels
+    for(std::size_t numBodies : {1u, 9u, 100u})
+    {
+        Vector* forceMatrix = new Vector[numBodies*numBodies];
+        Vector* result = new Vector[numBodies];
+        for(std::size_t i(0);i<numBodies;i++){
+            for(std::size_t j(0);j<numBodies;j++)
+                forceMatrix[i*numBodies+j]=Vector(static_cast<float>(j+i));
+        }
+
+        runReduceKernel<Acc>(
+                forceMatrix,
+                numBodies,
+                numBodies,
+                result,
+                nbody::simulation::kernels::reduce::Add()
+            );
+
+        for (std::size_t i=0; i<numBodies;i++)
+        {
+            float const sum( static_cast<float>(
+                    numBodies*(numBodies-1)/2 + i*numBodies) );
+            BOOST_CHECK (Vector(sum)==result[i]);
+        }
+
+        delete[] forceMatrix;
+        delete[] result;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduceKernelMin)
+{
+    using Acc = alpaka::acc::AccCpuSerial<
+        alpaka::dim::DimInt<2u>,
+        std::size_t>;
+
+    std::size_t const numRows = 3;
+    std::size_t const rowLength = 17;
+    float matrix[numRows*rowLength];
+    float result[numRows];
+    for(std::size_t i(0);i<numRows;i++){
+        for(std::size_t j(0);j<rowLength;j++)
+            matrix[i*rowLength+j]=static_cast<float>((j*7+i)%rowLength)-5.0f*i;
+    }
+
+    runReduceKernel<Acc>(
+            matrix,
+            numRows,
+            rowLength,
+            result,
+            nbody::simulation::kernels::reduce::Min()
+        );
+
+    for (std::size_t i=0; i<numRows;i++)
+    {
+        std::cout << result[i] << std::endl;
+        BOOST_CHECK_EQUAL(-5.0f*i, result[i]);
+    }
+}
@@ -0,0 +1,238 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ShortRangeTest
+#include <iostream> // std::cout, std::endl;
+#include <cmath> // std::sqrt, std::floor
+#include <algorithm> // std::max
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <alpaka/alpaka.hpp>
+#include <simulation/solvers/shortRange.hpp> // ShortRange
+#include <simulation/types/vector.hpp> //Vector
+#include <boost/test/unit_test.hpp>
+
+using namespace nbody::simulation;
+
+using Size = std::size_t;
+using Stream = alpaka::stream::StreamCpuSync;
+using AccForce = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<2u>,Size>;
+using AccBodies = alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<1u>,Size>;
+using Vector = types::Vector<3,float>;
+
+// Random bodies in a unit cube
+auto
+createBodies(
+    std::size_t numBodies,
+    std::vector<Vector> & positions,
+    std::vector<float> & masses)
+-> void
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f );
+
+    positions.resize( numBodies );
+    masses.resize( numBodies );
+    for( std::size_t i( 0 ); i < numBodies; i++ )
+    {
+        for( std::size_t d( 0 ); d < 3; d++ )
+            positions[ i ][ d ] = distribution( generator );
+        masses[ i ] = 0.5f + distribution( generator );
+    }
+}
+
+// Direct summation of the pairs within the cutoff on the host,
+// with the nearest images in a unit box if periodic
+auto
+cutoffAccelerations(
+    std::vector<Vector> const & positions,
+    std::vector<float> const & masses,
+    float smoothnessFactor,
+    float cutoff,
+    bool periodic)
+-> std::vector<types::Vector<3,double>>
+{
+    std::vector<types::Vector<3,double>> accelerations(
+            positions.size(), types::Vector<3,double>( 0.0 ) );
+    for( std::size_t i( 0 ); i < positions.size(); i++ )
+    {
+        for( std::size_t j( 0 ); j < positions.size(); j++ )
+        {
+            if( i == j )
+                continue;
+            types::Vector<3,double> relative;
+            for( std::size_t d( 0 ); d < 3; d++ )
+            {
+                relative[ d ] = double( positions[ j ][ d ] ) - positions[ i ][ d ];
+                if( periodic )
+                    relative[ d ] -= std::floor( relative[ d ] + 0.5 );
+            }
+            if( relative.absSq() >= double( cutoff ) * cutoff )
+                continue;
+            double const dist( relative.absSq() + smoothnessFactor );
+            accelerations[ i ] += ( masses[ j ] / ( dist * std::sqrt( dist ) ) ) *
+                relative;
+        }
+    }
+    return accelerations;
+}
+
+// Largest error relative to the size of the acceleration
+auto
+relativeError(
+    std::vector<Vector> const & accelerations,
+    std::vector<types::Vector<3,double>> const & reference)
+-> double
+{
+    double error( 0.0 );
+    for( std::size_t i( 0 ); i < reference.size(); i++ )
+    {
+        types::Vector<3,double> difference;
+        for( std::size_t d( 0 ); d < 3; d++ )
+            difference[ d ] = accelerations[ i ][ d ] - reference[ i ][ d ];
+        error = std::max( error, std::sqrt( difference.absSq() ) /
+                ( std::sqrt( reference[ i ].absSq() ) + 1.0 ) );
+    }
+    return error;
+}
+
+// A solver and the bodies on the accelerator
+template<
+    typename TSolver>
+struct ShortRangeRun
+{
+    alpaka::dev::DevCpu devHost;
+    alpaka::dev::Dev<AccBodies> devAcc;
+    Stream stream;
+    alpaka::Vec<alpaka::dim::DimInt<1u>,Size> const extentBodies;
+    decltype( alpaka::mem::buf::alloc<Vector, Size>( devAcc, 1 ) ) accBufPosition;
+    decltype( alpaka::mem::buf::alloc<float, Size>( devAcc, 1 ) ) accBufMass;
+    typename TSolver::template Solver<
+        AccForce,
+        AccBodies,
+        3,
+        float,
+        Size> solver;
+
+    ShortRangeRun(
+        std::vector<float> & masses) :
+        devHost( alpaka::dev::DevManCpu::getDevByIdx( 0 ) ),
+        devAcc( alpaka::dev::DevMan<AccBodies>::getDevByIdx( 0 ) ),
+        stream( devAcc ),
+        extentBodies( masses.size() ),
+        accBufPosition( alpaka::mem::buf::alloc<Vector, Size>( devAcc, extentBodies ) ),
+        accBufMass( alpaka::mem::buf::alloc<float, Size>( devAcc, extentBodies ) ),
+        solver( devAcc, masses.size() )
+    {
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::DevCpu, float,
+            alpaka::dim::DimInt<1u>, Size>
+        hostBufMass( masses.data(), devHost, extentBodies );
+        alpaka::mem::view::copy( stream, accBufMass, hostBufMass, extentBodies );
+    }
+
+    // Runs the solver and copies the accelerations to the host
+    auto operator()(
+        std::vector<Vector> & positions,
+        float smoothnessFactor)
+    -> std::vector<Vector>
+    {
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::DevCpu, Vector,
+            alpaka::dim::DimInt<1u>, Size>
+        hostBufPosition( positions.data(), devHost, extentBodies );
+        alpaka::mem::view::copy( stream, accBufPosition, hostBufPosition, extentBodies );
+
+        solver(
+            stream,
+            alpaka::mem::view::getPtrNative( accBufPosition ),
+            alpaka::mem::view::getPtrNative( accBufMass ),
+            extentBodies[0],
+            smoothnessFactor,
+            2 );
+
+        std::vector<Vector> accelerations( extentBodies[0] );
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::DevCpu, Vector,
+            alpaka::dim::DimInt<1u>, Size>
+        hostBufAccelerations( accelerations.data(), devHost, extentBodies );
+        alpaka::mem::view::ViewPlainPtr<
+            alpaka::dev::Dev<AccBodies>, Vector,
+            alpaka::dim::DimInt<1u>, Size>
+        accBufAccelerations( solver.getAccelerations(), devAcc, extentBodies );
+
+        alpaka::mem::view::copy(
+                stream, hostBufAccelerations, accBufAccelerations, extentBodies );
+        alpaka::wait::wait( stream );
+
+        return accelerations;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( shortRangeCells )
+{
+    std::vector<Vector> positions;
+    std::vector<float> masses;
+    createBodies( 500, positions, masses );
+
+    auto const reference( cutoffAccelerations(
+                positions, masses, 1e-4f, 0.2f, false ) );
+
+    ShortRangeRun< solvers::ShortRange<> > run( masses );
+    run.solver.cutoff = 0.2f;
+
+    double const error( relativeError( run( positions, 1e-4f ), reference ) );
+    std::cout << "cells: " << error << std::endl;
+    BOOST_CHECK_SMALL( error, 1e-5 );
+    BOOST_CHECK_EQUAL( run.solver.getNumBuilds(), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( shortRangeVerlet )
+{
+    std::vector<Vector> positions;
+    std::vector<float> masses;
+    createBodies( 500, positions, masses );
+
+    ShortRangeRun< solvers::ShortRange<> > run( masses );
+    run.solver.cutoff = 0.2f;
+    run.solver.skin = 0.05f;
+
+    // moves every body by distance in a direction of its own
+    auto const move = [&]( float distance )
+    {
+        for( std::size_t i( 0 ); i < positions.size(); i++ )
+            positions[ i ][ i % 3 ] += ( i % 2 == 0 ) ? distance : -distance;
+    };
+
+    for( float distance : {0.0f, 0.01f, 0.01f, 0.01f} )
+    {
+        move( distance );
+        auto const reference( cutoffAccelerations(
+                    positions, masses, 1e-4f, 0.2f, false ) );
+        double const error( relativeError( run( positions, 1e-4f ), reference ) );
+        std::cout << "verlet: " << error << ", builds: "
+            << run.solver.getNumBuilds() << std::endl;
+        BOOST_CHECK_SMALL( error, 1e-5 );
+    }
+    // the lists are built again after 0.03 > skin / 2
+    BOOST_CHECK_EQUAL( run.solver.getNumBuilds(), 2u );
+}
+
+BOOST_AUTO_TEST_CASE( shortRangePeriodic )
+{
+    std::vector<Vector> positions;
+    std::vector<float> masses;
+    createBodies( 500, positions, masses );
+
+    auto const reference( cutoffAccelerations(
+                positions, masses, 1e-4f, 0.2f, true ) );
+
+    ShortRangeRun< solvers::ShortRange<kernels::forceLaws::Plummer, true> >
+        run( masses );
+    run.solver.cutoff = 0.2f;
+
+    double const errorCells( relativeError( run( positions, 1e-4f ), reference ) );
+    run.solver.skin = 0.05f;
+    double const errorVerlet( relativeError( run( positions, 1e-4f ), reference ) );
+    std::cout << "cells: " << errorCells << ", verlet: " << errorVerlet << std::endl;
+    BOOST_CHECK_SMALL( errorCells, 1e-5 );
+    BOOST_CHECK_SMALL( errorVerlet, 1e-5 );
+}
@@ -1,8 +1,16 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE SimulationClassTest
 #include <iostream> // std::cout, std::endl;
+#include <sstream> // std::ostringstream
+#include <cmath> // std::sqrt
+#include <vector> // std::vector
+#include <random> // std::mt19937
+#include <algorithm> // std::min
+#include <string> // std::to_string
+#include <stdexcept> // std::invalid_argument
 #include <simulation/types/vector.hpp> //Vector
 #include <simulation/simulation.hpp> // Simulation
+#include <simulation/ensemble.hpp> // Ensemble
 #include <boost/test/unit_test.hpp>
 
 using namespace nbody::simulation;
@@ -32,6 +40,20 @@ bool operator==(types::Vector<NDim,TElem> const a, types::Vector<NDim,TElem> con
     return true;
 }
 
+// Three bodies in 3D, every instance holds fresh initial conditions
+struct ThreeBodies
+{
+    types::Vector<3,float> position[3] = {
+        {1.0f,0.0f,0.0f}, {-1.0f,0.0f,0.0f}, {0.0f,2.0f,0.5f}
+    };
+    types::Vector<3,float> velocity[3] = {
+        {0.0f,0.1f,0.0f}, {0.0f,-0.1f,0.0f}, {0.1f,0.0f,0.0f}
+    };
+    float mass[3] = {
+        1.0f, 2.0f, 0.5f
+    };
+};
+
 BOOST_AUTO_TEST_CASE( simulationClass )
 {
     types::Vector<2,float> bodiesPosition[2] = {
@@ -78,3 +100,795 @@ BOOST_AUTO_TEST_CASE( simulationClass )
 
     
 }
+
+BOOST_AUTO_TEST_CASE( simulationClassFused )
+{
+    ThreeBodies bodies;
+    // the steps work on the arrays on the host
+    ThreeBodies bodiesFused;
+
+    std::size_t numBodies = 3;
+
+    float smoothnessFactor = 1e-2;
+
+    float gravitationalConstant = 0.2f;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::ForceMatrix> simMatrix(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                numBodies,
+                smoothnessFactor,
+                gravitationalConstant);
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simFused(
+                bodiesFused.position,
+                bodiesFused.velocity,
+                bodiesFused.mass,
+                numBodies,
+                smoothnessFactor,
+                gravitationalConstant);
+
+    for(unsigned int i(0); i < 10; i++) {
+        simMatrix.step(0.1f);
+        simFused.step(0.1f);
+    }
+
+    types::Vector<3, float> * resultMatrix = simMatrix.getPositions();
+    types::Vector<3, float> * resultFused = simFused.getPositions();
+
+    for(unsigned int i(0); i < 3; i++) {
+        std::cout << resultMatrix[i] << resultFused[i] << std::endl;
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( resultMatrix[i][d], resultFused[i][d], 1e-3 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassSteps )
+{
+    ThreeBodies bodies;
+    ThreeBodies bodiesBatched;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> sim(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simBatched(
+                bodiesBatched.position,
+                bodiesBatched.velocity,
+                bodiesBatched.mass,
+                3,
+                1e-2f,
+                0.2f);
+
+    for(unsigned int i(0); i < 10; i++) {
+        sim.step(0.1f);
+    }
+    simBatched.steps(0.1f, 10);
+
+    types::Vector<3, float> * result = sim.getPositions();
+    types::Vector<3, float> * resultBatched = simBatched.getPositions();
+
+    // the same kernels in the same order
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( resultBatched[i][d], result[i][d] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassPlan )
+{
+    ThreeBodies bodies;
+    ThreeBodies bodiesPlan;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> sim(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simPlan(
+                bodiesPlan.position,
+                bodiesPlan.velocity,
+                bodiesPlan.mass,
+                3,
+                1e-2f,
+                0.2f);
+
+    std::ostringstream plan;
+    simPlan.printPlan(plan);
+    std::cout << plan.str();
+    BOOST_CHECK( plan.str().find("elements: 8") != std::string::npos );
+    BOOST_CHECK( plan.str().find("acceleration: ") != std::string::npos );
+    BOOST_CHECK( plan.str().find("updatePositions: ") != std::string::npos );
+
+    // a new number of elements gives a new plan
+    simPlan.elements = 1;
+    std::ostringstream planChanged;
+    simPlan.printPlan(planChanged);
+    std::cout << planChanged.str();
+    BOOST_CHECK( planChanged.str().find("elements: 1") != std::string::npos );
+    BOOST_CHECK( planChanged.str() != plan.str() );
+
+    // the plan changes how the bodies are shared, not the results
+    for(unsigned int i(0); i < 5; i++) {
+        sim.step(0.1f);
+        simPlan.step(0.1f);
+    }
+    simPlan.elements = 2;
+    sim.steps(0.1f, 5);
+    simPlan.steps(0.1f, 5);
+
+    types::Vector<3, float> * result = sim.getPositions();
+    types::Vector<3, float> * resultPlan = simPlan.getPositions();
+
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( resultPlan[i][d], result[i][d] );
+        }
+    }
+
+    // solvers without a plan choose their launches in every step
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::BarnesHut<> > simTree(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+    std::ostringstream planTree;
+    simTree.printPlan(planTree);
+    BOOST_CHECK( planTree.str().find("solver: chosen in every step")
+        != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassSnapshot )
+{
+    ThreeBodies bodies;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::SoA> sim(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+
+    // the first snapshot holds the initial bodies
+    auto snapshotInitial = sim.snapshot();
+    sim.enqueueSteps(0.1f, 5);
+    types::Vector<3,float> const * positionsInitial =
+        snapshotInitial.getPositions();
+    types::Vector<3,float> const * velocitiesInitial =
+        snapshotInitial.getVelocities();
+    float const * massesInitial = snapshotInitial.getMasses();
+    sim.wait();
+    BOOST_CHECK( snapshotInitial.ready() );
+
+    ThreeBodies const initial;
+    for(unsigned int i(0); i < 3; i++) {
+        BOOST_CHECK_EQUAL( massesInitial[i], initial.mass[i] );
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( positionsInitial[i][d], initial.position[i][d] );
+            BOOST_CHECK_EQUAL( velocitiesInitial[i][d], initial.velocity[i][d] );
+        }
+    }
+
+    // the second snapshot uses the other buffers
+    auto snapshotSteps = sim.snapshot();
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> const * positionsSteps =
+        snapshotSteps.getPositions();
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( positionsSteps[i][d], result[i][d] );
+            BOOST_CHECK_EQUAL( snapshotInitial.getPositions()[i][d],
+                initial.position[i][d] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassAdaptive )
+{
+    // circular orbit with |a| = 1 and |v| = sqrt(0.5)
+    types::Vector<3,float> bodiesPosition[2] = {
+        {0.5f,0.0f,0.0f}, {-0.5f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[2] = {
+        {0.0f,std::sqrt(0.5f),0.0f}, {0.0f,-std::sqrt(0.5f),0.0f}
+    };
+    float bodiesMass[2] = {
+        1.0f, 1.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::Leapfrog> sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+    sim.timestep.eta = 0.1f;
+    sim.timestep.length = 0.1f;
+
+    // the velocity limits: 0.1 * 0.1 / sqrt(0.5)
+    float const expected( 0.01f / std::sqrt(0.5f) );
+    BOOST_CHECK_CLOSE( sim.stepAdaptive(), expected, 1e-3 );
+
+    // the orbit stays circular, so does the step
+    for(unsigned int i(0); i < 10; i++) {
+        BOOST_CHECK_CLOSE( sim.stepAdaptive(), expected, 1e-1 );
+    }
+
+    // fixed steps in between are taken into account
+    sim.step(0.1f);
+    BOOST_CHECK_CLOSE( sim.stepAdaptive(), expected, 1e-1 );
+
+    sim.timestep.maxStep = 1e-3f;
+    sim.stepAdaptive();
+    BOOST_CHECK_EQUAL( sim.stepAdaptive(), 1e-3f );
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassAdaptiveNoLength )
+{
+    types::Vector<3,float> bodiesPosition[2] = {
+        {0.5f,0.0f,0.0f}, {-0.5f,0.0f,0.0f}
+    };
+    types::Vector<3,float> bodiesVelocity[2] = {
+        {0.0f,std::sqrt(0.5f),0.0f}, {0.0f,-std::sqrt(0.5f),0.0f}
+    };
+    float bodiesMass[2] = {
+        1.0f, 1.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::Leapfrog> sim(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                2,
+                0.0f,
+                1.0f);
+
+    // no softening and no length, every step would be 0
+    BOOST_CHECK_THROW( sim.stepAdaptive(), std::invalid_argument );
+    for(unsigned int i(0); i < 2; i++) {
+        BOOST_CHECK_EQUAL( bodiesPosition[i][0], i == 0 ? 0.5f : -0.5f );
+    }
+
+    sim.timestep.length = 0.1f;
+    BOOST_CHECK_GT( sim.stepAdaptive(), 0.0f );
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassTracers )
+{
+    // two massive bodies first, then three tracers
+    types::Vector<3,float> bodiesPosition[5] = {
+        {1.0f,0.0f,0.0f}, {-1.0f,0.0f,0.0f},
+        {0.0f,2.0f,0.5f}, {0.0f,-3.0f,0.0f}, {0.5f,0.5f,0.5f}
+    };
+    types::Vector<3,float> bodiesVelocity[5] = {
+        {0.0f,0.1f,0.0f}, {0.0f,-0.1f,0.0f},
+        {0.1f,0.0f,0.0f}, {0.2f,0.0f,0.0f}, {0.0f,0.0f,0.1f}
+    };
+    // the masses of the tracers are not read
+    float bodiesMass[5] = {
+        1.0f, 2.0f, 5.0f, 5.0f, 5.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::SourcesSinks> simTracers(
+                bodiesPosition,
+                bodiesVelocity,
+                bodiesMass,
+                5,
+                1e-2f,
+                0.2f,
+                2);
+
+    // the same bodies with massless tracers
+    types::Vector<3,float> bodiesPositionReference[5] = {
+        bodiesPosition[0], bodiesPosition[1],
+        bodiesPosition[2], bodiesPosition[3], bodiesPosition[4]
+    };
+    types::Vector<3,float> bodiesVelocityReference[5] = {
+        bodiesVelocity[0], bodiesVelocity[1],
+        bodiesVelocity[2], bodiesVelocity[3], bodiesVelocity[4]
+    };
+    float bodiesMassReference[5] = {
+        1.0f, 2.0f, 0.0f, 0.0f, 0.0f
+    };
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simReference(
+                bodiesPositionReference,
+                bodiesVelocityReference,
+                bodiesMassReference,
+                5,
+                1e-2f,
+                0.2f);
+
+    // every solver leaves out the tracers, the ForceMatrix too
+    types::Vector<3,float> bodiesPositionMatrix[5] = {
+        bodiesPositionReference[0], bodiesPositionReference[1],
+        bodiesPositionReference[2], bodiesPositionReference[3],
+        bodiesPositionReference[4]
+    };
+    types::Vector<3,float> bodiesVelocityMatrix[5] = {
+        bodiesVelocityReference[0], bodiesVelocityReference[1],
+        bodiesVelocityReference[2], bodiesVelocityReference[3],
+        bodiesVelocityReference[4]
+    };
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t> simMatrix(
+                bodiesPositionMatrix,
+                bodiesVelocityMatrix,
+                bodiesMass,
+                5,
+                1e-2f,
+                0.2f,
+                2);
+
+    simTracers.steps(0.1f, 10);
+    simReference.steps(0.1f, 10);
+
+    types::Vector<3, float> * result = simTracers.getPositions();
+    types::Vector<3, float> * resultReference = simReference.getPositions();
+
+    for(unsigned int i(0); i < 5; i++) {
+        std::cout << result[i] << resultReference[i] << std::endl;
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 1.0f,
+                    resultReference[i][d] + 1.0f, 1e-3 );
+        }
+    }
+
+    simMatrix.steps(0.1f, 10);
+
+    result = simMatrix.getPositions();
+    for(unsigned int i(0); i < 5; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 1.0f,
+                    resultReference[i][d] + 1.0f, 1e-3 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassReorder )
+{
+    // 48 massive bodies, then 16 tracers
+    std::size_t const numBodies( 64 );
+    std::size_t const numMassive( 48 );
+    std::mt19937 generator( 3 );
+    std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+
+    std::vector<types::Vector<3,float>> bodiesPosition( numBodies );
+    std::vector<types::Vector<3,float>> bodiesVelocity( numBodies );
+    std::vector<float> bodiesMass( numBodies );
+    for(std::size_t i(0); i < numBodies; i++) {
+        for(std::size_t d(0); d < 3; d++) {
+            bodiesPosition[i][d] = distribution( generator );
+            bodiesVelocity[i][d] = 0.1f * distribution( generator );
+        }
+        bodiesMass[i] = ( i < numMassive ) ?
+            1.0f + distribution( generator ) * 0.5f : 0.0f;
+    }
+    std::vector<types::Vector<3,float>> bodiesPositionReference(
+        bodiesPosition );
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::SourcesSinks,
+        types::layouts::SoA,
+        integrators::Leapfrog> sim(
+                bodiesPosition.data(),
+                bodiesVelocity.data(),
+                bodiesMass.data(),
+                numBodies,
+                1e-2f,
+                0.01f,
+                numMassive);
+    sim.reorder.interval = 3;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::AoS,
+        integrators::Leapfrog> simReference(
+                bodiesPositionReference.data(),
+                bodiesVelocity.data(),
+                bodiesMass.data(),
+                numBodies,
+                1e-2f,
+                0.01f);
+
+    sim.steps(0.1f, 10);
+    simReference.steps(0.1f, 10);
+    // before the steps 3, 6 and 9
+    BOOST_CHECK_EQUAL( sim.reorder.getNumReorders(), 3u );
+
+    // the results are in the original order
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> * resultReference = simReference.getPositions();
+    for(std::size_t i(0); i < numBodies; i++) {
+        for(std::size_t d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 2.0f,
+                    resultReference[i][d] + 2.0f, 1e-3 );
+        }
+    }
+
+    auto snapshot = sim.snapshot();
+    auto snapshotReference = simReference.snapshot();
+    for(std::size_t i(0); i < numBodies; i++) {
+        BOOST_CHECK_EQUAL( snapshot.getMasses()[i],
+                snapshotReference.getMasses()[i] );
+        for(std::size_t d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( snapshot.getPositions()[i][d], result[i][d] );
+            BOOST_CHECK_CLOSE( snapshot.getVelocities()[i][d] + 1.0f,
+                    snapshotReference.getVelocities()[i][d] + 1.0f, 1e-3 );
+        }
+    }
+
+    // the Morton curve gives the same bodies
+    sim.reorder.hilbert = false;
+    sim.steps(0.1f, 3);
+    simReference.steps(0.1f, 3);
+    BOOST_CHECK_EQUAL( sim.reorder.getNumReorders(), 4u );
+    result = sim.getPositions();
+    resultReference = simReference.getPositions();
+    for(std::size_t i(0); i < numBodies; i++) {
+        for(std::size_t d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 2.0f,
+                    resultReference[i][d] + 2.0f, 1e-3 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassZeroCopy )
+{
+    ThreeBodies bodies;
+    ThreeBodies bodiesCopy;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> sim(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+    // other layouts are converted
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused,
+        types::layouts::SoA> simCopy(
+                bodiesCopy.position,
+                bodiesCopy.velocity,
+                bodiesCopy.mass,
+                3,
+                1e-2f,
+                0.2f);
+    BOOST_CHECK( sim.isZeroCopy() );
+    BOOST_CHECK( !simCopy.isZeroCopy() );
+
+    sim.steps(0.1f, 5);
+    simCopy.steps(0.1f, 5);
+
+    // the steps moved the caller's arrays
+    types::Vector<3,float> * resultCopy = simCopy.getPositions();
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( bodies.position[i][d] + 1.0f,
+                    resultCopy[i][d] + 1.0f, 1e-4 );
+        }
+    }
+    BOOST_CHECK( bodies.velocity[2][1] != 0.0f );
+    BOOST_CHECK( sim.getPositions() == bodies.position );
+
+    // the snapshots copy from the caller's arrays
+    auto snapshot = sim.snapshot();
+    for(unsigned int i(0); i < 3; i++) {
+        BOOST_CHECK_EQUAL( snapshot.getMasses()[i], bodies.mass[i] );
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_EQUAL( snapshot.getPositions()[i][d],
+                    bodies.position[i][d] );
+            BOOST_CHECK_EQUAL( snapshot.getVelocities()[i][d],
+                    bodies.velocity[i][d] );
+        }
+    }
+
+    // reordering copies the bodies, the results stay the same
+    sim.reorder.interval = 1;
+    sim.steps(0.1f, 5);
+    simCopy.steps(0.1f, 5);
+    BOOST_CHECK( !sim.isZeroCopy() );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    resultCopy = simCopy.getPositions();
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 1.0f,
+                    resultCopy[i][d] + 1.0f, 1e-4 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassZeroCopyDisabled )
+{
+    ThreeBodies bodies;
+    ThreeBodies bodiesCopy;
+
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> sim(
+                bodies.position,
+                bodies.velocity,
+                bodies.mass,
+                3,
+                1e-2f,
+                0.2f);
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simCopy(
+                bodiesCopy.position,
+                bodiesCopy.velocity,
+                bodiesCopy.mass,
+                3,
+                1e-2f,
+                0.2f);
+    simCopy.disableZeroCopy();
+    BOOST_CHECK( !simCopy.isZeroCopy() );
+
+    sim.steps(0.1f, 5);
+    simCopy.steps(0.1f, 5);
+
+    // the caller's arrays are only written by getPositions
+    BOOST_CHECK_EQUAL( bodiesCopy.position[2][1], 2.0f );
+    BOOST_CHECK_EQUAL( bodiesCopy.velocity[2][0], 0.1f );
+    BOOST_CHECK_EQUAL( bodiesCopy.velocity[2][1], 0.0f );
+
+    types::Vector<3,float> * result = sim.getPositions();
+    types::Vector<3,float> * resultCopy = simCopy.getPositions();
+    BOOST_CHECK( resultCopy == bodiesCopy.position );
+    for(unsigned int i(0); i < 3; i++) {
+        for(unsigned int d(0); d < 3; d++) {
+            BOOST_CHECK_CLOSE( result[i][d] + 1.0f,
+                    resultCopy[i][d] + 1.0f, 1e-4 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ensembleSystems )
+{
+    // three systems of 2, 3 and 4 bodies
+    std::size_t const numSystems( 3 );
+    std::size_t systemBegin[numSystems + 1] = { 0, 2, 5, 9 };
+    float dt[numSystems] = { 0.1f, 0.05f, 0.02f };
+    float smoothnessFactor[numSystems] = { 1e-2f, 1e-1f, 1e-3f };
+    float gravitationalConstant[numSystems] = { 0.2f, 1.0f, 0.5f };
+
+    std::mt19937 generator( 5 );
+    std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+    std::vector<types::Vector<3,float>> bodiesPosition( 9 );
+    std::vector<types::Vector<3,float>> bodiesVelocity( 9 );
+    std::vector<float> bodiesMass( 9 );
+    for(std::size_t i(0); i < 9; i++) {
+        for(std::size_t d(0); d < 3; d++) {
+            bodiesPosition[i][d] = distribution( generator );
+            bodiesVelocity[i][d] = 0.1f * distribution( generator );
+        }
+        bodiesMass[i] = 1.0f + 0.5f * distribution( generator );
+    }
+    // every system on its own
+    std::vector<types::Vector<3,float>> systemsPosition( bodiesPosition );
+    std::vector<types::Vector<3,float>> systemsVelocity( bodiesVelocity );
+
+    Ensemble<
+        3,
+        float,
+        float,
+        std::size_t> ensemble(
+                bodiesPosition.data(),
+                bodiesVelocity.data(),
+                bodiesMass.data(),
+                systemBegin,
+                numSystems,
+                dt,
+                smoothnessFactor,
+                gravitationalConstant);
+
+    std::ostringstream plan;
+    ensemble.printPlan(plan);
+    std::cout << plan.str();
+    BOOST_CHECK( plan.str().find("systems: 3, bodies: 9") != std::string::npos );
+
+    ensemble.steps(10);
+    ensemble.elements = 1;
+    ensemble.steps(10);
+    types::Vector<3,float> * result = ensemble.getPositions();
+
+    for(std::size_t s(0); s < numSystems; s++) {
+        std::size_t const begin( systemBegin[s] );
+        Simulation<
+            3,
+            float,
+            float,
+            std::size_t,
+            solvers::Fused> sim(
+                    systemsPosition.data() + begin,
+                    systemsVelocity.data() + begin,
+                    bodiesMass.data() + begin,
+                    systemBegin[s + 1] - begin,
+                    smoothnessFactor[s],
+                    gravitationalConstant[s]);
+        sim.steps(dt[s], 20);
+        types::Vector<3,float> * resultSystem = sim.getPositions();
+
+        for(std::size_t i(0); i < systemBegin[s + 1] - begin; i++) {
+            for(std::size_t d(0); d < 3; d++) {
+                BOOST_CHECK_CLOSE( result[begin + i][d] + 2.0f,
+                        resultSystem[i][d] + 2.0f, 1e-3 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( simulationClassRing )
+{
+    std::size_t const numBodies = 7;
+    std::mt19937 generator( 7 );
+    std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+
+    std::vector<types::Vector<3,float> > positions( numBodies );
+    std::vector<types::Vector<3,float> > velocities( numBodies );
+    std::vector<float> masses( numBodies );
+    for(std::size_t i(0); i < numBodies; i++) {
+        for(std::size_t d(0); d < 3; d++) {
+            positions[i][d] = distribution( generator );
+            velocities[i][d] = 0.1f * distribution( generator );
+        }
+        masses[i] = 1.5f + distribution( generator );
+    }
+
+    std::vector<types::Vector<3,float> > positionsReference( positions );
+    std::vector<types::Vector<3,float> > velocitiesReference( velocities );
+    Simulation<
+        3,
+        float,
+        float,
+        std::size_t,
+        solvers::Fused> simReference(
+                positionsReference.data(),
+                velocitiesReference.data(),
+                masses.data(),
+                numBodies,
+                1e-2f,
+                0.2f);
+    simReference.steps(0.05f, 5);
+    types::Vector<3,float> * reference = simReference.getPositions();
+
+    // one block, one per device, uneven blocks sharing a device
+    // and more devices than bodies
+    for(std::size_t numDevices : {1, 3, 4, 9}) {
+        std::vector<types::Vector<3,float> > positionsRing( positions );
+        std::vector<types::Vector<3,float> > velocitiesRing( velocities );
+        Simulation<
+            3,
+            float,
+            float,
+            std::size_t,
+            solvers::Ring<> > sim(
+                    positionsRing.data(),
+                    velocitiesRing.data(),
+                    masses.data(),
+                    numBodies,
+                    1e-2f,
+                    0.2f);
+        sim.solver.numDevices = numDevices;
+        sim.steps(0.05f, 5);
+
+        std::ostringstream plan;
+        sim.printPlan( plan );
+        BOOST_CHECK( plan.str().find( "ring: " +
+                    std::to_string( std::min( numDevices, numBodies ) ) +
+                    " blocks" ) != std::string::npos );
+
+        types::Vector<3,float> * result = sim.getPositions();
+        for(std::size_t i(0); i < numBodies; i++) {
+            for(std::size_t d(0); d < 3; d++) {
+                BOOST_CHECK_CLOSE( result[i][d] + 2.0f,
+                        reference[i][d] + 2.0f, 1e-4 );
+            }
+        }
+    }
+}
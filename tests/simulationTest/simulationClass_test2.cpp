@@ -66,8 +66,11 @@ int main (){
         {	
 			std::cerr<<".";
 		
-            //Print positions
-            types::Vector<3,float> * positions =sim.getPositions();
+            //Print positions while the next steps run
+            auto snapshot = sim.snapshot();
+            //innersteps
+            sim.enqueueSteps(DTIME,INNER_STEP);
+            types::Vector<3,float> const * positions =snapshot.getPositions();
             for (unsigned int i(0); i<N_BODIES; i++)
             {
                 types::Vector<3,float> position= positions[i];
@@ -80,9 +83,7 @@ int main (){
                     std::cout<<"|";
             }
             std::cout<<std::endl;
-            //innersteps
-            for (unsigned int j(0);j<INNER_STEP;j++)
-                sim.step(DTIME);
+            sim.wait();
         }
 	return 0;
 }
@@ -47,6 +47,12 @@ BOOST_AUTO_TEST_CASE( additionAndSubtractionWithVector )
 
     BOOST_CHECK( a + b == c );
     BOOST_CHECK( c - a == b );
+
+    Vector<3,float> d( c );
+    d -= a;
+    BOOST_CHECK( d == b );
+    d += a;
+    BOOST_CHECK( d == c );
 }
 
 BOOST_AUTO_TEST_CASE( divisionWithScalar )